@@ -0,0 +1,553 @@
+﻿#include "../Settings.h"
+#include "../Utils/ThreadPool.h"
+#include "../Game/Scene.h"
+#include "Generators.h"
+
+/// @brief Nombre de pas de temps non mesurés avant les mesures.
+#define BENCH_WARMUP_STEPS 10
+
+/// @brief Nombre de mesures par défaut pour les pas de temps.
+#define BENCH_STEP_SAMPLES 100
+
+/// @brief Nombre de mesures par défaut pour les recherches et les ajouts/suppressions.
+#define BENCH_QUERY_SAMPLES 1000
+
+/// @brief Nombre maximal de tailles de scènes.
+#define BENCH_MAX_SIZES 16
+
+/// @brief Nombre de balles recherchées par une requête (comme l'aperçu des ressorts).
+#define BENCH_QUERY_COUNT 3
+
+/// @brief Format des résultats.
+typedef enum BenchFormat_e
+{
+    BENCH_CSV,
+    BENCH_JSON
+} BenchFormat;
+
+/// @brief Paramètres et état d'une campagne de mesures.
+typedef struct Bench_s
+{
+    /// @brief Etiquette recopiée dans chaque résultat (par exemple le commit mesuré).
+    const char *label;
+
+    /// @brief Méthode d'intégration utilisée.
+    SolverMode solverMode;
+
+    /// @brief Nombre de threads du moteur physique.
+    int threadCount;
+
+    /// @brief Tailles des scènes (en nombre de balles).
+    int sizes[BENCH_MAX_SIZES];
+    int sizeCount;
+
+    /// @brief Familles de scènes mesurées.
+    bool kinds[GENERATOR_COUNT];
+
+    /// @brief Nombre de mesures des pas de temps et des autres opérations.
+    int stepSamples;
+    int querySamples;
+
+    /// @brief Graine des générateurs pseudo-aléatoires.
+    uint32_t seed;
+
+    /// @brief Laisse les îles au repos s'endormir (sinon toutes les îles restent éveillées).
+    bool allowSleep;
+
+    /// @brief Nombre maximal de pas de temps laissés aux îles pour s'endormir, lorsque l'on
+    /// vérifie que les scènes se stabilisent au lieu de les mesurer (0 : mesures).
+    int settleSteps;
+
+    /// @brief Format et destination des résultats.
+    BenchFormat format;
+    FILE *output;
+
+    /// @brief Nombre de balles et de ressorts de la scène mesurée, juste après sa génération.
+    int ballCount, springCount;
+
+    /// @brief Nombre de résultats déjà écrits.
+    int resultCount;
+
+    /// @brief Durées mesurées (exprimées en ns).
+    double *samples;
+} Bench;
+
+static const char *g_solverNames[] = { "explicit", "implicit", "xpbd" };
+
+/// @brief Renvoie l'instant courant (exprimé en ns).
+static double Bench_Now()
+{
+    return (double)SDL_GetPerformanceCounter() * 1e9 / (double)SDL_GetPerformanceFrequency();
+}
+
+static int Bench_CompareSamples(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+/// @brief Trie les mesures puis écrit la médiane et le 99e centile d'une opération.
+static void Bench_Report(
+    Bench *bench, GeneratorKind kind, const char *metric, int count, bool perBall)
+{
+    double *samples = bench->samples;
+    qsort(samples, count, sizeof(double), Bench_CompareSamples);
+
+    int p99Index = SDL_min(count - 1, (int)ceil(0.99 * count) - 1);
+    double median = samples[count / 2];
+    double p99 = samples[SDL_max(p99Index, 0)];
+    double perSecond = (median > 0.0) ? 1e9 / median : 0.0;
+    int ballCount = bench->ballCount;
+    int springCount = bench->springCount;
+    const char *solver = g_solverNames[bench->solverMode];
+    int threadCount = ThreadPool_GetThreadCount(g_threadPool);
+
+    // Les durées par balle et par ressort n'ont de sens que pour un pas de temps
+    double perBallNs = (perBall && ballCount > 0) ? median / ballCount : -1.0;
+    double perSpringNs = (perBall && springCount > 0) ? median / springCount : -1.0;
+
+    if (bench->format == BENCH_CSV)
+    {
+        fprintf(
+            bench->output, "%s,%s,%d,%d,%s,%d,%s,%d,%.1f,%.1f,%.3f,",
+            bench->label, Generator_GetName(kind), ballCount, springCount, solver, threadCount,
+            metric, count, median, p99, perSecond
+        );
+        if (perBallNs >= 0.0) fprintf(bench->output, "%.3f", perBallNs);
+        fprintf(bench->output, ",");
+        if (perSpringNs >= 0.0) fprintf(bench->output, "%.3f", perSpringNs);
+        fprintf(bench->output, "\n");
+    }
+    else
+    {
+        fprintf(
+            bench->output,
+            "%s    {\"label\": \"%s\", \"scene\": \"%s\", \"balls\": %d, \"springs\": %d, \"solver\": \"%s\", "
+            "\"threads\": %d, \"metric\": \"%s\", \"samples\": %d, \"median_ns\": %.1f, "
+            "\"p99_ns\": %.1f, \"per_second\": %.3f, ",
+            bench->resultCount > 0 ? ",\n" : "", bench->label, Generator_GetName(kind), ballCount,
+            springCount, solver, threadCount, metric, count, median, p99, perSecond
+        );
+        if (perBallNs >= 0.0)
+            fprintf(bench->output, "\"ns_per_ball\": %.3f, ", perBallNs);
+        else
+            fprintf(bench->output, "\"ns_per_ball\": null, ");
+        if (perSpringNs >= 0.0)
+            fprintf(bench->output, "\"ns_per_spring\": %.3f}", perSpringNs);
+        else
+            fprintf(bench->output, "\"ns_per_spring\": null}");
+    }
+
+    bench->resultCount++;
+    fflush(bench->output);
+}
+
+/// @brief Effectue un pas de temps, en gardant si besoin toutes les îles éveillées.
+/// @return La durée du pas de temps (exprimée en ns).
+static double Bench_Step(Bench *bench, Scene *scene)
+{
+    if (!bench->allowSleep)
+        Islands_WakeAll(scene->m_islands);
+
+    double start = Bench_Now();
+    Scene_FixedUpdate(scene, scene->m_timeStep);
+    return Bench_Now() - start;
+}
+
+/// @brief Calcule la boîte englobante des balles.
+static void Bench_GetBounds(Scene *scene, Vec2 *lower, Vec2 *upper)
+{
+    Particles *balls = Scene_GetBalls(scene);
+    *lower = Vec2_Set(0.f, 0.f);
+    *upper = Vec2_Set(1.f, 1.f);
+
+    for (int i = 0; i < Scene_GetBallCount(scene); ++i)
+    {
+        Vec2 position = Particles_GetPosition(balls, i);
+        if (i == 0)
+        {
+            *lower = *upper = position;
+            continue;
+        }
+        lower->x = fminf(lower->x, position.x);
+        lower->y = fminf(lower->y, position.y);
+        upper->x = fmaxf(upper->x, position.x);
+        upper->y = fmaxf(upper->y, position.y);
+    }
+}
+
+/// @brief Renvoie une position aléatoire dans une boîte.
+static Vec2 Bench_RandomPosition(uint32_t *state, Vec2 lower, Vec2 upper)
+{
+    return Vec2_Set(
+        lower.x + (upper.x - lower.x) * Generator_RandomFloat(state),
+        lower.y + (upper.y - lower.y) * Generator_RandomFloat(state)
+    );
+}
+
+/// @brief Mélange des identifiants de balles (algorithme de Fisher-Yates).
+static void Bench_Shuffle(BallId *balls, int count, uint32_t *state)
+{
+    for (int i = count - 1; i > 0; --i)
+    {
+        int j = Generator_Random(state) % (i + 1);
+        BallId ball = balls[i];
+        balls[i] = balls[j];
+        balls[j] = ball;
+    }
+}
+
+/// @brief Mesure toutes les opérations sur une scène générée.
+static int Bench_RunScene(Bench *bench, GeneratorKind kind, int size)
+{
+    Scene *scene = NULL;
+    BallId *created = NULL;
+    uint32_t state = bench->seed ? bench->seed : 1;
+    Vec2 lower, upper;
+
+    fprintf(stderr, "%s %d...\n", Generator_GetName(kind), size);
+
+    scene = Scene_New(NULL, 10, 3.2f);
+    if (!scene) goto ERROR_LABEL;
+
+    Scene_SetSolver(scene, bench->solverMode);
+
+    int exitStatus = Generator_Build(scene, kind, size, bench->seed);
+    if (exitStatus == EXIT_FAILURE) goto ERROR_LABEL;
+
+    bench->ballCount = Scene_GetBallCount(scene);
+    bench->springCount = scene->m_springs->m_count;
+
+    // Pas de temps
+    for (int i = 0; i < BENCH_WARMUP_STEPS; ++i)
+    {
+        Bench_Step(bench, scene);
+    }
+    for (int i = 0; i < bench->stepSamples; ++i)
+    {
+        bench->samples[i] = Bench_Step(bench, scene);
+    }
+    Bench_Report(bench, kind, "step", bench->stepSamples, true);
+
+    // Recherche des balles les plus proches (la première recherche reconstruit la grille)
+    Bench_GetBounds(scene, &lower, &upper);
+    Scene_GetNearestBalls(scene, lower, scene->m_queries, BENCH_QUERY_COUNT);
+    for (int i = 0; i < bench->querySamples; ++i)
+    {
+        Vec2 position = Bench_RandomPosition(&state, lower, upper);
+
+        double start = Bench_Now();
+        Scene_GetNearestBalls(scene, position, scene->m_queries, BENCH_QUERY_COUNT);
+        bench->samples[i] = Bench_Now() - start;
+    }
+    Bench_Report(bench, kind, "query", bench->querySamples, false);
+
+    // Ajout de balles
+    created = (BallId *)calloc(
+        SDL_max(bench->stepSamples, bench->querySamples), sizeof(BallId));
+    if (!created) goto ERROR_LABEL;
+
+    for (int i = 0; i < bench->querySamples; ++i)
+    {
+        Vec2 position = Bench_RandomPosition(&state, lower, upper);
+
+        double start = Bench_Now();
+        created[i] = Scene_CreateBall(scene, position);
+        bench->samples[i] = Bench_Now() - start;
+    }
+    Bench_Report(bench, kind, "create", bench->querySamples, false);
+
+    // Suppression des balles créées, dans un ordre aléatoire, par leurs identifiants
+    // (la taille de la scène revient à sa valeur initiale)
+    Bench_Shuffle(created, bench->querySamples, &state);
+    for (int i = 0; i < bench->querySamples; ++i)
+    {
+        double start = Bench_Now();
+        Scene_RemoveBall(scene, created[i]);
+        bench->samples[i] = Bench_Now() - start;
+    }
+    Bench_Report(bench, kind, "remove", bench->querySamples, false);
+
+    // Les mesures précédentes ne comptent pas le calcul des îles différé au pas de temps
+    // suivant : chaque ajout est ici suivi d'un pas de temps, mesuré avec lui
+    Bench_Step(bench, scene);
+    for (int i = 0; i < bench->stepSamples; ++i)
+    {
+        Vec2 position = Bench_RandomPosition(&state, lower, upper);
+
+        double start = Bench_Now();
+        created[i] = Scene_CreateBall(scene, position);
+        double duration = Bench_Now() - start;
+        bench->samples[i] = duration + Bench_Step(bench, scene);
+    }
+    Bench_Report(bench, kind, "create+step", bench->stepSamples, false);
+
+    // De même pour les suppressions
+    Bench_Shuffle(created, bench->stepSamples, &state);
+    for (int i = 0; i < bench->stepSamples; ++i)
+    {
+        double start = Bench_Now();
+        Scene_RemoveBall(scene, created[i]);
+        double duration = Bench_Now() - start;
+        bench->samples[i] = duration + Bench_Step(bench, scene);
+    }
+    Bench_Report(bench, kind, "remove+step", bench->stepSamples, false);
+
+    free(created);
+    Scene_Free(scene);
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - Bench_RunScene()\n");
+    free(created);
+    Scene_Free(scene);
+    return EXIT_FAILURE;
+}
+
+/// @brief Vérifie que toutes les îles d'une scène générée finissent par s'endormir.
+/// @return EXIT_SUCCESS si toutes les îles dorment avant bench->settleSteps pas de temps.
+static int Bench_CheckSettle(Bench *bench, GeneratorKind kind, int size)
+{
+    Scene *scene = NULL;
+    int step = 0;
+
+    scene = Scene_New(NULL, 10, 3.2f);
+    if (!scene) goto ERROR_LABEL;
+
+    Scene_SetSolver(scene, bench->solverMode);
+
+    int exitStatus = Generator_Build(scene, kind, size, bench->seed);
+    if (exitStatus == EXIT_FAILURE) goto ERROR_LABEL;
+
+    // Une île endormie peut être réveillée par une autre : la scène n'est stable que si
+    // toutes les îles dorment en même temps
+    Islands *islands = scene->m_islands;
+    for (step = 0; step < bench->settleSteps; ++step)
+    {
+        Scene_FixedUpdate(scene, scene->m_timeStep);
+        if (islands->m_awakeCount == 0)
+            break;
+    }
+
+    bool settled = (islands->m_awakeCount == 0);
+    fprintf(
+        bench->output, "%s %d (%s) : %d îles, %d éveillées après %d pas de temps\n",
+        Generator_GetName(kind), Scene_GetBallCount(scene), g_solverNames[bench->solverMode],
+        islands->m_islandCount, islands->m_awakeCount, step + (settled ? 1 : 0)
+    );
+
+    Scene_Free(scene);
+
+    return settled ? EXIT_SUCCESS : EXIT_FAILURE;
+
+ERROR_LABEL:
+    printf("ERROR - Bench_CheckSettle()\n");
+    Scene_Free(scene);
+    return EXIT_FAILURE;
+}
+
+/// @brief Affiche les options de la ligne de commande.
+static void Bench_PrintUsage(const char *program)
+{
+    printf(
+        "Usage : %s [options]\n"
+        "  --scenes A,B,...   familles de scènes (lattice, chains, mesh, islands)\n"
+        "  --sizes N,M,...    nombres de balles (de 1000 à 1000000)\n"
+        "  --solver NOM       explicit, implicit ou xpbd\n"
+        "  --threads N        nombre de threads (0 : un par coeur)\n"
+        "  --steps N          nombre de pas de temps mesurés (seuls, puis après un ajout\n"
+        "                     ou une suppression)\n"
+        "  --queries N        nombre de recherches et d'ajouts/suppressions mesurés\n"
+        "  --seed N           graine des générateurs\n"
+        "  --allow-sleep      laisse les îles au repos s'endormir\n"
+        "  --settle N         vérifie que toutes les îles dorment en moins de N pas de temps\n"
+        "  --json             résultats au format JSON (CSV par défaut)\n"
+        "  --output FICHIER   écrit les résultats dans un fichier\n"
+        "  --label TEXTE      étiquette des résultats (par exemple le commit mesuré)\n",
+        program
+    );
+}
+
+/// @brief Lit les options de la ligne de commande.
+static int Bench_ParseOptions(Bench *bench, int argc, char *argv[], const char **outputPath)
+{
+    bench->label = "";
+    bench->solverMode = SOLVER_EXPLICIT;
+    bench->threadCount = THREAD_COUNT;
+    bench->sizes[0] = 1000;
+    bench->sizes[1] = 10000;
+    bench->sizes[2] = 100000;
+    bench->sizeCount = 3;
+    for (int i = 0; i < GENERATOR_COUNT; ++i)
+        bench->kinds[i] = true;
+    bench->stepSamples = BENCH_STEP_SAMPLES;
+    bench->querySamples = BENCH_QUERY_SAMPLES;
+    bench->seed = 1;
+    bench->allowSleep = false;
+    bench->settleSteps = 0;
+    bench->format = BENCH_CSV;
+    *outputPath = NULL;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if ((strcmp(argv[i], "--scenes") == 0) && (i + 1 < argc))
+        {
+            char names[256];
+            snprintf(names, sizeof(names), "%s", argv[++i]);
+            for (int k = 0; k < GENERATOR_COUNT; ++k)
+                bench->kinds[k] = false;
+
+            for (char *name = strtok(names, ","); name; name = strtok(NULL, ","))
+            {
+                GeneratorKind kind = Generator_FromName(name);
+                if (kind == GENERATOR_COUNT) goto ERROR_LABEL;
+                bench->kinds[kind] = true;
+            }
+        }
+        else if ((strcmp(argv[i], "--sizes") == 0) && (i + 1 < argc))
+        {
+            char sizes[256];
+            snprintf(sizes, sizeof(sizes), "%s", argv[++i]);
+            bench->sizeCount = 0;
+
+            for (char *size = strtok(sizes, ","); size; size = strtok(NULL, ","))
+            {
+                if ((bench->sizeCount >= BENCH_MAX_SIZES) || (atoi(size) <= 0)) goto ERROR_LABEL;
+                bench->sizes[bench->sizeCount++] = atoi(size);
+            }
+        }
+        else if ((strcmp(argv[i], "--solver") == 0) && (i + 1 < argc))
+        {
+            const char *name = argv[++i];
+            if (strcmp(name, "explicit") == 0)      bench->solverMode = SOLVER_EXPLICIT;
+            else if (strcmp(name, "implicit") == 0) bench->solverMode = SOLVER_IMPLICIT;
+            else if (strcmp(name, "xpbd") == 0)     bench->solverMode = SOLVER_XPBD;
+            else goto ERROR_LABEL;
+        }
+        else if ((strcmp(argv[i], "--threads") == 0) && (i + 1 < argc))
+        {
+            bench->threadCount = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "--steps") == 0) && (i + 1 < argc))
+        {
+            int count = atoi(argv[++i]);
+            bench->stepSamples = SDL_max(count, 1);
+        }
+        else if ((strcmp(argv[i], "--queries") == 0) && (i + 1 < argc))
+        {
+            int count = atoi(argv[++i]);
+            bench->querySamples = SDL_max(count, 1);
+        }
+        else if ((strcmp(argv[i], "--seed") == 0) && (i + 1 < argc))
+        {
+            bench->seed = (uint32_t)strtoul(argv[++i], NULL, 10);
+        }
+        else if (strcmp(argv[i], "--allow-sleep") == 0)
+        {
+            bench->allowSleep = true;
+        }
+        else if ((strcmp(argv[i], "--settle") == 0) && (i + 1 < argc))
+        {
+            int count = atoi(argv[++i]);
+            if (count <= 0) goto ERROR_LABEL;
+            bench->settleSteps = count;
+        }
+        else if (strcmp(argv[i], "--json") == 0)
+        {
+            bench->format = BENCH_JSON;
+        }
+        else if ((strcmp(argv[i], "--output") == 0) && (i + 1 < argc))
+        {
+            *outputPath = argv[++i];
+        }
+        else if ((strcmp(argv[i], "--label") == 0) && (i + 1 < argc))
+        {
+            bench->label = argv[++i];
+        }
+        else goto ERROR_LABEL;
+    }
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    Bench_PrintUsage(argv[0]);
+    return EXIT_FAILURE;
+}
+
+int main(int argc, char *argv[])
+{
+    Bench bench = { 0 };
+    const char *outputPath = NULL;
+    bool settled = true;
+
+    int exitStatus = Bench_ParseOptions(&bench, argc, argv, &outputPath);
+    if (exitStatus == EXIT_FAILURE) return EXIT_FAILURE;
+
+    exitStatus = Settings_InitSDL(false);
+    if (exitStatus == EXIT_FAILURE) goto ERROR_LABEL;
+
+    g_threadPool = ThreadPool_New(bench.threadCount, THREAD_PINNING);
+    if (!g_threadPool) goto ERROR_LABEL;
+    ThreadPool_PinCallingThread(g_threadPool);
+
+    bench.samples = (double *)calloc(SDL_max(bench.stepSamples, bench.querySamples), sizeof(double));
+    if (!bench.samples) goto ERROR_LABEL;
+
+    bench.output = outputPath ? fopen(outputPath, "w") : stdout;
+    if (!bench.output) goto ERROR_LABEL;
+
+    // La vérification de la mise en sommeil n'écrit qu'une ligne de texte par scène
+    if ((bench.settleSteps <= 0) && (bench.format == BENCH_CSV))
+    {
+        fprintf(
+            bench.output, "label,scene,balls,springs,solver,threads,metric,samples,"
+            "median_ns,p99_ns,per_second,ns_per_ball,ns_per_spring\n"
+        );
+    }
+    else if (bench.settleSteps <= 0)
+    {
+        fprintf(bench.output, "{\n  \"label\": \"%s\",\n  \"results\": [\n", bench.label);
+    }
+
+    for (int k = 0; k < GENERATOR_COUNT; ++k)
+    {
+        if (!bench.kinds[k])
+            continue;
+
+        for (int i = 0; i < bench.sizeCount; ++i)
+        {
+            if (bench.settleSteps > 0)
+            {
+                if (Bench_CheckSettle(&bench, (GeneratorKind)k, bench.sizes[i]) == EXIT_FAILURE)
+                    settled = false;
+                continue;
+            }
+
+            exitStatus = Bench_RunScene(&bench, (GeneratorKind)k, bench.sizes[i]);
+            if (exitStatus == EXIT_FAILURE) goto ERROR_LABEL;
+        }
+    }
+
+    if ((bench.settleSteps <= 0) && (bench.format == BENCH_JSON))
+        fprintf(bench.output, "\n  ]\n}\n");
+
+    if (bench.output != stdout)
+        fclose(bench.output);
+    free(bench.samples);
+    ThreadPool_Free(g_threadPool);
+    g_threadPool = NULL;
+    Settings_QuitSDL();
+
+    return settled ? EXIT_SUCCESS : EXIT_FAILURE;
+
+ERROR_LABEL:
+    printf("ERROR - main()\n");
+    if (bench.output && bench.output != stdout)
+        fclose(bench.output);
+    free(bench.samples);
+    ThreadPool_Free(g_threadPool);
+    Settings_QuitSDL();
+    return EXIT_FAILURE;
+}
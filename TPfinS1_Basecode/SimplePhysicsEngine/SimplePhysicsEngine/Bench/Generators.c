@@ -0,0 +1,225 @@
+﻿#include "Generators.h"
+#include "../Game/Ball.h"
+
+/// @brief Altitude de la première rangée de balles (exprimée en m).
+#define GENERATOR_HEIGHT 1.0f
+
+static const char *g_generatorNames[GENERATOR_COUNT] = {
+    "lattice", "chains", "mesh", "islands"
+};
+
+const char *Generator_GetName(GeneratorKind kind)
+{
+    return g_generatorNames[kind];
+}
+
+GeneratorKind Generator_FromName(const char *name)
+{
+    for (int i = 0; i < GENERATOR_COUNT; ++i)
+    {
+        if (strcmp(name, g_generatorNames[i]) == 0)
+            return (GeneratorKind)i;
+    }
+    return GENERATOR_COUNT;
+}
+
+uint32_t Generator_Random(uint32_t *state)
+{
+    uint32_t x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    *state = x;
+    return x;
+}
+
+float Generator_RandomFloat(uint32_t *state)
+{
+    return (float)(Generator_Random(state) >> 8) / (float)(1 << 24);
+}
+
+/// @brief Relie deux balles par un ressort au repos.
+static void Generator_Connect(Scene *scene, BallId ball1, BallId ball2)
+{
+    Vec2 position1 = Ball_GetPosition(scene, ball1);
+    Vec2 position2 = Ball_GetPosition(scene, ball2);
+    Ball_Connect(scene, ball1, ball2, Vec2_Distance(position1, position2));
+}
+
+/// @brief Indique si deux balles sont déjà reliées par un ressort.
+static bool Generator_AreConnected(Scene *scene, BallId id1, BallId id2)
+{
+    int ball1 = Particles_GetIndex(scene->m_particles, id1);
+    int ball2 = Particles_GetIndex(scene->m_particles, id2);
+    BallLinks *links = &scene->m_links[ball1];
+
+    for (int i = 0; i < links->springCount; ++i)
+    {
+        if (Springs_GetOther(scene->m_springs, links->springs[i], ball1) == ball2)
+            return true;
+    }
+    return false;
+}
+
+/// @brief Treillis carré contreventé de côté sqrt(ballCount).
+static int Generator_BuildLattice(Scene *scene, int ballCount, BallId *balls)
+{
+    int width = SDL_max((int)sqrtf((float)ballCount), 1);
+    int height = SDL_max(ballCount / width, 1);
+
+    for (int j = 0; j < height; ++j)
+    {
+        for (int i = 0; i < width; ++i)
+        {
+            Vec2 position = Vec2_Set(i * GENERATOR_SPACING, GENERATOR_HEIGHT + j * GENERATOR_SPACING);
+            BallId ball = Scene_CreateBall(scene, position);
+            if (ball == BALL_NONE) return EXIT_FAILURE;
+
+            balls[j * width + i] = ball;
+
+            // Relie la balle à ses voisines de gauche et du dessous
+            if (i > 0)
+                Generator_Connect(scene, ball, balls[j * width + i - 1]);
+            if (j > 0)
+                Generator_Connect(scene, ball, balls[(j - 1) * width + i]);
+            if ((i > 0) && (j > 0))
+                Generator_Connect(scene, ball, balls[(j - 1) * width + i - 1]);
+            if ((i + 1 < width) && (j > 0))
+                Generator_Connect(scene, ball, balls[(j - 1) * width + i + 1]);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/// @brief Chaînes horizontales de GENERATOR_CHAIN_LENGTH balles empilées.
+static int Generator_BuildChains(Scene *scene, int ballCount)
+{
+    BallId previous = BALL_NONE;
+
+    for (int k = 0; k < ballCount; ++k)
+    {
+        int i = k % GENERATOR_CHAIN_LENGTH;
+        int j = k / GENERATOR_CHAIN_LENGTH;
+
+        Vec2 position = Vec2_Set(i * GENERATOR_SPACING, GENERATOR_HEIGHT + 2.f * j);
+        BallId ball = Scene_CreateBall(scene, position);
+        if (ball == BALL_NONE) return EXIT_FAILURE;
+
+        if (i > 0)
+            Generator_Connect(scene, ball, previous);
+
+        previous = ball;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/// @brief Balles placées sur une grille perturbée, reliées à leurs plus proches voisines.
+static int Generator_BuildMesh(Scene *scene, int ballCount, uint32_t *state, BallId *balls)
+{
+    int width = SDL_max((int)sqrtf((float)ballCount), 1);
+    BallQuery queries[GENERATOR_MESH_NEIGHBORS + 1];
+
+    // La perturbation garde les balles à une distance supérieure à leur diamètre
+    float spacing = 1.5f * GENERATOR_SPACING;
+    float jitter = 0.5f * (spacing - 2.f * BALL_RADIUS);
+
+    for (int k = 0; k < ballCount; ++k)
+    {
+        float x = (k % width) * spacing + jitter * (2.f * Generator_RandomFloat(state) - 1.f);
+        float y = (k / width) * spacing + jitter * (2.f * Generator_RandomFloat(state) - 1.f);
+
+        balls[k] = Scene_CreateBall(scene, Vec2_Set(x, GENERATOR_HEIGHT + y));
+        if (balls[k] == BALL_NONE) return EXIT_FAILURE;
+    }
+
+    // Les balles ne bougent pas pendant la construction : la grille de recherche n'est
+    // reconstruite qu'une seule fois
+    for (int k = 0; k < ballCount; ++k)
+    {
+        Vec2 position = Ball_GetPosition(scene, balls[k]);
+        int count = Scene_GetBallsInRadius(
+            scene, position, 2.f * spacing, queries, GENERATOR_MESH_NEIGHBORS + 1);
+
+        for (int i = 0; i < count; ++i)
+        {
+            // La balle elle-même fait partie des résultats
+            if ((queries[i].ball != balls[k])
+                && !Generator_AreConnected(scene, balls[k], queries[i].ball))
+                Generator_Connect(scene, balls[k], queries[i].ball);
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/// @brief Triangles indépendants disposés en grille.
+static int Generator_BuildIslands(Scene *scene, int ballCount)
+{
+    int triangleCount = SDL_max(ballCount / 3, 1);
+    int width = SDL_max((int)sqrtf((float)triangleCount), 1);
+
+    for (int k = 0; k < triangleCount; ++k)
+    {
+        float x = (k % width) * 4.f * GENERATOR_SPACING;
+        float y = GENERATOR_HEIGHT + (k / width) * 4.f * GENERATOR_SPACING;
+
+        BallId ball1 = Scene_CreateBall(scene, Vec2_Set(x, y));
+        BallId ball2 = Scene_CreateBall(scene, Vec2_Set(x + 2.f * GENERATOR_SPACING, y));
+        BallId ball3 = Scene_CreateBall(scene, Vec2_Set(x + GENERATOR_SPACING, y + 2.f * GENERATOR_SPACING));
+        if ((ball1 == BALL_NONE) || (ball2 == BALL_NONE) || (ball3 == BALL_NONE))
+            return EXIT_FAILURE;
+
+        Generator_Connect(scene, ball1, ball2);
+        Generator_Connect(scene, ball2, ball3);
+        Generator_Connect(scene, ball3, ball1);
+    }
+
+    return EXIT_SUCCESS;
+}
+
+int Generator_Build(Scene *scene, GeneratorKind kind, int ballCount, uint32_t seed)
+{
+    uint32_t state = seed ? seed : 1;
+    int exitStatus = EXIT_SUCCESS;
+    BallId *balls = NULL;
+
+    Scene_Clear(scene);
+
+    balls = (BallId *)calloc(SDL_max(ballCount, 1), sizeof(BallId));
+    if (!balls) goto ERROR_LABEL;
+
+    switch (kind)
+    {
+    case GENERATOR_LATTICE:
+        exitStatus = Generator_BuildLattice(scene, ballCount, balls);
+        break;
+
+    case GENERATOR_CHAINS:
+        exitStatus = Generator_BuildChains(scene, ballCount);
+        break;
+
+    case GENERATOR_MESH:
+        exitStatus = Generator_BuildMesh(scene, ballCount, &state, balls);
+        break;
+
+    case GENERATOR_ISLANDS:
+        exitStatus = Generator_BuildIslands(scene, ballCount);
+        break;
+
+    default:
+        exitStatus = EXIT_FAILURE;
+        break;
+    }
+    if (exitStatus == EXIT_FAILURE) goto ERROR_LABEL;
+
+    free(balls);
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - Generator_Build()\n");
+    free(balls);
+    return EXIT_FAILURE;
+}
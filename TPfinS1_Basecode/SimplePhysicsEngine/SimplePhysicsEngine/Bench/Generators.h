@@ -0,0 +1,69 @@
+﻿#ifndef _GENERATORS_H_
+#define _GENERATORS_H_
+
+/// @file generators.h
+/// @defgroup Bench
+/// @{
+
+#include "../Settings.h"
+#include "../Game/Scene.h"
+
+/// @brief Familles de scènes générées pour les mesures de performance.
+typedef enum GeneratorKind_e
+{
+    /// @brief Treillis carré dont chaque case est contreventée par ses deux diagonales.
+    GENERATOR_LATTICE,
+
+    /// @brief Longues chaînes horizontales de balles.
+    GENERATOR_CHAINS,
+
+    /// @brief Balles placées aléatoirement, chacune reliée à ses k plus proches voisines.
+    GENERATOR_MESH,
+
+    /// @brief Nombreux triangles indépendants (une île par triangle).
+    GENERATOR_ISLANDS,
+
+    GENERATOR_COUNT
+} GeneratorKind;
+
+/// @brief Nombre de balles d'une chaîne générée.
+#define GENERATOR_CHAIN_LENGTH 1000
+
+/// @brief Nombre de voisines auxquelles une balle du maillage aléatoire est reliée.
+#define GENERATOR_MESH_NEIGHBORS 4
+
+/// @brief Distance entre deux balles voisines d'une scène générée (exprimée en m).
+#define GENERATOR_SPACING 0.5f
+
+/// @brief Renvoie le nom d'une famille de scènes.
+/// @param[in] kind la famille.
+/// @return Le nom de la famille.
+const char *Generator_GetName(GeneratorKind kind);
+
+/// @brief Recherche une famille de scènes à partir de son nom.
+/// @param[in] name le nom de la famille.
+/// @return La famille ou GENERATOR_COUNT si le nom est inconnu.
+GeneratorKind Generator_FromName(const char *name);
+
+/// @brief Remplace le contenu d'une scène par une scène générée.
+/// Une même graine produit toujours la même scène, quelle que soit la plateforme.
+/// @param[in,out] scene la scène.
+/// @param[in] kind la famille de scènes.
+/// @param[in] ballCount le nombre de balles (approximatif pour certaines familles).
+/// @param[in] seed la graine du générateur pseudo-aléatoire.
+/// @return EXIT_SUCCESS ou EXIT_FAILURE.
+int Generator_Build(Scene *scene, GeneratorKind kind, int ballCount, uint32_t seed);
+
+/// @brief Renvoie un nombre pseudo-aléatoire et met à jour l'état du générateur (xorshift).
+/// @param[in,out] state l'état du générateur (non nul).
+/// @return Un nombre pseudo-aléatoire.
+uint32_t Generator_Random(uint32_t *state);
+
+/// @brief Renvoie un réel pseudo-aléatoire dans [0, 1).
+/// @param[in,out] state l'état du générateur (non nul).
+/// @return Un réel pseudo-aléatoire.
+float Generator_RandomFloat(uint32_t *state);
+
+/// @}
+
+#endif
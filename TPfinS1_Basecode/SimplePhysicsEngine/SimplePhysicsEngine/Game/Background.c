@@ -1,94 +1,244 @@
-#include "Background.h"
-#include "Scene.h"
-
-void Background_Render(Scene *scene)
-{
-    Camera *camera = Scene_GetCamera(scene);
-    Renderer *renderer = Scene_GetRenderer(scene);
-    Textures *textures = scene->m_textures;
-    Rect view = Camera_GetView(camera);
-
-    float xShiftFactors[LAYER_COUNT] = { 0.0f, 0.05f, 0.2f, 0.4f, 0.6f };
-    float yShiftFactors[LAYER_COUNT] = { 0.0f, 0.05f, 0.1f, 0.2f, 0.3f };
-
-    // Couleur de remplissage (identique au ciel)
-    Renderer_Fill(renderer, Color_Set(145, 134, 161, 255));
-
-    // Dimension du fond dans le rfrentiel monde
-    float worldW = 1.3f * 16.0f;
-    float worldH = 1.3f * 9.0f;
-
-    // Dessine les diffrents calques du fond (parallax)
-    for (int i = 0; i < LAYER_COUNT; ++i)
-    {
-        Vec2 origin = Vec2_Set(
-            view.x * (1.0f - xShiftFactors[i]),
-            -0.2f + view.y * (1.0f - yShiftFactors[i])
-        );
-
-        int tileXMin = (int)floorf((view.x - origin.x) / worldW);
-        int tileXMax = (int)ceilf((view.x + view.w - origin.x) / worldW);
-
-        for (int tileXIdx = tileXMin; tileXIdx < tileXMax; ++tileXIdx)
-        {
-            int tileYIdx = 0;
-            Vec2 lower = Vec2_Set(tileXIdx * worldW, (tileYIdx + 1) * worldH);
-            Vec2 upper = Vec2_Set((tileXIdx + 1) * worldW, tileYIdx * worldH);
-
-            lower = Vec2_Add(lower, origin);
-            upper = Vec2_Add(upper, origin);
-
-            float x0, x1, y0, y1;
-            Camera_WorldToView(camera, lower, &x0, &y0);
-            Camera_WorldToView(camera, upper, &x1, &y1);
-
-            SDL_FRect dstRect = { 0 };
-            dstRect.x = x0;
-            dstRect.y = y0;
-            dstRect.w = fabsf(x1 - x0);
-            dstRect.h = fabsf(y1 - y0);
-
-            SDL_RenderCopyF(renderer->m_rendererSDL, textures->m_layers[i], NULL, &dstRect);
-        }
-    }
-}
-
-void TileMap_Render(Scene *scene)
-{
-    Camera *camera = Scene_GetCamera(scene);
-    Renderer *renderer = Scene_GetRenderer(scene);
-    Textures *textures = scene->m_textures;
-    Rect view = Camera_GetView(camera);
-
-    // Dimension du sol dans le rfrentiel monde
-    float worldW = 10.0f;
-    float worldH = 1.0f;
-
-    // Dessine le sol
-    Vec2 origin = Vec2_Set(0.0f, -1.2f);
-
-    int tileXMin = (int)floorf((view.x - origin.x) / worldW);
-    int tileXMax = (int)ceilf((view.x + view.w - origin.x) / worldW);
-
-    for (int tileXIdx = tileXMin; tileXIdx < tileXMax; ++tileXIdx)
-    {
-        int tileYIdx = 0;
-        Vec2 lower = Vec2_Set(tileXIdx * worldW, (tileYIdx + 1) * worldH);
-        Vec2 upper = Vec2_Set((tileXIdx + 1) * worldW, tileYIdx * worldH);
-
-        lower = Vec2_Add(lower, origin);
-        upper = Vec2_Add(upper, origin);
-
-        float x0, x1, y0, y1;
-        Camera_WorldToView(camera, lower, &x0, &y0);
-        Camera_WorldToView(camera, upper, &x1, &y1);
-
-        SDL_FRect dstRect = { 0 };
-        dstRect.x = x0;
-        dstRect.y = y0;
-        dstRect.w = fabsf(x1 - x0);
-        dstRect.h = fabsf(y1 - y0);
-
-        SDL_RenderCopyF(renderer->m_rendererSDL, textures->m_ground, NULL, &dstRect);
-    }
-}
+#include "Background.h"
+#include "Scene.h"
+#include "../Utils/Profiler.h"
+
+BackgroundCache *BackgroundCache_New()
+{
+    BackgroundCache *cache = NULL;
+
+    cache = (BackgroundCache *)calloc(1, sizeof(BackgroundCache));
+    if (!cache) goto ERROR_LABEL;
+
+    cache->m_supported = true;
+
+    return cache;
+
+ERROR_LABEL:
+    printf("ERROR - BackgroundCache_New()\n");
+    assert(false);
+    BackgroundCache_Free(cache);
+    return NULL;
+}
+
+void BackgroundCache_Free(BackgroundCache *cache)
+{
+    if (!cache) return;
+
+    if (cache->m_target)
+        SDL_DestroyTexture(cache->m_target);
+
+    memset(cache, 0, sizeof(BackgroundCache));
+    free(cache);
+}
+
+void BackgroundCache_Invalidate(BackgroundCache *cache)
+{
+    cache->m_valid = false;
+}
+
+/// @brief (Re)cre la texture cible aux dimensions de l'image rendue.
+static int BackgroundCache_CreateTarget(BackgroundCache *cache, Renderer *renderer)
+{
+    SDL_Renderer *rendererSDL = renderer->m_rendererSDL;
+    int width = Renderer_GetWidth(renderer);
+    int height = Renderer_GetHeight(renderer);
+
+    if (cache->m_target && (cache->m_width == width) && (cache->m_height == height))
+        return EXIT_SUCCESS;
+
+    if (cache->m_target)
+        SDL_DestroyTexture(cache->m_target);
+    cache->m_valid = false;
+
+    cache->m_target = SDL_CreateTexture(
+        rendererSDL, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+    if (!cache->m_target) goto ERROR_LABEL;
+
+    // Le fond est opaque : la copie n'a pas besoin de mlange
+    SDL_SetTextureBlendMode(cache->m_target, SDL_BLENDMODE_NONE);
+
+    cache->m_width = width;
+    cache->m_height = height;
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("WARNING - SDL_CreateTexture() failed: %s\n", SDL_GetError());
+    return EXIT_FAILURE;
+}
+
+void BackgroundCache_Render(BackgroundCache *cache, Scene *scene)
+{
+    Renderer *renderer = Scene_GetRenderer(scene);
+    Camera *camera = Scene_GetCamera(scene);
+    SDL_Renderer *rendererSDL = renderer->m_rendererSDL;
+
+    if (cache->m_supported)
+    {
+        cache->m_supported = SDL_RenderTargetSupported(rendererSDL)
+            && (BackgroundCache_CreateTarget(cache, renderer) == EXIT_SUCCESS);
+    }
+
+    if (!cache->m_supported)
+    {
+        // Dessine directement le fond et le sol
+        PROFILE_ZONE_BEGIN("Background_Render");
+        Background_Render(scene);
+        PROFILE_ZONE_END();
+
+        PROFILE_ZONE_BEGIN("TileMap_Render");
+        TileMap_Render(scene);
+        PROFILE_ZONE_END();
+        return;
+    }
+
+    // Dplacement de la camra (exprim en pixels) depuis la dernire composition
+    Rect view = Camera_GetView(camera);
+    float dx = (view.x - cache->m_viewX) * camera->m_scaleX;
+    float dy = (view.y - cache->m_viewY) * camera->m_scaleY;
+
+    if ((!cache->m_valid) || (fabsf(dx) > 1.0f) || (fabsf(dy) > 1.0f)
+        || (camera->m_scaleX != cache->m_scaleX) || (camera->m_scaleY != cache->m_scaleY))
+    {
+        PROFILE_ZONE_BEGIN("BackgroundCache_Compose");
+
+        // Compose le fond et le sol dans la texture cible
+        SpriteBatch_Flush(scene->m_batch);
+        SDL_SetRenderTarget(rendererSDL, cache->m_target);
+
+        PROFILE_ZONE_BEGIN("Background_Render");
+        Background_Render(scene);
+        PROFILE_ZONE_END();
+
+        PROFILE_ZONE_BEGIN("TileMap_Render");
+        TileMap_Render(scene);
+        PROFILE_ZONE_END();
+
+        SpriteBatch_Flush(scene->m_batch);
+        SDL_SetRenderTarget(rendererSDL, NULL);
+
+        cache->m_viewX = view.x;
+        cache->m_viewY = view.y;
+        cache->m_scaleX = camera->m_scaleX;
+        cache->m_scaleY = camera->m_scaleY;
+        cache->m_valid = true;
+        cache->m_composeCount++;
+
+        PROFILE_ZONE_END();
+    }
+
+    // Copie la texture sur tout l'cran
+    Sprite sprite = { 0 };
+    sprite.m_texture = cache->m_target;
+    sprite.m_rect.w = cache->m_width;
+    sprite.m_rect.h = cache->m_height;
+    sprite.m_uv.w = 1.0f;
+    sprite.m_uv.h = 1.0f;
+
+    SDL_FRect dstRect = { 0 };
+    dstRect.w = (float)cache->m_width;
+    dstRect.h = (float)cache->m_height;
+
+    SpriteBatch_AddRect(scene->m_batch, &sprite, &dstRect);
+}
+
+void Background_Render(Scene *scene)
+{
+    Camera *camera = Scene_GetCamera(scene);
+    Renderer *renderer = Scene_GetRenderer(scene);
+    Textures *textures = scene->m_textures;
+    Rect view = Camera_GetView(camera);
+
+    float xShiftFactors[LAYER_COUNT] = { 0.0f, 0.05f, 0.2f, 0.4f, 0.6f };
+    float yShiftFactors[LAYER_COUNT] = { 0.0f, 0.05f, 0.1f, 0.2f, 0.3f };
+
+    // Couleur de remplissage (identique au ciel)
+    Renderer_Fill(renderer, Color_Set(145, 134, 161, 255));
+
+    // Dimension du fond dans le rfrentiel monde
+    float worldW = 1.3f * 16.0f;
+    float worldH = 1.3f * 9.0f;
+
+    // Dessine les diffrents calques du fond (parallax)
+    for (int i = 0; i < LAYER_COUNT; ++i)
+    {
+        Vec2 origin = Vec2_Set(
+            view.x * (1.0f - xShiftFactors[i]),
+            -0.2f + view.y * (1.0f - yShiftFactors[i])
+        );
+
+        // Le calque n'occupe qu'une range de tuiles
+        if ((origin.y > view.y + view.h) || (origin.y + worldH < view.y))
+            continue;
+
+        int tileXMin = (int)floorf((view.x - origin.x) / worldW);
+        int tileXMax = (int)ceilf((view.x + view.w - origin.x) / worldW);
+
+        for (int tileXIdx = tileXMin; tileXIdx < tileXMax; ++tileXIdx)
+        {
+            int tileYIdx = 0;
+            Vec2 lower = Vec2_Set(tileXIdx * worldW, (tileYIdx + 1) * worldH);
+            Vec2 upper = Vec2_Set((tileXIdx + 1) * worldW, tileYIdx * worldH);
+
+            lower = Vec2_Add(lower, origin);
+            upper = Vec2_Add(upper, origin);
+
+            float x0, x1, y0, y1;
+            Camera_WorldToView(camera, lower, &x0, &y0);
+            Camera_WorldToView(camera, upper, &x1, &y1);
+
+            SDL_FRect dstRect = { 0 };
+            dstRect.x = x0;
+            dstRect.y = y0;
+            dstRect.w = fabsf(x1 - x0);
+            dstRect.h = fabsf(y1 - y0);
+
+            SpriteBatch_AddRect(scene->m_batch, &textures->m_layers[i], &dstRect);
+            scene->m_renderStats.drawnTiles++;
+        }
+    }
+}
+
+void TileMap_Render(Scene *scene)
+{
+    Camera *camera = Scene_GetCamera(scene);
+    Textures *textures = scene->m_textures;
+    Rect view = Camera_GetView(camera);
+
+    // Dimension du sol dans le rfrentiel monde
+    float worldW = 10.0f;
+    float worldH = 1.0f;
+
+    // Dessine le sol
+    Vec2 origin = Vec2_Set(0.0f, -1.2f);
+
+    // Le sol n'occupe qu'une range de tuiles
+    if ((origin.y > view.y + view.h) || (origin.y + worldH < view.y))
+        return;
+
+    int tileXMin = (int)floorf((view.x - origin.x) / worldW);
+    int tileXMax = (int)ceilf((view.x + view.w - origin.x) / worldW);
+
+    for (int tileXIdx = tileXMin; tileXIdx < tileXMax; ++tileXIdx)
+    {
+        int tileYIdx = 0;
+        Vec2 lower = Vec2_Set(tileXIdx * worldW, (tileYIdx + 1) * worldH);
+        Vec2 upper = Vec2_Set((tileXIdx + 1) * worldW, tileYIdx * worldH);
+
+        lower = Vec2_Add(lower, origin);
+        upper = Vec2_Add(upper, origin);
+
+        float x0, x1, y0, y1;
+        Camera_WorldToView(camera, lower, &x0, &y0);
+        Camera_WorldToView(camera, upper, &x1, &y1);
+
+        SDL_FRect dstRect = { 0 };
+        dstRect.x = x0;
+        dstRect.y = y0;
+        dstRect.w = fabsf(x1 - x0);
+        dstRect.h = fabsf(y1 - y0);
+
+        SpriteBatch_AddRect(scene->m_batch, &textures->m_ground, &dstRect);
+        scene->m_renderStats.drawnTiles++;
+    }
+}
@@ -1,11 +1,54 @@
-#ifndef _BACKGROUND_H_
-#define _BACKGROUND_H_
-
-#include "../Settings.h"
-
-typedef struct Scene_s Scene;
-
-void Background_Render(Scene *scene);
-void TileMap_Render(Scene *scene);
-
-#endif
+#ifndef _BACKGROUND_H_
+#define _BACKGROUND_H_
+
+#include "../Settings.h"
+
+typedef struct Scene_s Scene;
+
+/// @brief Fond de la scne (calques du parallax et sol) compos dans une texture cible.
+/// La texture n'est recompose que si la camra s'est dplace de plus d'un pixel, si le zoom
+/// ou la taille de l'image ont chang, ou si le moteur de rendu a perdu ses textures cibles ;
+/// sinon elle est copie (opaque, sans mlange) en une seule fois.
+typedef struct BackgroundCache_s
+{
+    /// @brief Texture dans laquelle le fond est compos (ou NULL).
+    SDL_Texture *m_target;
+
+    /// @brief Dimensions (exprimes en pixels) de la texture.
+    int m_width, m_height;
+
+    /// @brief Position et chelle de la camra lors de la dernire composition.
+    float m_viewX, m_viewY, m_scaleX, m_scaleY;
+
+    /// @brief Faux si la texture doit tre recompose.
+    bool m_valid;
+
+    /// @brief Faux si le moteur de rendu ne supporte pas les textures cibles : le fond est
+    /// alors dessin directement  chaque image.
+    bool m_supported;
+
+    /// @brief Nombre de compositions depuis la cration.
+    int m_composeCount;
+} BackgroundCache;
+
+/// @brief Cre le cache du fond (la texture est cre au premier rendu).
+/// @return Le cache cr ou NULL en cas d'erreur.
+BackgroundCache *BackgroundCache_New();
+
+/// @brief Dtruit un cache pralablement allou avec BackgroundCache_New().
+/// @param[in,out] cache le cache  dtruire.
+void BackgroundCache_Free(BackgroundCache *cache);
+
+/// @brief Force la recomposition du fond au prochain rendu.
+/// @param[in,out] cache le cache.
+void BackgroundCache_Invalidate(BackgroundCache *cache);
+
+/// @brief Dessine le fond et le sol de la scne, en recomposant la texture si ncessaire.
+/// @param[in,out] cache le cache.
+/// @param[in] scene la scne.
+void BackgroundCache_Render(BackgroundCache *cache, Scene *scene);
+
+void Background_Render(Scene *scene);
+void TileMap_Render(Scene *scene);
+
+#endif
@@ -1,162 +1,171 @@
-﻿#include "Ball.h"
-#include "Scene.h"
-
-Ball Ball_Set(Scene* scene, Vec2 position)
-{
-    Ball ball = { 0 };
-
-    ball.position = position;
-    ball.velocity = Vec2_Set(0.f, 0.f);
-    ball.mass = scene->m_gameMode->mass;
-    ball.mass = 0.5;
-    ball.friction = 0.5f;
-
-    return ball;
-}
-
-int Ball_Connect(Ball *ball1, Ball *ball2, float length)
-{
-    if ((ball1 == ball2)
-        || (ball1->springCount >= MAX_EDGES)
-        || (ball2->springCount >= MAX_EDGES))
-        return EXIT_FAILURE;
-
-    ball1->springs[ball1->springCount].other = ball2;
-    ball2->springs[ball2->springCount].other = ball1;
-    ball1->springs[ball1->springCount].length = length;
-    ball2->springs[ball2->springCount].length = length;
-
-    ball1->springCount++;
-    ball2->springCount++;
-
-    return EXIT_SUCCESS;
-}
-
-int Ball_Deconnect(Ball *ball1, Ball *ball2)
-{
-    int springCount1 = ball1->springCount;
-    int springCount2 = ball2->springCount;
-    int exitStatus = EXIT_SUCCESS;
-    int i;
-
-    // Supprime la ball2 des connexions de la ball1
-    for (i = 0; i < springCount1; ++i)
-    {
-        if (ball1->springs[i].other == ball2)
-        {
-            ball1->springs[i] = ball1->springs[springCount1 - 1];
-            ball1->springCount--;
-            break;
-        }
-    }
-    if (i >= springCount1)
-    {
-        exitStatus = EXIT_FAILURE;
-    }
-
-    // Supprime la ball1 des connexions de la ball2
-    for (i = 0; i < springCount2; ++i)
-    {
-        if (ball2->springs[i].other == ball1)
-        {
-            ball2->springs[i] = ball2->springs[springCount2 - 1];
-            ball2->springCount--;
-            break;
-        }
-    }
-    if (i >= springCount2)
-    {
-        exitStatus = EXIT_FAILURE;
-    }
-
-    return exitStatus;
-}
-
-Vec2 Ball_GetPosition(Ball *ball)
-{
-    return ball->position;
-}
-
-void Ball_UpdateVelocity(Scene* scene, Ball *ball, float timeStep)
-{
-    Vec2 spring = {0};
-    for (int i = 0; i < ball->springCount; ++i) {
-        spring = Vec2_Add(spring, Vec2_Scale(Vec2_Normalize(Vec2_Sub(ball->springs[i].other->position, ball->position)), 200 * (Vec2_Distance(ball->springs[i].other->position, ball->position) - ball->springs[i].length)));
-    }
-
-    Vec2 sum = Vec2_Set(((-ball->friction * ball->velocity.x) + spring.x) / ball->mass, (spring.y + (-ball->friction * ball->velocity.y) + (ball->mass * scene->m_gameMode->gravity)) / ball->mass);
-    Vec2 a = sum;
-
-    ball->velocity.x += a.x * timeStep;
-    ball->velocity.y += a.y * timeStep; 
-}
-
-void Ball_UpdatePosition(Scene* scene, Ball *ball, float timeStep)
-{
-    if (ball->position.y + ball->velocity.y * timeStep <= 0) {
-        ball->velocity.y = Vec2_Scale(ball->velocity, scene->m_gameMode->rebond).y;
-    }
-
-    ball->position.x += ball->velocity.x * timeStep;
-    ball->position.y += ball->velocity.y * timeStep;
-}
-
-void Ball_Render(Ball *ball, Scene *scene)
-{
-    Camera *camera = Scene_GetCamera(scene);
-    Renderer *renderer = Scene_GetRenderer(scene);
-    Textures *textures = scene->m_textures;
-
-    Vec2 lower = Vec2_Sub(ball->position, Vec2_Set(0.2f, 0.2f));
-    Vec2 upper = Vec2_Add(ball->position, Vec2_Set(0.2f, 0.2f));
-
-    float x0, y0, x1, y1;
-    Camera_WorldToView(camera, lower, &x0, &y0);
-    Camera_WorldToView(camera, upper, &x1, &y1);
-
-    SDL_FRect dstRect = { 0 };
-    dstRect.x = x0;
-    dstRect.y = y1;
-    dstRect.w = fabsf(x1 - x0);
-    dstRect.h = fabsf(y1 - y0);
-
-    SDL_RenderCopyF(renderer->m_rendererSDL, textures->m_body, NULL, &dstRect);
-}
-
-void Ball_RenderSpring(Vec2 start, Vec2 end, Scene *scene, bool active)
-{
-    Camera *camera = Scene_GetCamera(scene);
-    Renderer *renderer = Scene_GetRenderer(scene);
-    Textures *textures = scene->m_textures;
-    SDL_Texture *springTexture =
-        active ? textures->m_spring : textures->m_springInactive;
-
-    float shift = 0.1f;
-
-    Vec2 direction = Vec2_Normalize(Vec2_Sub(end, start));
-    Vec2 pointL = Vec2_Add(start, Vec2_Scale(direction, shift));
-    Vec2 pointR = Vec2_Sub(end, Vec2_Scale(direction, shift));
-    Vec2 pointTL = Vec2_Add(pointL, Vec2_Scale(Vec2_Perp(direction), 0.1f));
-    Vec2 pointC = Vec2_Scale(Vec2_Add(pointL, pointR), 0.5f);
-
-    float xL, yL, xR, yR, xT, yT, xC, yC;
-    Camera_WorldToView(camera, pointC, &xC, &yC);
-    Camera_WorldToView(camera, pointL, &xL, &yL);
-    Camera_WorldToView(camera, pointR, &xR, &yR);
-    Camera_WorldToView(camera, pointTL, &xT, &yT);
-
-    float length = Vec2_Length(Vec2_Set(xR - xL, yR - yL));
-    float width = Vec2_Length(Vec2_Set(xT - xL, yT - yL)) * 2.0f;
-    float angle = atan2f(yR - yL, xR - xL) * 180.0f / (float)M_PI;
-
-    SDL_FRect dstRect = { 0 };
-    dstRect.x = xC - width / 2.0f;
-    dstRect.y = yC - length / 2.0f;
-    dstRect.w = width;
-    dstRect.h = length;
-
-    SDL_RenderCopyExF(
-        renderer->m_rendererSDL, springTexture, NULL, &dstRect,
-        (double)angle - 90.0, NULL, 0
-    );
-}
+﻿#include "Ball.h"
+#include "Scene.h"
+#include "Kernels.h"
+#include "Islands.h"
+
+int Ball_Connect(Scene *scene, BallId id1, BallId id2, float length)
+{
+    int ball1 = Particles_GetIndex(scene->m_particles, id1);
+    int ball2 = Particles_GetIndex(scene->m_particles, id2);
+
+    if ((ball1 < 0) || (ball2 < 0) || (ball1 == ball2))
+        return EXIT_FAILURE;
+
+    if ((scene->m_links[ball1].springCount >= MAX_EDGES)
+        || (scene->m_links[ball2].springCount >= MAX_EDGES))
+        return EXIT_FAILURE;
+
+    int spring = Springs_Add(
+        scene->m_springs, scene->m_links, ball1, ball2, length, scene->m_springStiffness);
+    if (spring < 0)
+        return EXIT_FAILURE;
+
+    // Les îles des deux balles fusionnent
+    Islands_WakeBall(scene->m_islands, ball1);
+    Islands_WakeBall(scene->m_islands, ball2);
+    Islands_Link(scene->m_islands, ball1, ball2);
+    scene->m_topologyVersion++;
+
+    return EXIT_SUCCESS;
+}
+
+void Ball_RemoveSpring(Scene *scene, int spring)
+{
+    Springs *springs = scene->m_springs;
+    int ball1 = springs->m_ball1[spring];
+    int ball2 = springs->m_ball2[spring];
+
+    Islands_WakeBall(scene->m_islands, ball1);
+    Springs_Remove(springs, scene->m_links, spring);
+
+    // L'île du ressort peut se séparer en deux
+    Islands_Unlink(scene->m_islands, scene, ball1, ball2);
+    scene->m_topologyVersion++;
+}
+
+int Ball_Deconnect(Scene *scene, BallId id1, BallId id2)
+{
+    int ball1 = Particles_GetIndex(scene->m_particles, id1);
+    int ball2 = Particles_GetIndex(scene->m_particles, id2);
+
+    if ((ball1 < 0) || (ball2 < 0))
+        return EXIT_FAILURE;
+
+    // Recherche le ressort liant les deux balles
+    BallLinks *links1 = &scene->m_links[ball1];
+    for (int i = 0; i < links1->springCount; ++i)
+    {
+        int spring = links1->springs[i];
+        if (Springs_GetOther(scene->m_springs, spring, ball1) == ball2)
+        {
+            Ball_RemoveSpring(scene, spring);
+            return EXIT_SUCCESS;
+        }
+    }
+
+    return EXIT_FAILURE;
+}
+
+Vec2 Ball_GetPosition(Scene *scene, BallId ball)
+{
+    return Particles_GetPosition(scene->m_particles, Particles_GetIndex(scene->m_particles, ball));
+}
+
+void Ball_ApplySpringForces(Scene *scene, const int *order, int first, int last)
+{
+    Particles *particles = scene->m_particles;
+    Springs *springs = scene->m_springs;
+
+    Kernels_SpringForces(
+        particles->m_posX, particles->m_posY,
+        springs->m_ball1, springs->m_ball2, springs->m_length, springs->m_stiffness,
+        particles->m_forceX, particles->m_forceY, order, first, last
+    );
+}
+
+void Ball_UpdateVelocity(Scene *scene, int first, int last, float timeStep)
+{
+    Particles *particles = scene->m_particles;
+
+    Kernels_IntegrateVelocity(
+        particles->m_velX, particles->m_velY, particles->m_forceX, particles->m_forceY,
+        particles->m_invMass, particles->m_friction, scene->m_gameMode->gravity, timeStep,
+        first, last
+    );
+}
+
+void Ball_UpdatePosition(Scene *scene, int first, int last, float timeStep)
+{
+    Particles *particles = scene->m_particles;
+
+    Kernels_IntegratePosition(
+        particles->m_posX, particles->m_posY, particles->m_velX, particles->m_velY,
+        scene->m_gameMode->rebond, timeStep, first, last
+    );
+}
+
+float Ball_GetMaxKineticEnergy(Scene *scene, int first, int last)
+{
+    Particles *particles = scene->m_particles;
+    float energy = 0.f;
+
+    for (int i = first; i < last; ++i)
+    {
+        float vx = particles->m_velX[i];
+        float vy = particles->m_velY[i];
+        float e = 0.5f * (vx * vx + vy * vy) / particles->m_invMass[i];
+        if (e > energy)
+            energy = e;
+    }
+
+    return energy;
+}
+
+void Ball_Render(float *posX, float *posY, int count, Scene *scene)
+{
+    Camera *camera = Scene_GetCamera(scene);
+    Textures *textures = scene->m_textures;
+
+    Camera_WorldToViewArray(camera, posX, posY, posX, posY, count);
+
+    // Toutes les balles ont la même taille à l'écran
+    float halfW = fabsf(BALL_RADIUS * camera->m_scaleX);
+    float halfH = fabsf(BALL_RADIUS * camera->m_scaleY);
+
+    SDL_FRect dstRect = { 0 };
+    dstRect.w = 2.0f * halfW;
+    dstRect.h = 2.0f * halfH;
+
+    for (int i = 0; i < count; ++i)
+    {
+        dstRect.x = posX[i] - halfW;
+        dstRect.y = posY[i] - halfH;
+
+        SpriteBatch_AddRect(scene->m_batch, &textures->m_body, &dstRect);
+    }
+}
+
+void Ball_RenderSpring(Vec2 start, Vec2 end, Scene *scene, bool active)
+{
+    Camera *camera = Scene_GetCamera(scene);
+    Textures *textures = scene->m_textures;
+    const Sprite *springSprite =
+        active ? &textures->m_spring : &textures->m_springInactive;
+
+    float shift = 0.1f;
+
+    Vec2 direction = Vec2_Normalize(Vec2_Sub(end, start));
+    Vec2 pointL = Vec2_Add(start, Vec2_Scale(direction, shift));
+    Vec2 pointR = Vec2_Sub(end, Vec2_Scale(direction, shift));
+    Vec2 pointTL = Vec2_Add(pointL, Vec2_Scale(Vec2_Perp(direction), 0.1f));
+
+    SDL_FPoint left, right;
+    float xT, yT;
+    Camera_WorldToView(camera, pointL, &left.x, &left.y);
+    Camera_WorldToView(camera, pointR, &right.x, &right.y);
+    Camera_WorldToView(camera, pointTL, &xT, &yT);
+
+    // Le ressort est un sprite étiré entre ses deux extrémités
+    float halfWidth = Vec2_Length(Vec2_Set(xT - left.x, yT - left.y));
+    SpriteBatch_AddSegment(scene->m_batch, springSprite, left, right, halfWidth);
+}
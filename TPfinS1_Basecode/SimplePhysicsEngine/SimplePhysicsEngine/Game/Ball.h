@@ -1,102 +1,103 @@
-﻿#ifndef _BALL_H_
-#define _BALL_H_
-
-/// @file Ball.h
-/// @defgroup Physics
-/// @{
-
-#include "../Settings.h"
-#include "../Utils/Vector.h"
-
-#define MAX_EDGES 10
-
-typedef struct Scene_s Scene;
-typedef struct Ball_s Ball;
-
-typedef enum SpringFlag_e
-{
-    SPRING_RENDERED = 1 << 0,
-} SpringFlag;
-
-/// @brief Structure représentant un ressort entre une balle et son point d'attache.
-typedef struct Spring_s
-{
-    int flags;
-
-    /// @brief Pointeur vers le point d'attache.
-    Ball *other;
-
-    /// @brief Longueur du ressort au repos.
-    float length;
-} Spring;
-
-/// @brief Structure représentant une balle. Elle peut être liée à d'autres balle avec des ressorts.
-typedef struct Ball_s
-{
-    /// @brief Vecteur position de la balle.
-    Vec2 position;
-
-    /// @brief Vecteur vitesse de la balle.
-    Vec2 velocity;
-
-    /// @brief Masse de la balle (exprimée en kg).
-    float mass;
-
-    /// @brief Coefficient de friction de la balle.
-    float friction;
-
-    /// @brief Nombre de ressorts liant la balle à d'autres balles.
-    int springCount;
-
-    /// @brief Tableau contenant les ressorts attachés à la balle.
-    Spring springs[MAX_EDGES];
-} ball_t;
-
-/// @brief Initialise une balle et permet de définir sa position.
-/// @param[in] position le vecteur position de la balle.
-/// @return La balle initialisée.
-Ball Ball_Set(Scene* scene, Vec2 position);
-
-/// @brief Lie deux balles avec un ressort dont la longueur au repos est spécifiée.
-/// @param[in,out] ball1 la première balle.
-/// @param[in,out] ball2 la seconde balle.
-/// @param[in] length la longueur au repos du ressort.
-/// @return EXIT_SUCCESS ou EXIT_FAILURE.
-int Ball_Connect(Ball *ball1, Ball *ball2, float length);
-
-/// @brief Supprime le ressort liant deux balles.
-/// @param[in,out] ball1 la première balle.
-/// @param[in,out] ball2 la seconde balle.
-/// @return EXIT_SUCCESS ou EXIT_FAILURE.
-int Ball_Deconnect(Ball *ball1, Ball *ball2);
-
-/// @brief Renvoie la position d'une balle dans le référentiel monde.
-/// @param ball la balle.
-/// @return La position de la balle dans le référentiel monde.
-Vec2 Ball_GetPosition(Ball *ball);
-
-/// @brief Met à jour la vitesse d'une balle en fonction des forces qui lui sont appliquées.
-/// @param[in,out] ball la balle à mettre à jour.
-/// @param[in] timeStep le pas de temps.
-void Ball_UpdateVelocity(Scene* scene, Ball *ball, float timeStep);
-
-/// @brief Met à jour la position d'une balle en fonction de sa vitesse.
-/// @param[in,out] ball la balle à mettre à jour.
-/// @param[in] timeStep le pas de temps.
-void Ball_UpdatePosition(Scene* Scene, Ball *ball, float timeStep);
-
-/// @brief Dessine une balle dans la scène.
-/// @param ball la balle à dessiner.
-/// @param scene la scène.
-void Ball_Render(Ball *ball, Scene *scene);
-
-/// @brief Dessine un ressort entre deux points.
-/// @param start position du début dans le référentiel monde.
-/// @param end position de la fin dans le référentiel monde.
-/// @param scene la scène.
-/// @param active booléen indiquant si le ressort est actif (change la texture utilisée).
-void Ball_RenderSpring(Vec2 start, Vec2 end, Scene *scene, bool active);
-
-/// @}
-
+﻿#ifndef _BALL_H_
+#define _BALL_H_
+
+/// @file Ball.h
+/// @defgroup Physics
+/// @{
+
+#include "../Settings.h"
+#include "../Utils/Vector.h"
+#include "Particles.h"
+#include "Springs.h"
+
+typedef struct Scene_s Scene;
+
+/// @brief Masse d'une balle (exprimée en kg).
+#define BALL_MASS 0.5f
+
+/// @brief Rayon d'une balle (exprimé en m).
+#define BALL_RADIUS 0.2f
+
+/// @brief Coefficient de friction d'une balle.
+#define BALL_FRICTION 0.5f
+
+/// @brief Raideur d'un ressort avec l'intégrateur explicite (exprimée en N/m).
+#define SPRING_STIFFNESS 200.0f
+
+/// @brief Lie deux balles avec un ressort dont la longueur au repos est spécifiée.
+/// @param[in,out] scene la scène contenant les balles.
+/// @param[in] ball1 l'identifiant de la première balle.
+/// @param[in] ball2 l'identifiant de la seconde balle.
+/// @param[in] length la longueur au repos du ressort.
+/// @return EXIT_SUCCESS ou EXIT_FAILURE.
+int Ball_Connect(Scene *scene, BallId ball1, BallId ball2, float length);
+
+/// @brief Supprime le ressort liant deux balles.
+/// @param[in,out] scene la scène contenant les balles.
+/// @param[in] ball1 l'identifiant de la première balle.
+/// @param[in] ball2 l'identifiant de la seconde balle.
+/// @return EXIT_SUCCESS ou EXIT_FAILURE.
+int Ball_Deconnect(Scene *scene, BallId ball1, BallId ball2);
+
+/// @brief Supprime un ressort de la scène à partir de son indice dans la liste des ressorts.
+/// D'autres ressorts peuvent changer d'indice (voir Springs_Remove()).
+/// @param[in,out] scene la scène contenant le ressort.
+/// @param[in] spring l'indice du ressort.
+void Ball_RemoveSpring(Scene *scene, int spring);
+
+/// @brief Renvoie la position d'une balle dans le référentiel monde.
+/// @param scene la scène contenant la balle.
+/// @param ball l'identifiant de la balle (qui doit être valide).
+/// @return La position de la balle dans le référentiel monde.
+Vec2 Ball_GetPosition(Scene *scene, BallId ball);
+
+/// @brief Calcule la force exercée par les ressorts order[first], ..., order[last - 1] et l'ajoute
+/// aux forces accumulées par leurs deux balles.
+/// Les ressorts d'une même couleur n'ont aucune balle en commun : des intervalles disjoints
+/// d'une même couleur peuvent donc être traités en parallèle.
+/// @param[in,out] scene la scène contenant les ressorts.
+/// @param[in] order les indices des ressorts.
+/// @param[in] first la position du premier ressort dans order.
+/// @param[in] last la position suivant celle du dernier ressort dans order.
+void Ball_ApplySpringForces(Scene *scene, const int *order, int first, int last);
+
+/// @brief Met à jour la vitesse des balles d'indices [first, last[ en fonction des forces
+/// qui leur sont appliquées. Les forces accumulées sont remises à zéro.
+/// @param[in,out] scene la scène contenant les balles.
+/// @param[in] first l'indice de la première balle à mettre à jour.
+/// @param[in] last l'indice suivant la dernière balle à mettre à jour.
+/// @param[in] timeStep le pas de temps.
+void Ball_UpdateVelocity(Scene *scene, int first, int last, float timeStep);
+
+/// @brief Met à jour la position des balles d'indices [first, last[ en fonction de leur vitesse.
+/// @param[in,out] scene la scène contenant les balles.
+/// @param[in] first l'indice de la première balle à mettre à jour.
+/// @param[in] last l'indice suivant la dernière balle à mettre à jour.
+/// @param[in] timeStep le pas de temps.
+void Ball_UpdatePosition(Scene *scene, int first, int last, float timeStep);
+
+/// @brief Renvoie la plus grande énergie cinétique des balles d'indices [first, last[.
+/// @param[in] scene la scène contenant les balles.
+/// @param[in] first l'indice de la première balle.
+/// @param[in] last l'indice suivant la dernière balle.
+/// @return L'énergie cinétique maximale (exprimée en J).
+float Ball_GetMaxKineticEnergy(Scene *scene, int first, int last);
+
+/// @brief Dessine des balles dans la scène.
+/// Les positions sont transformées sur place vers le référentiel caméra, en une seule passe.
+/// @param posX, posY les positions des balles dans le référentiel monde
+/// (remplacées par leurs positions dans le référentiel caméra).
+/// @param count le nombre de balles.
+/// @param scene la scène.
+void Ball_Render(float *posX, float *posY, int count, Scene *scene);
+
+/// @brief Dessine un ressort entre deux points.
+/// @param start position du début dans le référentiel monde.
+/// @param end position de la fin dans le référentiel monde.
+/// @param scene la scène.
+/// @param active booléen indiquant si le ressort est actif (change la texture utilisée).
+void Ball_RenderSpring(Vec2 start, Vec2 end, Scene *scene, bool active);
+
+/// @}
+
 #endif
\ No newline at end of file
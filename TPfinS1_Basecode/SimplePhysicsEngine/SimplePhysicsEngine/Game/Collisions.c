@@ -0,0 +1,313 @@
+﻿#include "Collisions.h"
+#include "Scene.h"
+#include "Grid.h"
+#include "Islands.h"
+#include "../Utils/Tools.h"
+
+/// @brief Nombre minimal de balles traitées par un thread.
+#define COLLISIONS_BATCH 512
+
+Collisions *Collisions_New()
+{
+    Collisions *collisions = NULL;
+
+    collisions = (Collisions *)calloc(1, sizeof(Collisions));
+    if (!collisions) goto ERROR_LABEL;
+
+    collisions->m_awakeGrid = Grid_New(2.f * BALL_RADIUS);
+    if (!collisions->m_awakeGrid) goto ERROR_LABEL;
+
+    collisions->m_sleepingGrid = Grid_New(2.f * BALL_RADIUS);
+    if (!collisions->m_sleepingGrid) goto ERROR_LABEL;
+
+    collisions->m_restitution = COLLISIONS_RESTITUTION;
+    collisions->m_sleepingDirty = true;
+
+    return collisions;
+
+ERROR_LABEL:
+    printf("ERROR - Collisions_New()\n");
+    assert(false);
+    Collisions_Free(collisions);
+    return NULL;
+}
+
+void Collisions_Free(Collisions *collisions)
+{
+    if (!collisions) return;
+
+    Grid_Free(collisions->m_awakeGrid);
+    Grid_Free(collisions->m_sleepingGrid);
+
+    free(collisions->m_awakeBalls);
+    free(collisions->m_awakeX);
+    free(collisions->m_awakeY);
+    free(collisions->m_sleepingBalls);
+    free(collisions->m_sleepingX);
+    free(collisions->m_sleepingY);
+    free(collisions->m_deltaX);
+    free(collisions->m_deltaY);
+    free(collisions->m_deltaVX);
+    free(collisions->m_deltaVY);
+    free(collisions->m_wakeBall);
+
+    memset(collisions, 0, sizeof(Collisions));
+    free(collisions);
+}
+
+/// @brief Augmente la capacité du solveur.
+static int Collisions_Reserve(Collisions *collisions, int capacity)
+{
+    if (capacity <= collisions->m_capacity)
+        return EXIT_SUCCESS;
+
+    int exitStatus = EXIT_SUCCESS;
+    exitStatus |= Tools_Realloc((void **)&collisions->m_awakeBalls, capacity, sizeof(int));
+    exitStatus |= Tools_Realloc((void **)&collisions->m_awakeX, capacity, sizeof(float));
+    exitStatus |= Tools_Realloc((void **)&collisions->m_awakeY, capacity, sizeof(float));
+    exitStatus |= Tools_Realloc((void **)&collisions->m_sleepingBalls, capacity, sizeof(int));
+    exitStatus |= Tools_Realloc((void **)&collisions->m_sleepingX, capacity, sizeof(float));
+    exitStatus |= Tools_Realloc((void **)&collisions->m_sleepingY, capacity, sizeof(float));
+    exitStatus |= Tools_Realloc((void **)&collisions->m_deltaX, capacity, sizeof(float));
+    exitStatus |= Tools_Realloc((void **)&collisions->m_deltaY, capacity, sizeof(float));
+    exitStatus |= Tools_Realloc((void **)&collisions->m_deltaVX, capacity, sizeof(float));
+    exitStatus |= Tools_Realloc((void **)&collisions->m_deltaVY, capacity, sizeof(float));
+    exitStatus |= Tools_Realloc((void **)&collisions->m_wakeBall, capacity, sizeof(int));
+    if (exitStatus != EXIT_SUCCESS) goto ERROR_LABEL;
+
+    collisions->m_capacity = capacity;
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - Collisions_Reserve()\n");
+    return EXIT_FAILURE;
+}
+
+/// @brief Corrections accumulées pour une balle éveillée.
+typedef struct CollisionsContact_s
+{
+    float dx, dy, dvx, dvy;
+
+    /// @brief Balle endormie heurtée (-1 si aucune).
+    int wakeBall;
+} CollisionsContact;
+
+/// @brief Accumule les corrections de la balle i dues aux balles d'une grille situées dans
+/// les neuf cellules entourant la cellule (cellX, cellY).
+/// @param[in] balls les indices des balles de la grille dans la scène.
+/// @param[in] sleeping indique si les balles de la grille sont endormies.
+static void Collisions_AddContacts(
+    Collisions *collisions, Particles *particles, Grid *grid, const int *balls, bool sleeping,
+    int i, int cellX, int cellY, CollisionsContact *contact)
+{
+    const float diameter = 2.f * BALL_RADIUS;
+    const float restitution = collisions->m_restitution;
+    float xi = particles->m_posX[i];
+    float yi = particles->m_posY[i];
+    float wi = particles->m_invMass[i];
+
+    if (grid->m_count == 0)
+        return;
+
+    for (int cy = cellY - 1; cy <= cellY + 1; ++cy)
+    {
+        for (int cx = cellX - 1; cx <= cellX + 1; ++cx)
+        {
+            int bucket = Grid_GetBucket(grid, cx, cy);
+            for (int k = grid->m_cellStart[bucket]; k < grid->m_cellStart[bucket + 1]; ++k)
+            {
+                int slot = grid->m_balls[k];
+                int j = balls[slot];
+
+                // Ignore les balles d'autres cellules partageant la même case
+                if ((j == i) || (grid->m_ballCellX[slot] != cx) || (grid->m_ballCellY[slot] != cy))
+                    continue;
+
+                float nx = xi - particles->m_posX[j];
+                float ny = yi - particles->m_posY[j];
+                float distance2 = nx * nx + ny * ny;
+                if ((distance2 >= diameter * diameter) || (distance2 <= 0.f))
+                    continue;
+
+                float distance = sqrtf(distance2);
+                nx /= distance;
+                ny /= distance;
+
+                // Part de la correction supportée par la balle i.
+                // Une balle posée sur le sol ne peut pas s'enfoncer et une balle endormie
+                // ne bouge pas pendant ce pas : l'autre balle supporte toute la correction.
+                float share = wi / (wi + particles->m_invMass[j]);
+                if (sleeping || ((particles->m_posY[j] <= 0.f) && (ny > 0.f)))
+                    share = 1.f;
+
+                // Sépare les deux balles
+                float overlap = diameter - distance;
+                contact->dx += share * overlap * nx;
+                contact->dy += share * overlap * ny;
+
+                // Supprime la vitesse relative d'approche (choc partiellement élastique)
+                float vn = (particles->m_velX[i] - particles->m_velX[j]) * nx
+                         + (particles->m_velY[i] - particles->m_velY[j]) * ny;
+
+                // Seul un choc réveille une île endormie : une balle qui repose simplement
+                // sur elle est soutenue sans la réveiller
+                if (sleeping && (contact->wakeBall < 0)
+                    && ((vn < -COLLISIONS_WAKE_SPEED) || (overlap > COLLISIONS_WAKE_OVERLAP)))
+                    contact->wakeBall = j;
+
+                if (vn < 0.f)
+                {
+                    float impulse = -(1.f + restitution) * vn * share;
+                    contact->dvx += impulse * nx;
+                    contact->dvy += impulse * ny;
+                }
+            }
+        }
+    }
+}
+
+/// @brief Calcule la correction de chaque balle éveillée à partir des balles (éveillées puis
+/// endormies) des neuf cellules voisines.
+static void Collisions_ContactTask(void *data, int first, int last)
+{
+    Scene *scene = (Scene *)data;
+    Collisions *collisions = scene->m_collisions;
+    Particles *particles = scene->m_particles;
+    Grid *awakeGrid = collisions->m_awakeGrid;
+
+    for (int slot = first; slot < last; ++slot)
+    {
+        int i = collisions->m_awakeBalls[slot];
+        int cellX = awakeGrid->m_ballCellX[slot];
+        int cellY = awakeGrid->m_ballCellY[slot];
+        CollisionsContact contact = { 0.f, 0.f, 0.f, 0.f, -1 };
+
+        Collisions_AddContacts(
+            collisions, particles, awakeGrid, collisions->m_awakeBalls, false,
+            i, cellX, cellY, &contact);
+        Collisions_AddContacts(
+            collisions, particles, collisions->m_sleepingGrid, collisions->m_sleepingBalls, true,
+            i, cellX, cellY, &contact);
+
+        collisions->m_deltaX[slot] = contact.dx;
+        collisions->m_deltaY[slot] = contact.dy;
+        collisions->m_deltaVX[slot] = contact.dvx;
+        collisions->m_deltaVY[slot] = contact.dvy;
+        collisions->m_wakeBall[slot] = contact.wakeBall;
+    }
+}
+
+/// @brief Applique les corrections des balles éveillées.
+static void Collisions_ApplyTask(void *data, int first, int last)
+{
+    Scene *scene = (Scene *)data;
+    Collisions *collisions = scene->m_collisions;
+    Particles *particles = scene->m_particles;
+
+    for (int slot = first; slot < last; ++slot)
+    {
+        int i = collisions->m_awakeBalls[slot];
+        float posY = particles->m_posY[i];
+
+        // Une balle au-dessus du sol ne doit pas être poussée sous le sol
+        particles->m_posX[i] += collisions->m_deltaX[slot];
+        particles->m_posY[i] = fmaxf(posY + collisions->m_deltaY[slot], fminf(posY, 0.f));
+        particles->m_velX[i] += collisions->m_deltaVX[slot];
+        particles->m_velY[i] += collisions->m_deltaVY[slot];
+    }
+}
+
+/// @brief Rassemble les indices et les positions des balles des îles endormies (sleeping)
+/// ou éveillées.
+static int Collisions_Gather(
+    Islands *islands, Particles *particles, bool sleeping, int *balls, float *posX, float *posY)
+{
+    int count = 0;
+
+    if (sleeping)
+    {
+        for (int island = 0; island < islands->m_islandCount; ++island)
+        {
+            if (!islands->m_sleeping[island])
+                continue;
+
+            for (int i = islands->m_ballStart[island]; i < islands->m_ballStart[island + 1]; ++i)
+            {
+                balls[count] = i;
+                posX[count] = particles->m_posX[i];
+                posY[count] = particles->m_posY[i];
+                count++;
+            }
+        }
+        return count;
+    }
+
+    for (int k = 0; k < islands->m_awakeCount; ++k)
+    {
+        int island = islands->m_awake[k];
+        for (int i = islands->m_ballStart[island]; i < islands->m_ballStart[island + 1]; ++i)
+        {
+            balls[count] = i;
+            posX[count] = particles->m_posX[i];
+            posY[count] = particles->m_posY[i];
+            count++;
+        }
+    }
+    return count;
+}
+
+int Collisions_Solve(Collisions *collisions, Scene *scene, ThreadPool *pool)
+{
+    Particles *particles = scene->m_particles;
+    Islands *islands = scene->m_islands;
+
+    int exitStatus = Collisions_Reserve(collisions, Scene_GetBallCount(scene));
+    if (exitStatus == EXIT_FAILURE) goto ERROR_LABEL;
+
+    // Phase large : les balles endormies ne bougent pas, leur grille n'est reconstruite que
+    // lorsque des îles s'endorment ou se réveillent, ou que les balles sont réordonnées
+    if (collisions->m_sleepingDirty || (collisions->m_sleepVersion != islands->m_sleepVersion))
+    {
+        collisions->m_sleepingCount = Collisions_Gather(
+            islands, particles, true,
+            collisions->m_sleepingBalls, collisions->m_sleepingX, collisions->m_sleepingY);
+
+        exitStatus = Grid_Build(
+            collisions->m_sleepingGrid, collisions->m_sleepingX, collisions->m_sleepingY,
+            collisions->m_sleepingCount);
+        if (exitStatus == EXIT_FAILURE) goto ERROR_LABEL;
+
+        collisions->m_sleepVersion = islands->m_sleepVersion;
+        collisions->m_sleepingDirty = false;
+    }
+
+    // Les balles éveillées sont indexées à chaque pas de temps, en O(balles éveillées)
+    int awakeCount = Collisions_Gather(
+        islands, particles, false,
+        collisions->m_awakeBalls, collisions->m_awakeX, collisions->m_awakeY);
+    collisions->m_awakeCount = awakeCount;
+
+    exitStatus = Grid_Build(
+        collisions->m_awakeGrid, collisions->m_awakeX, collisions->m_awakeY, awakeCount);
+    if (exitStatus == EXIT_FAILURE) goto ERROR_LABEL;
+
+    // Phase étroite : chaque balle éveillée ne modifie que sa propre correction
+    ThreadPool_ParallelFor(pool, awakeCount, COLLISIONS_BATCH, Collisions_ContactTask, scene);
+    ThreadPool_ParallelFor(pool, awakeCount, COLLISIONS_BATCH, Collisions_ApplyTask, scene);
+
+    // Réveille les îles endormies heurtées
+    for (int slot = 0; slot < awakeCount; ++slot)
+    {
+        if (collisions->m_wakeBall[slot] >= 0)
+            Islands_WakeBall(islands, collisions->m_wakeBall[slot]);
+    }
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - Collisions_Solve()\n");
+    // La grille des balles endormies devra être reconstruite
+    collisions->m_sleepingDirty = true;
+    return EXIT_FAILURE;
+}
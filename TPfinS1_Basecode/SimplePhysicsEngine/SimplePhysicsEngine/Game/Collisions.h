@@ -0,0 +1,100 @@
+﻿#ifndef _COLLISIONS_H_
+#define _COLLISIONS_H_
+
+/// @file collisions.h
+/// @defgroup Physics
+/// @{
+
+#include "../Settings.h"
+#include "../Utils/ThreadPool.h"
+#include "Grid.h"
+
+typedef struct Scene_s Scene;
+
+/// @brief Coefficient de restitution lors d'un choc entre deux balles.
+#define COLLISIONS_RESTITUTION 0.5f
+
+/// @brief Vitesse d'approche (exprimée en m/s) au-delà de laquelle une balle éveillée réveille
+/// la balle endormie qu'elle touche. Une balle posée sur une île endormie s'en approche de
+/// g * dt à chaque pas de temps (environ 0.1 m/s) : un simple appui ne doit pas la réveiller.
+#define COLLISIONS_WAKE_SPEED 0.5f
+
+/// @brief Recouvrement (exprimé en m) au-delà duquel une balle éveillée réveille la balle
+/// endormie qu'elle touche, même si elle s'en approche lentement (balle déplacée à la souris).
+/// Avec XPBD, deux balles au repos l'une sur l'autre se recouvrent déjà d'environ 0.1 m.
+#define COLLISIONS_WAKE_OVERLAP 0.2f
+
+/// @brief Résolution des collisions entre balles.
+/// Seules les balles des îles éveillées sont parcourues. Elles sont indexées à chaque pas de
+/// temps dans une grille uniforme (dont les cellules ont pour côté le diamètre d'une balle) ;
+/// les balles endormies, immobiles, sont indexées dans une seconde grille reconstruite
+/// seulement lorsque l'ensemble des balles endormies change (voir Islands::m_sleepVersion).
+/// Une scène dont presque toutes les balles dorment ne coûte donc que ses balles éveillées.
+/// Chaque balle éveillée calcule indépendamment sa propre correction à partir de ses voisines
+/// (méthode de Jacobi) : les balles peuvent être réparties entre les threads et le résultat
+/// ne dépend pas du nombre de threads.
+typedef struct Collisions_s
+{
+    /// @brief Indices et positions des balles éveillées (reconstruits à chaque pas de temps).
+    int *m_awakeBalls;
+    float *m_awakeX, *m_awakeY;
+
+    /// @brief Nombre de balles éveillées.
+    int m_awakeCount;
+
+    /// @brief Grille indexant les balles éveillées (indices dans m_awakeBalls).
+    Grid *m_awakeGrid;
+
+    /// @brief Indices et positions des balles endormies.
+    int *m_sleepingBalls;
+    float *m_sleepingX, *m_sleepingY;
+
+    /// @brief Nombre de balles endormies.
+    int m_sleepingCount;
+
+    /// @brief Grille indexant les balles endormies (indices dans m_sleepingBalls).
+    Grid *m_sleepingGrid;
+
+    /// @brief Version de l'ensemble des balles endormies indexées par m_sleepingGrid.
+    Uint32 m_sleepVersion;
+
+    /// @brief Indique que m_sleepingGrid doit être reconstruite.
+    bool m_sleepingDirty;
+
+    /// @brief Corrections de position de chaque balle éveillée.
+    float *m_deltaX, *m_deltaY;
+
+    /// @brief Corrections de vitesse de chaque balle éveillée.
+    float *m_deltaVX, *m_deltaVY;
+
+    /// @brief Pour chaque balle éveillée, une balle endormie qu'elle touche et dont l'île doit
+    /// être réveillée (-1 si aucune).
+    int *m_wakeBall;
+
+    /// @brief Coefficient de restitution.
+    float m_restitution;
+
+    /// @brief Nombre maximal de balles avant d'effectuer une réallocation mémoire.
+    int m_capacity;
+} Collisions;
+
+/// @brief Crée le solveur de collisions.
+/// @return Le solveur créé ou NULL en cas d'erreur.
+Collisions *Collisions_New();
+
+/// @brief Détruit un solveur préalablement alloué avec Collisions_New().
+/// @param[in,out] collisions le solveur à détruire.
+void Collisions_Free(Collisions *collisions);
+
+/// @brief Sépare les balles éveillées qui se chevauchent.
+/// Les balles endormies ne sont jamais corrigées : une balle éveillée qui en touche une
+/// supporte toute la correction et réveille son île, simulée à partir du pas suivant.
+/// @param[in,out] collisions le solveur.
+/// @param[in,out] scene la scène.
+/// @param[in] pool les threads sur lesquels répartir les balles (ou NULL).
+/// @return EXIT_SUCCESS ou EXIT_FAILURE.
+int Collisions_Solve(Collisions *collisions, Scene *scene, ThreadPool *pool);
+
+/// @}
+
+#endif
@@ -0,0 +1,392 @@
+﻿#include "Grid.h"
+#include <float.h>
+#include <limits.h>
+
+/// @brief Nombre minimal de cases de la table.
+#define GRID_MIN_TABLE_SIZE 64
+
+Grid *Grid_New(float cellSize)
+{
+    Grid *grid = NULL;
+
+    grid = (Grid *)calloc(1, sizeof(Grid));
+    if (!grid) goto ERROR_LABEL;
+
+    grid->m_cellSize = cellSize;
+    grid->m_invCellSize = 1.f / cellSize;
+
+    return grid;
+
+ERROR_LABEL:
+    printf("ERROR - Grid_New()\n");
+    assert(false);
+    Grid_Free(grid);
+    return NULL;
+}
+
+void Grid_Free(Grid *grid)
+{
+    if (!grid) return;
+
+    free(grid->m_cellStart);
+    free(grid->m_balls);
+    free(grid->m_ballCellX);
+    free(grid->m_ballCellY);
+
+    memset(grid, 0, sizeof(Grid));
+    free(grid);
+}
+
+/// @brief Augmente la capacité de la grille.
+static int Grid_Reserve(Grid *grid, int capacity, int tableSize)
+{
+    if (capacity > grid->m_capacity)
+    {
+        int *newBalls = (int *)realloc(grid->m_balls, capacity * sizeof(int));
+        if (!newBalls) goto ERROR_LABEL;
+        grid->m_balls = newBalls;
+
+        int *newCellX = (int *)realloc(grid->m_ballCellX, capacity * sizeof(int));
+        if (!newCellX) goto ERROR_LABEL;
+        grid->m_ballCellX = newCellX;
+
+        int *newCellY = (int *)realloc(grid->m_ballCellY, capacity * sizeof(int));
+        if (!newCellY) goto ERROR_LABEL;
+        grid->m_ballCellY = newCellY;
+
+        grid->m_capacity = capacity;
+    }
+
+    if (tableSize > grid->m_tableCapacity)
+    {
+        int *newStart = (int *)realloc(grid->m_cellStart, (tableSize + 1) * sizeof(int));
+        if (!newStart) goto ERROR_LABEL;
+        grid->m_cellStart = newStart;
+
+        grid->m_tableCapacity = tableSize;
+    }
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - Grid_Reserve()\n");
+    return EXIT_FAILURE;
+}
+
+int Grid_Build(Grid *grid, const float *posX, const float *posY, int count)
+{
+    // Au moins deux cases par balle pour limiter les collisions de la fonction de hachage
+    int tableSize = GRID_MIN_TABLE_SIZE;
+    while (tableSize < 2 * count)
+        tableSize <<= 1;
+
+    int exitStatus = Grid_Reserve(grid, count, tableSize);
+    if (exitStatus == EXIT_FAILURE) return EXIT_FAILURE;
+
+    int *cellStart = grid->m_cellStart;
+    grid->m_tableSize = tableSize;
+    grid->m_count = count;
+
+    grid->m_minCellX = grid->m_minCellY = INT_MAX;
+    grid->m_maxCellX = grid->m_maxCellY = INT_MIN;
+
+    // Compte les balles de chaque case
+    memset(cellStart, 0, (tableSize + 1) * sizeof(int));
+    for (int i = 0; i < count; ++i)
+    {
+        int cx = Grid_GetCellCoord(grid, posX[i]);
+        int cy = Grid_GetCellCoord(grid, posY[i]);
+        grid->m_ballCellX[i] = cx;
+        grid->m_ballCellY[i] = cy;
+        cellStart[Grid_GetBucket(grid, cx, cy)]++;
+
+        grid->m_minCellX = SDL_min(grid->m_minCellX, cx);
+        grid->m_maxCellX = SDL_max(grid->m_maxCellX, cx);
+        grid->m_minCellY = SDL_min(grid->m_minCellY, cy);
+        grid->m_maxCellY = SDL_max(grid->m_maxCellY, cy);
+    }
+
+    // cellStart[b] devient la fin de la case b
+    for (int b = 1; b < tableSize; ++b)
+    {
+        cellStart[b] += cellStart[b - 1];
+    }
+    cellStart[tableSize] = count;
+
+    // Range les balles en partant de la fin : cellStart[b] devient le début de la case b
+    // et les balles d'une même case restent triées par indice
+    for (int i = count - 1; i >= 0; --i)
+    {
+        int bucket = Grid_GetBucket(grid, grid->m_ballCellX[i], grid->m_ballCellY[i]);
+        grid->m_balls[--cellStart[bucket]] = i;
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/// @brief Tas max borné contenant les meilleurs candidats d'une recherche.
+/// La racine est le candidat le plus éloigné (à distance égale, celui d'indice le plus grand).
+typedef struct GridHeap_s
+{
+    /// @brief Indices des candidats.
+    int *m_indices;
+
+    /// @brief Carrés des distances des candidats.
+    float *m_distances;
+
+    /// @brief Nombre de candidats.
+    int m_count;
+
+    /// @brief Nombre maximal de candidats.
+    int m_capacity;
+} GridHeap;
+
+/// @brief Indique si le candidat a est plus éloigné que le candidat b.
+static bool GridHeap_IsFarther(GridHeap *heap, int a, int b)
+{
+    if (heap->m_distances[a] != heap->m_distances[b])
+        return heap->m_distances[a] > heap->m_distances[b];
+    return heap->m_indices[a] > heap->m_indices[b];
+}
+
+/// @brief Echange deux candidats du tas.
+static void GridHeap_Swap(GridHeap *heap, int a, int b)
+{
+    int index = heap->m_indices[a];
+    heap->m_indices[a] = heap->m_indices[b];
+    heap->m_indices[b] = index;
+
+    float distance = heap->m_distances[a];
+    heap->m_distances[a] = heap->m_distances[b];
+    heap->m_distances[b] = distance;
+}
+
+/// @brief Fait descendre un candidat dans les count premières cases du tas.
+static void GridHeap_SiftDown(GridHeap *heap, int node, int count)
+{
+    while (true)
+    {
+        int child = 2 * node + 1;
+        if (child >= count)
+            return;
+
+        if ((child + 1 < count) && GridHeap_IsFarther(heap, child + 1, child))
+            child++;
+
+        if (!GridHeap_IsFarther(heap, child, node))
+            return;
+
+        GridHeap_Swap(heap, child, node);
+        node = child;
+    }
+}
+
+/// @brief Propose un candidat : il est conservé s'il fait partie des plus proches.
+static void GridHeap_Push(GridHeap *heap, int index, float distance2)
+{
+    if (heap->m_count < heap->m_capacity)
+    {
+        // Ajoute le candidat puis le fait remonter
+        int node = heap->m_count++;
+        heap->m_indices[node] = index;
+        heap->m_distances[node] = distance2;
+
+        while (node > 0)
+        {
+            int parent = (node - 1) / 2;
+            if (!GridHeap_IsFarther(heap, node, parent))
+                break;
+
+            GridHeap_Swap(heap, node, parent);
+            node = parent;
+        }
+        return;
+    }
+
+    // Remplace le candidat le plus éloigné
+    float worst = heap->m_distances[0];
+    if ((distance2 > worst) || ((distance2 == worst) && (index > heap->m_indices[0])))
+        return;
+
+    heap->m_indices[0] = index;
+    heap->m_distances[0] = distance2;
+    GridHeap_SiftDown(heap, 0, heap->m_count);
+}
+
+/// @brief Propose les balles d'une cellule.
+static void Grid_PushCell(
+    Grid *grid, const float *posX, const float *posY, float x, float y,
+    float maxDistance2, int cx, int cy, GridHeap *heap)
+{
+    int bucket = Grid_GetBucket(grid, cx, cy);
+    for (int k = grid->m_cellStart[bucket]; k < grid->m_cellStart[bucket + 1]; ++k)
+    {
+        int i = grid->m_balls[k];
+
+        // Ignore les balles d'autres cellules partageant la même case
+        if ((grid->m_ballCellX[i] != cx) || (grid->m_ballCellY[i] != cy))
+            continue;
+
+        float dx = posX[i] - x;
+        float dy = posY[i] - y;
+        float distance2 = dx * dx + dy * dy;
+        if (distance2 < maxDistance2)
+            GridHeap_Push(heap, i, distance2);
+    }
+}
+
+int Grid_FindNearest(
+    Grid *grid, const float *posX, const float *posY, float x, float y,
+    float maxDistance, int k, int *indices, float *distances)
+{
+    GridHeap heap = { .m_indices = indices, .m_distances = distances, .m_count = 0, .m_capacity = k };
+    float maxDistance2 = (maxDistance < sqrtf(FLT_MAX)) ? maxDistance * maxDistance : FLT_MAX;
+
+    if ((k <= 0) || (grid->m_count <= 0))
+        return 0;
+
+    int cx = Grid_GetCellCoord(grid, x);
+    int cy = Grid_GetCellCoord(grid, y);
+
+    // Nombre d'anneaux nécessaires pour couvrir toutes les cellules occupées
+    int ringCount = 0;
+    ringCount = SDL_max(ringCount, cx - grid->m_minCellX);
+    ringCount = SDL_max(ringCount, grid->m_maxCellX - cx);
+    ringCount = SDL_max(ringCount, cy - grid->m_minCellY);
+    ringCount = SDL_max(ringCount, grid->m_maxCellY - cy);
+
+    for (int r = 0; r <= ringCount; ++r)
+    {
+        // Les balles de l'anneau r (et des suivants) sont à une distance au moins égale
+        // à (r - 1) * m_cellSize
+        float ringDistance = (float)SDL_max(r - 1, 0) * grid->m_cellSize;
+        if (ringDistance * ringDistance >= maxDistance2)
+            break;
+
+        if ((heap.m_count == k) && (ringDistance * ringDistance >= heap.m_distances[0]))
+            break;
+
+        if (8 * r > grid->m_count)
+        {
+            // L'anneau contient plus de cellules que la scène ne contient de balles :
+            // il est plus rapide de parcourir toutes les balles
+            heap.m_count = 0;
+            for (int i = 0; i < grid->m_count; ++i)
+            {
+                float dx = posX[i] - x;
+                float dy = posY[i] - y;
+                float distance2 = dx * dx + dy * dy;
+                if (distance2 < maxDistance2)
+                    GridHeap_Push(&heap, i, distance2);
+            }
+            break;
+        }
+
+        if (r == 0)
+        {
+            Grid_PushCell(grid, posX, posY, x, y, maxDistance2, cx, cy, &heap);
+            continue;
+        }
+
+        // Lignes du haut et du bas, puis colonnes de gauche et de droite (sans les coins)
+        int minX = SDL_max(cx - r, grid->m_minCellX);
+        int maxX = SDL_min(cx + r, grid->m_maxCellX);
+        int minY = SDL_max(cy - r + 1, grid->m_minCellY);
+        int maxY = SDL_min(cy + r - 1, grid->m_maxCellY);
+
+        for (int i = minX; i <= maxX; ++i)
+        {
+            if (cy - r >= grid->m_minCellY)
+                Grid_PushCell(grid, posX, posY, x, y, maxDistance2, i, cy - r, &heap);
+            if (cy + r <= grid->m_maxCellY)
+                Grid_PushCell(grid, posX, posY, x, y, maxDistance2, i, cy + r, &heap);
+        }
+        for (int j = minY; j <= maxY; ++j)
+        {
+            if (cx - r >= grid->m_minCellX)
+                Grid_PushCell(grid, posX, posY, x, y, maxDistance2, cx - r, j, &heap);
+            if (cx + r <= grid->m_maxCellX)
+                Grid_PushCell(grid, posX, posY, x, y, maxDistance2, cx + r, j, &heap);
+        }
+    }
+
+    // Tri par tas : le plus éloigné est placé à la fin
+    int count = heap.m_count;
+    for (int last = count - 1; last > 0; --last)
+    {
+        GridHeap_Swap(&heap, 0, last);
+        GridHeap_SiftDown(&heap, 0, last);
+    }
+
+    for (int i = 0; i < count; ++i)
+    {
+        distances[i] = sqrtf(distances[i]);
+    }
+
+    return count;
+}
+
+int Grid_FindInRect(
+    Grid *grid, const float *posX, const float *posY,
+    float minX, float minY, float maxX, float maxY, int *indices)
+{
+    int count = 0;
+
+    if ((grid->m_count <= 0) || (minX > maxX) || (minY > maxY))
+        return 0;
+
+    // Cellules occupées recouvrant le rectangle
+    int minCellX = SDL_max(Grid_GetCellCoord(grid, minX), grid->m_minCellX);
+    int maxCellX = SDL_min(Grid_GetCellCoord(grid, maxX), grid->m_maxCellX);
+    int minCellY = SDL_max(Grid_GetCellCoord(grid, minY), grid->m_minCellY);
+    int maxCellY = SDL_min(Grid_GetCellCoord(grid, maxY), grid->m_maxCellY);
+
+    if ((minCellX > maxCellX) || (minCellY > maxCellY))
+        return 0;
+
+    float cellCount = (float)(maxCellX - minCellX + 1) * (float)(maxCellY - minCellY + 1);
+    if (cellCount > (float)grid->m_count)
+    {
+        // Le rectangle contient plus de cellules que la scène ne contient de balles :
+        // il est plus rapide de parcourir toutes les balles
+        for (int i = 0; i < grid->m_count; ++i)
+        {
+            if ((posX[i] >= minX) && (posX[i] <= maxX) && (posY[i] >= minY) && (posY[i] <= maxY))
+                indices[count++] = i;
+        }
+        return count;
+    }
+
+    for (int cy = minCellY; cy <= maxCellY; ++cy)
+    {
+        for (int cx = minCellX; cx <= maxCellX; ++cx)
+        {
+            int bucket = Grid_GetBucket(grid, cx, cy);
+            for (int k = grid->m_cellStart[bucket]; k < grid->m_cellStart[bucket + 1]; ++k)
+            {
+                int i = grid->m_balls[k];
+
+                // Ignore les balles d'autres cellules partageant la même case
+                if ((grid->m_ballCellX[i] != cx) || (grid->m_ballCellY[i] != cy))
+                    continue;
+
+                // Seules les cellules du bord sont partiellement recouvertes
+                if ((posX[i] >= minX) && (posX[i] <= maxX) && (posY[i] >= minY) && (posY[i] <= maxY))
+                    indices[count++] = i;
+            }
+        }
+    }
+
+    return count;
+}
+
+int Grid_GetCellCoord(Grid *grid, float x)
+{
+    return (int)floorf(x * grid->m_invCellSize);
+}
+
+int Grid_GetBucket(Grid *grid, int cx, int cy)
+{
+    uint32_t hash = ((uint32_t)cx * 73856093u) ^ ((uint32_t)cy * 19349663u);
+    return (int)(hash & (uint32_t)(grid->m_tableSize - 1));
+}
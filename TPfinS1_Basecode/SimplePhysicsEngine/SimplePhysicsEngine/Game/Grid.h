@@ -0,0 +1,119 @@
+﻿#ifndef _GRID_H_
+#define _GRID_H_
+
+/// @file grid.h
+/// @defgroup Physics
+/// @{
+
+#include "../Settings.h"
+
+/// @brief Grille uniforme (table de hachage spatiale) indexant les positions des balles.
+/// Le plan est découpé en cellules carrées ; chaque cellule (cx, cy) est associée à une case
+/// de la table par une fonction de hachage. Les balles sont rangées par case (tri par comptage),
+/// si bien que la grille se reconstruit en O(n) à chaque pas de temps.
+/// Plusieurs cellules pouvant partager une même case, les balles d'une case doivent être
+/// filtrées avec m_ballCellX et m_ballCellY.
+typedef struct Grid_s
+{
+    /// @brief Côté d'une cellule (exprimé en m) et son inverse.
+    float m_cellSize, m_invCellSize;
+
+    /// @brief Indice, dans m_balls, de la première balle de chaque case (m_tableSize + 1 éléments).
+    int *m_cellStart;
+
+    /// @brief Indices des balles rangées par case (par indice croissant dans une même case).
+    int *m_balls;
+
+    /// @brief Coordonnées de la cellule de chaque balle.
+    int *m_ballCellX, *m_ballCellY;
+
+    /// @brief Coordonnées extrêmes des cellules occupées.
+    int m_minCellX, m_maxCellX, m_minCellY, m_maxCellY;
+
+    /// @brief Nombre de balles indexées.
+    int m_count;
+
+    /// @brief Nombre de cases de la table (puissance de deux).
+    int m_tableSize;
+
+    /// @brief Nombre maximal de balles avant d'effectuer une réallocation mémoire.
+    int m_capacity;
+
+    /// @brief Nombre maximal de cases avant d'effectuer une réallocation mémoire.
+    int m_tableCapacity;
+} Grid;
+
+/// @brief Crée une grille vide.
+/// @param[in] cellSize le côté d'une cellule.
+/// @return La grille créée ou NULL en cas d'erreur.
+Grid *Grid_New(float cellSize);
+
+/// @brief Détruit une grille préalablement allouée avec Grid_New().
+/// @param[in,out] grid la grille à détruire.
+void Grid_Free(Grid *grid);
+
+/// @brief Reconstruit la grille à partir des positions de count balles.
+/// @param[in,out] grid la grille.
+/// @param[in] posX les abscisses des balles.
+/// @param[in] posY les ordonnées des balles.
+/// @param[in] count le nombre de balles.
+/// @return EXIT_SUCCESS ou EXIT_FAILURE.
+int Grid_Build(Grid *grid, const float *posX, const float *posY, int count);
+
+/// @brief Recherche les k balles les plus proches d'une position, à une distance strictement
+/// inférieure à maxDistance.
+/// Les cellules sont parcourues par anneaux concentriques autour de la position et les
+/// k meilleurs candidats sont conservés dans un tas max borné : la recherche s'arrête dès
+/// que l'anneau suivant ne peut plus contenir de balle plus proche.
+/// Les tableaux indices et distances servent de tas pendant la recherche ; ils sont ensuite
+/// triés par distance croissante (à distance égale, par indice croissant).
+/// La grille doit avoir été construite avec les positions posX et posY.
+/// @param[in] grid la grille.
+/// @param[in] posX les abscisses des balles.
+/// @param[in] posY les ordonnées des balles.
+/// @param[in] x l'abscisse de la position.
+/// @param[in] y l'ordonnée de la position.
+/// @param[in] maxDistance la distance maximale (FLT_MAX pour une recherche non bornée).
+/// @param[in] k le nombre maximal de balles à rechercher.
+/// @param[out] indices les indices des balles trouvées (au moins k cases).
+/// @param[out] distances les distances des balles trouvées (au moins k cases).
+/// @return Le nombre de balles trouvées (au plus k).
+int Grid_FindNearest(
+    Grid *grid, const float *posX, const float *posY, float x, float y,
+    float maxDistance, int k, int *indices, float *distances);
+
+/// @brief Recherche les balles situées dans un rectangle aligné sur les axes
+/// (bords compris).
+/// Seules les cellules recouvrant le rectangle sont parcourues : les balles éloignées ne sont
+/// jamais lues. Si le rectangle recouvre plus de cellules que la scène ne contient de balles,
+/// toutes les balles sont parcourues.
+/// La grille doit avoir été construite avec les positions posX et posY.
+/// @param[in] grid la grille.
+/// @param[in] posX les abscisses des balles.
+/// @param[in] posY les ordonnées des balles.
+/// @param[in] minX l'abscisse minimale du rectangle.
+/// @param[in] minY l'ordonnée minimale du rectangle.
+/// @param[in] maxX l'abscisse maximale du rectangle.
+/// @param[in] maxY l'ordonnée maximale du rectangle.
+/// @param[out] indices les indices des balles trouvées (au moins m_count cases).
+/// @return Le nombre de balles trouvées.
+int Grid_FindInRect(
+    Grid *grid, const float *posX, const float *posY,
+    float minX, float minY, float maxX, float maxY, int *indices);
+
+/// @brief Renvoie la coordonnée de la cellule contenant une abscisse ou une ordonnée.
+/// @param[in] grid la grille.
+/// @param[in] x l'abscisse ou l'ordonnée.
+/// @return La coordonnée de la cellule.
+int Grid_GetCellCoord(Grid *grid, float x);
+
+/// @brief Renvoie la case de la table associée à une cellule.
+/// @param[in] grid la grille.
+/// @param[in] cx l'abscisse de la cellule.
+/// @param[in] cy l'ordonnée de la cellule.
+/// @return L'indice de la case.
+int Grid_GetBucket(Grid *grid, int cx, int cy);
+
+/// @}
+
+#endif
@@ -0,0 +1,541 @@
+﻿#include "Implicit.h"
+#include "Scene.h"
+#include "Ball.h"
+#include "Islands.h"
+#include "../Utils/Tools.h"
+
+/// @brief Nombre de balles par bloc. Les produits scalaires sont calculés par blocs puis
+/// sommés dans l'ordre des blocs : le résultat ne dépend pas du nombre de threads.
+#define IMPLICIT_BLOCK 512
+
+/// @brief Nombre maximal de blocs d'une petite île (voir ISLAND_SPLIT_SIZE).
+#define IMPLICIT_SMALL_BLOCKS ((ISLAND_SPLIT_SIZE + IMPLICIT_BLOCK - 1) / IMPLICIT_BLOCK)
+
+/// @brief Nombre minimal de ressorts traités par un thread.
+#define IMPLICIT_SPRING_BATCH 1024
+
+/// @brief Une balle qui touche le sol avec une vitesse inférieure à celle acquise en chute libre
+/// pendant ce nombre de pas de temps s'arrête au lieu de rebondir.
+#define IMPLICIT_REST_STEPS 4.f
+
+/// @brief Paramètres de la résolution d'une île partagés par les threads.
+typedef struct ImplicitStep_s
+{
+    ImplicitSolver *solver;
+    Scene *scene;
+    float timeStep;
+
+    /// @brief Balles de l'île : [firstBall, lastBall[.
+    int firstBall, lastBall;
+
+    /// @brief Position, dans m_springOrder, du premier ressort à traiter.
+    int offset;
+
+    /// @brief Coefficients de l'itération en cours du gradient conjugué.
+    float alpha, beta;
+
+    /// @brief Sommes partielles (deux par bloc de balles).
+    double *partials;
+} ImplicitStep;
+
+/// @brief Applique le préconditionneur au résidu d'une balle : z = S D^-1 r, où le filtre S
+/// annule la composante verticale pour une balle en contact avec le sol.
+static inline void Implicit_Precondition(
+    ImplicitSolver *solver, int i, float rx, float ry, float *zx, float *zy)
+{
+    *zx = solver->m_diagXX[i] * rx + solver->m_diagXY[i] * ry;
+    *zy = solver->m_contact[i] ? 0.f : solver->m_diagXY[i] * rx + solver->m_diagYY[i] * ry;
+}
+
+ImplicitSolver *Implicit_New()
+{
+    ImplicitSolver *solver = NULL;
+
+    solver = (ImplicitSolver *)calloc(1, sizeof(ImplicitSolver));
+    if (!solver) goto ERROR_LABEL;
+
+    solver->m_maxIterations = IMPLICIT_MAX_ITERATIONS;
+    solver->m_tolerance = IMPLICIT_TOLERANCE;
+
+    return solver;
+
+ERROR_LABEL:
+    printf("ERROR - Implicit_New()\n");
+    assert(false);
+    Implicit_Free(solver);
+    return NULL;
+}
+
+void Implicit_Free(ImplicitSolver *solver)
+{
+    if (!solver) return;
+
+    free(solver->m_dvX);
+    free(solver->m_dvY);
+    free(solver->m_rX);
+    free(solver->m_rY);
+    free(solver->m_pX);
+    free(solver->m_pY);
+    free(solver->m_apX);
+    free(solver->m_apY);
+    free(solver->m_diagXX);
+    free(solver->m_diagXY);
+    free(solver->m_diagYY);
+    free(solver->m_contact);
+    free(solver->m_kXX);
+    free(solver->m_kXY);
+    free(solver->m_kYY);
+    free(solver->m_partials);
+
+    memset(solver, 0, sizeof(ImplicitSolver));
+    free(solver);
+}
+
+int Implicit_Reserve(ImplicitSolver *solver, Scene *scene)
+{
+    int ballCapacity = scene->m_ballCapacity;
+    int springCapacity = scene->m_springs->m_capacity;
+
+    if (ballCapacity > solver->m_ballCapacity)
+    {
+        int exitStatus = EXIT_SUCCESS;
+        exitStatus |= Tools_Realloc((void **)&solver->m_dvX, ballCapacity, sizeof(float));
+        exitStatus |= Tools_Realloc((void **)&solver->m_dvY, ballCapacity, sizeof(float));
+        exitStatus |= Tools_Realloc((void **)&solver->m_rX, ballCapacity, sizeof(float));
+        exitStatus |= Tools_Realloc((void **)&solver->m_rY, ballCapacity, sizeof(float));
+        exitStatus |= Tools_Realloc((void **)&solver->m_pX, ballCapacity, sizeof(float));
+        exitStatus |= Tools_Realloc((void **)&solver->m_pY, ballCapacity, sizeof(float));
+        exitStatus |= Tools_Realloc((void **)&solver->m_apX, ballCapacity, sizeof(float));
+        exitStatus |= Tools_Realloc((void **)&solver->m_apY, ballCapacity, sizeof(float));
+        exitStatus |= Tools_Realloc((void **)&solver->m_diagXX, ballCapacity, sizeof(float));
+        exitStatus |= Tools_Realloc((void **)&solver->m_diagXY, ballCapacity, sizeof(float));
+        exitStatus |= Tools_Realloc((void **)&solver->m_diagYY, ballCapacity, sizeof(float));
+        if (exitStatus != EXIT_SUCCESS) goto ERROR_LABEL;
+
+        bool *newContact = (bool *)realloc(solver->m_contact, ballCapacity * sizeof(bool));
+        if (!newContact) goto ERROR_LABEL;
+        solver->m_contact = newContact;
+
+        int blockCount = (ballCapacity + IMPLICIT_BLOCK - 1) / IMPLICIT_BLOCK;
+        double *newPartials = (double *)realloc(
+            solver->m_partials, 2 * blockCount * sizeof(double));
+        if (!newPartials) goto ERROR_LABEL;
+        solver->m_partials = newPartials;
+
+        solver->m_ballCapacity = ballCapacity;
+    }
+
+    if (springCapacity > solver->m_springCapacity)
+    {
+        int exitStatus = EXIT_SUCCESS;
+        exitStatus |= Tools_Realloc((void **)&solver->m_kXX, springCapacity, sizeof(float));
+        exitStatus |= Tools_Realloc((void **)&solver->m_kXY, springCapacity, sizeof(float));
+        exitStatus |= Tools_Realloc((void **)&solver->m_kYY, springCapacity, sizeof(float));
+        if (exitStatus != EXIT_SUCCESS) goto ERROR_LABEL;
+
+        solver->m_springCapacity = springCapacity;
+    }
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - Implicit_Reserve()\n");
+    return EXIT_FAILURE;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Passes sur les balles (par blocs) et sur les ressorts (par couleurs)
+
+/// @brief Détermine les balles en contact avec le sol et leur vitesse verticale imposée,
+/// puis initialise le résidu h (-C v + M g) - (M + h C) dv et le bloc diagonal M + h C.
+static void Implicit_InitBallTask(void *data, int first, int last)
+{
+    ImplicitStep *step = (ImplicitStep *)data;
+    ImplicitSolver *solver = step->solver;
+    Particles *particles = step->scene->m_particles;
+    float h = step->timeStep;
+    float gravity = step->scene->m_gameMode->gravity;
+    float rebond = step->scene->m_gameMode->rebond;
+    float restSpeed = IMPLICIT_REST_STEPS * fabsf(gravity) * h;
+
+    for (int block = first; block < last; ++block)
+    {
+        int firstBall = step->firstBall + block * IMPLICIT_BLOCK;
+        int lastBall = SDL_min(firstBall + IMPLICIT_BLOCK, step->lastBall);
+
+        for (int i = firstBall; i < lastBall; ++i)
+        {
+            float mass = 1.f / particles->m_invMass[i];
+            float friction = particles->m_friction[i];
+            float vy = particles->m_velY[i];
+
+            // Une balle qui atteindrait le sol en chute libre pendant le pas de temps
+            // est en contact : les ressorts ne peuvent pas l'enfoncer. Elle rebondit si elle
+            // arrive assez vite, sinon elle s'arrête (la pesanteur seule ne la fait pas rebondir)
+            bool contact = particles->m_posY[i] + (vy + gravity * h) * h <= 0.f;
+            float dvY = 0.f;
+            if (contact && (vy < 0.f))
+                dvY = (vy < -restSpeed) ? (rebond - 1.f) * vy : -vy;
+
+            solver->m_contact[i] = contact;
+            solver->m_rX[i] = -h * friction * particles->m_velX[i];
+            solver->m_rY[i] = h * (-friction * vy + mass * gravity) - (mass + h * friction) * dvY;
+            solver->m_diagXX[i] = mass + h * friction;
+            solver->m_diagXY[i] = 0.f;
+            solver->m_diagYY[i] = mass + h * friction;
+            solver->m_dvX[i] = 0.f;
+            solver->m_dvY[i] = dvY;
+            solver->m_pX[i] = 0.f;
+            solver->m_pY[i] = 0.f;
+        }
+    }
+}
+
+/// @brief Calcule la jacobienne de chaque ressort et ajoute sa contribution
+/// h f + h^2 df/dx (v + dv) au résidu et h^2 df/dx au bloc diagonal.
+static void Implicit_InitSpringTask(void *data, int first, int last)
+{
+    ImplicitStep *step = (ImplicitStep *)data;
+    ImplicitSolver *solver = step->solver;
+    Particles *particles = step->scene->m_particles;
+    Springs *springs = step->scene->m_springs;
+    const int *order = step->scene->m_islands->m_springOrder;
+    float h = step->timeStep;
+    float h2 = h * h;
+
+    for (int k = step->offset + first; k < step->offset + last; ++k)
+    {
+        int spring = order[k];
+        int b1 = springs->m_ball1[spring];
+        int b2 = springs->m_ball2[spring];
+        float dx = particles->m_posX[b2] - particles->m_posX[b1];
+        float dy = particles->m_posY[b2] - particles->m_posY[b1];
+        float distance = sqrtf(dx * dx + dy * dy);
+
+        solver->m_kXX[spring] = 0.f;
+        solver->m_kXY[spring] = 0.f;
+        solver->m_kYY[spring] = 0.f;
+        if (distance <= 0.f)
+            continue;
+
+        // Jacobienne K = k (u u^T + s (I - u u^T)) avec s = 1 - L/d, tronqué à 0 pour que K
+        // reste positive (un ressort comprimé n'a pas de raideur transverse)
+        float stiffness = springs->m_stiffness[spring];
+        float length = springs->m_length[spring];
+        float ux = dx / distance;
+        float uy = dy / distance;
+        float s = fmaxf(0.f, 1.f - length / distance);
+        float kXX = stiffness * ((1.f - s) * ux * ux + s);
+        float kXY = stiffness * ((1.f - s) * ux * uy);
+        float kYY = stiffness * ((1.f - s) * uy * uy + s);
+
+        solver->m_kXX[spring] = kXX;
+        solver->m_kXY[spring] = kXY;
+        solver->m_kYY[spring] = kYY;
+
+        // Loi de Hooke (force exercée sur la première balle)
+        float fx = stiffness * (distance - length) * ux;
+        float fy = stiffness * (distance - length) * uy;
+
+        // Variation de la force due au déplacement relatif pendant le pas de temps
+        // (dv est non nul pour les balles en contact avec le sol)
+        float vx = particles->m_velX[b2] + solver->m_dvX[b2]
+                 - particles->m_velX[b1] - solver->m_dvX[b1];
+        float vy = particles->m_velY[b2] + solver->m_dvY[b2]
+                 - particles->m_velY[b1] - solver->m_dvY[b1];
+        float bx = h * fx + h2 * (kXX * vx + kXY * vy);
+        float by = h * fy + h2 * (kXY * vx + kYY * vy);
+
+        solver->m_rX[b1] += bx;
+        solver->m_rY[b1] += by;
+        solver->m_rX[b2] -= bx;
+        solver->m_rY[b2] -= by;
+
+        solver->m_diagXX[b1] += h2 * kXX;
+        solver->m_diagXY[b1] += h2 * kXY;
+        solver->m_diagYY[b1] += h2 * kYY;
+        solver->m_diagXX[b2] += h2 * kXX;
+        solver->m_diagXY[b2] += h2 * kXY;
+        solver->m_diagYY[b2] += h2 * kYY;
+    }
+}
+
+/// @brief Inverse les blocs diagonaux (préconditionneur), filtre le résidu
+/// et calcule r.r et r.z.
+static void Implicit_PrecondTask(void *data, int first, int last)
+{
+    ImplicitStep *step = (ImplicitStep *)data;
+    ImplicitSolver *solver = step->solver;
+
+    for (int block = first; block < last; ++block)
+    {
+        int firstBall = step->firstBall + block * IMPLICIT_BLOCK;
+        int lastBall = SDL_min(firstBall + IMPLICIT_BLOCK, step->lastBall);
+        double rr = 0.0, rz = 0.0;
+
+        for (int i = firstBall; i < lastBall; ++i)
+        {
+            float a = solver->m_diagXX[i];
+            float b = solver->m_diagXY[i];
+            float c = solver->m_diagYY[i];
+            float invDet = 1.f / (a * c - b * b);
+
+            solver->m_diagXX[i] = c * invDet;
+            solver->m_diagXY[i] = -b * invDet;
+            solver->m_diagYY[i] = a * invDet;
+
+            float rx = solver->m_rX[i];
+            float ry = solver->m_contact[i] ? 0.f : solver->m_rY[i];
+            float zx, zy;
+            Implicit_Precondition(solver, i, rx, ry, &zx, &zy);
+            solver->m_rY[i] = ry;
+
+            rr += (double)rx * rx + (double)ry * ry;
+            rz += (double)rx * zx + (double)ry * zy;
+        }
+
+        step->partials[2 * block] = rr;
+        step->partials[2 * block + 1] = rz;
+    }
+}
+
+/// @brief Met à jour la direction de descente p = z + beta p et initialise
+/// le produit A p avec la partie diagonale (M + h C) p.
+static void Implicit_DirectionTask(void *data, int first, int last)
+{
+    ImplicitStep *step = (ImplicitStep *)data;
+    ImplicitSolver *solver = step->solver;
+    Particles *particles = step->scene->m_particles;
+    float h = step->timeStep;
+    float beta = step->beta;
+
+    for (int block = first; block < last; ++block)
+    {
+        int firstBall = step->firstBall + block * IMPLICIT_BLOCK;
+        int lastBall = SDL_min(firstBall + IMPLICIT_BLOCK, step->lastBall);
+
+        for (int i = firstBall; i < lastBall; ++i)
+        {
+            float zx, zy;
+            Implicit_Precondition(solver, i, solver->m_rX[i], solver->m_rY[i], &zx, &zy);
+            float px = zx + beta * solver->m_pX[i];
+            float py = zy + beta * solver->m_pY[i];
+            float diagonal = 1.f / particles->m_invMass[i] + h * particles->m_friction[i];
+
+            solver->m_pX[i] = px;
+            solver->m_pY[i] = py;
+            solver->m_apX[i] = diagonal * px;
+            solver->m_apY[i] = diagonal * py;
+        }
+    }
+}
+
+/// @brief Ajoute au produit A p la contribution h^2 K (p1 - p2) des ressorts.
+static void Implicit_ProductSpringTask(void *data, int first, int last)
+{
+    ImplicitStep *step = (ImplicitStep *)data;
+    ImplicitSolver *solver = step->solver;
+    Springs *springs = step->scene->m_springs;
+    const int *order = step->scene->m_islands->m_springOrder;
+    float h2 = step->timeStep * step->timeStep;
+
+    for (int k = step->offset + first; k < step->offset + last; ++k)
+    {
+        int spring = order[k];
+        int b1 = springs->m_ball1[spring];
+        int b2 = springs->m_ball2[spring];
+        float dx = solver->m_pX[b1] - solver->m_pX[b2];
+        float dy = solver->m_pY[b1] - solver->m_pY[b2];
+        float tx = h2 * (solver->m_kXX[spring] * dx + solver->m_kXY[spring] * dy);
+        float ty = h2 * (solver->m_kXY[spring] * dx + solver->m_kYY[spring] * dy);
+
+        solver->m_apX[b1] += tx;
+        solver->m_apY[b1] += ty;
+        solver->m_apX[b2] -= tx;
+        solver->m_apY[b2] -= ty;
+    }
+}
+
+/// @brief Calcule p.(A p).
+static void Implicit_CurvatureTask(void *data, int first, int last)
+{
+    ImplicitStep *step = (ImplicitStep *)data;
+    ImplicitSolver *solver = step->solver;
+
+    for (int block = first; block < last; ++block)
+    {
+        int firstBall = step->firstBall + block * IMPLICIT_BLOCK;
+        int lastBall = SDL_min(firstBall + IMPLICIT_BLOCK, step->lastBall);
+        double pap = 0.0;
+
+        for (int i = firstBall; i < lastBall; ++i)
+        {
+            pap += (double)solver->m_pX[i] * solver->m_apX[i]
+                 + (double)solver->m_pY[i] * solver->m_apY[i];
+        }
+
+        step->partials[2 * block] = pap;
+    }
+}
+
+/// @brief Met à jour l'inconnue et le résidu, puis calcule r.r et r.z.
+static void Implicit_UpdateTask(void *data, int first, int last)
+{
+    ImplicitStep *step = (ImplicitStep *)data;
+    ImplicitSolver *solver = step->solver;
+    float alpha = step->alpha;
+
+    for (int block = first; block < last; ++block)
+    {
+        int firstBall = step->firstBall + block * IMPLICIT_BLOCK;
+        int lastBall = SDL_min(firstBall + IMPLICIT_BLOCK, step->lastBall);
+        double rr = 0.0, rz = 0.0;
+
+        for (int i = firstBall; i < lastBall; ++i)
+        {
+            solver->m_dvX[i] += alpha * solver->m_pX[i];
+            solver->m_dvY[i] += alpha * solver->m_pY[i];
+
+            float rx = solver->m_rX[i] - alpha * solver->m_apX[i];
+            float ry = solver->m_contact[i] ? 0.f : solver->m_rY[i] - alpha * solver->m_apY[i];
+            float zx, zy;
+            Implicit_Precondition(solver, i, rx, ry, &zx, &zy);
+            solver->m_rX[i] = rx;
+            solver->m_rY[i] = ry;
+
+            rr += (double)rx * rx + (double)ry * ry;
+            rz += (double)rx * zx + (double)ry * zy;
+        }
+
+        step->partials[2 * block] = rr;
+        step->partials[2 * block + 1] = rz;
+    }
+}
+
+/// @brief Applique la variation de vitesse, met à jour les positions (avec rebond sur le sol)
+/// et calcule l'énergie cinétique maximale.
+static void Implicit_ApplyTask(void *data, int first, int last)
+{
+    ImplicitStep *step = (ImplicitStep *)data;
+    ImplicitSolver *solver = step->solver;
+    Particles *particles = step->scene->m_particles;
+
+    for (int block = first; block < last; ++block)
+    {
+        int firstBall = step->firstBall + block * IMPLICIT_BLOCK;
+        int lastBall = SDL_min(firstBall + IMPLICIT_BLOCK, step->lastBall);
+
+        for (int i = firstBall; i < lastBall; ++i)
+        {
+            particles->m_velX[i] += solver->m_dvX[i];
+            particles->m_velY[i] += solver->m_dvY[i];
+        }
+
+        Ball_UpdatePosition(step->scene, firstBall, lastBall, step->timeStep);
+        step->partials[2 * block] = Ball_GetMaxKineticEnergy(step->scene, firstBall, lastBall);
+    }
+}
+
+/// @brief Applique une passe à tous les ressorts de l'île.
+/// Les couleurs sont traitées l'une après l'autre, chacune en parallèle.
+static void Implicit_ForSprings(
+    ImplicitStep *step, ThreadPool *pool, int island, ThreadPoolTask task)
+{
+    Islands *islands = step->scene->m_islands;
+
+    if (!pool)
+    {
+        // Les ressorts de l'île sont déjà rangés par couleur
+        step->offset = islands->m_springStart[island];
+        task(step, 0, islands->m_springStart[island + 1] - step->offset);
+        return;
+    }
+
+    for (int color = 0; color < step->scene->m_springs->m_colorCount; ++color)
+    {
+        int first, last;
+        Islands_GetColorRange(islands, step->scene->m_springs, island, color, &first, &last);
+
+        step->offset = first;
+        ThreadPool_ParallelFor(pool, last - first, IMPLICIT_SPRING_BATCH, task, step);
+    }
+}
+
+/// @brief Somme (dans l'ordre des blocs) les sommes partielles d'indice k.
+static double Implicit_Sum(ImplicitStep *step, int blockCount, int k)
+{
+    double sum = 0.0;
+    for (int block = 0; block < blockCount; ++block)
+    {
+        sum += step->partials[2 * block + k];
+    }
+    return sum;
+}
+
+int Implicit_SolveIsland(
+    ImplicitSolver *solver, Scene *scene, int island, float timeStep,
+    ThreadPool *pool, float *energy)
+{
+    Islands *islands = scene->m_islands;
+    double localPartials[2 * IMPLICIT_SMALL_BLOCKS];
+    ImplicitStep step = { 0 };
+
+    step.solver = solver;
+    step.scene = scene;
+    step.timeStep = timeStep;
+    step.firstBall = islands->m_ballStart[island];
+    step.lastBall = islands->m_ballStart[island + 1];
+
+    // Les petites îles sont résolues en même temps par plusieurs threads :
+    // leurs sommes partielles ne sont pas stockées dans l'intégrateur
+    int ballCount = step.lastBall - step.firstBall;
+    int blockCount = (ballCount + IMPLICIT_BLOCK - 1) / IMPLICIT_BLOCK;
+    step.partials = (blockCount <= IMPLICIT_SMALL_BLOCKS) ? localPartials : solver->m_partials;
+
+    // Assemble le second membre et le préconditionneur
+    ThreadPool_ParallelFor(pool, blockCount, 1, Implicit_InitBallTask, &step);
+    Implicit_ForSprings(&step, pool, island, Implicit_InitSpringTask);
+    ThreadPool_ParallelFor(pool, blockCount, 1, Implicit_PrecondTask, &step);
+
+    double bb = Implicit_Sum(&step, blockCount, 0);
+    double rz = Implicit_Sum(&step, blockCount, 1);
+    double tolerance = (double)solver->m_tolerance * solver->m_tolerance * bb;
+    int iterations = 0;
+
+    // Gradient conjugué préconditionné et filtré : la vitesse verticale des balles
+    // en contact avec le sol n'est pas modifiée par les itérations
+    step.beta = 0.f;
+    while ((bb > 0.0) && (iterations < solver->m_maxIterations))
+    {
+        ThreadPool_ParallelFor(pool, blockCount, 1, Implicit_DirectionTask, &step);
+        Implicit_ForSprings(&step, pool, island, Implicit_ProductSpringTask);
+        ThreadPool_ParallelFor(pool, blockCount, 1, Implicit_CurvatureTask, &step);
+
+        double pap = Implicit_Sum(&step, blockCount, 0);
+        if (pap <= 0.0)
+            break;
+
+        step.alpha = (float)(rz / pap);
+        ThreadPool_ParallelFor(pool, blockCount, 1, Implicit_UpdateTask, &step);
+        iterations++;
+
+        double rr = Implicit_Sum(&step, blockCount, 0);
+        double rzNext = Implicit_Sum(&step, blockCount, 1);
+        if ((rr <= tolerance) || (rzNext <= 0.0))
+            break;
+
+        step.beta = (float)(rzNext / rz);
+        rz = rzNext;
+    }
+
+    // Met à jour les vitesses et les positions
+    ThreadPool_ParallelFor(pool, blockCount, 1, Implicit_ApplyTask, &step);
+
+    *energy = 0.f;
+    for (int block = 0; block < blockCount; ++block)
+    {
+        *energy = fmaxf(*energy, (float)step.partials[2 * block]);
+    }
+
+    return iterations;
+}
@@ -0,0 +1,108 @@
+﻿#ifndef _IMPLICIT_H_
+#define _IMPLICIT_H_
+
+/// @file implicit.h
+/// @defgroup Physics
+/// @{
+
+#include "../Settings.h"
+#include "../Utils/ThreadPool.h"
+
+typedef struct Scene_s Scene;
+
+/// @brief Pas de temps utilisé par l'intégrateur implicite (exprimé en s).
+#define IMPLICIT_TIME_STEP (1.0f / 30.f)
+
+/// @brief Raideur d'un ressort avec l'intégrateur implicite (exprimée en N/m).
+/// L'intégrateur explicite diverge avec cette raideur, même avec un pas de temps de 1/100 s.
+#define IMPLICIT_SPRING_STIFFNESS 5000.0f
+
+/// @brief Nombre maximal d'itérations du gradient conjugué par défaut.
+#define IMPLICIT_MAX_ITERATIONS 20
+
+/// @brief Tolérance par défaut du gradient conjugué, relative à la norme du second membre.
+#define IMPLICIT_TOLERANCE 1e-3f
+
+/// @brief Intégrateur d'Euler implicite.
+/// A chaque pas de temps, le système linéarisé
+/// (M + h C - h^2 df/dx) dv = h (f + h df/dx v - C v + M g)
+/// est résolu par un gradient conjugué préconditionné (Jacobi par blocs 2x2), sans jamais
+/// construire la matrice : les produits matrice-vecteur sont calculés ressort par ressort.
+/// Le contact avec le sol fait partie du système : la vitesse verticale d'une balle en contact
+/// est imposée (rebond) et filtrée pendant les itérations.
+/// Chaque île est résolue indépendamment des autres.
+typedef struct ImplicitSolver_s
+{
+    /// @brief Nombre maximal d'itérations du gradient conjugué.
+    int m_maxIterations;
+
+    /// @brief Le gradient conjugué s'arrête lorsque la norme du résidu devient inférieure
+    /// à m_tolerance fois la norme du second membre.
+    float m_tolerance;
+
+    /// @brief Plus grand nombre d'itérations effectuées pour une île au dernier pas de temps.
+    int m_iterations;
+
+    /// @brief Variation de vitesse (inconnue du système) de chaque balle.
+    float *m_dvX, *m_dvY;
+
+    /// @brief Résidu du système pour chaque balle.
+    float *m_rX, *m_rY;
+
+    /// @brief Direction de descente pour chaque balle.
+    float *m_pX, *m_pY;
+
+    /// @brief Produit de la matrice du système par la direction de descente.
+    float *m_apX, *m_apY;
+
+    /// @brief Bloc diagonal de la matrice du système, puis son inverse (préconditionneur).
+    float *m_diagXX, *m_diagXY, *m_diagYY;
+
+    /// @brief Indique pour chaque balle si elle est en contact avec le sol.
+    bool *m_contact;
+
+    /// @brief Jacobienne (matrice 2x2 symétrique) de chaque ressort.
+    float *m_kXX, *m_kXY, *m_kYY;
+
+    /// @brief Sommes partielles des produits scalaires (deux par bloc de balles).
+    double *m_partials;
+
+    /// @brief Nombre maximal de balles avant d'effectuer une réallocation mémoire.
+    int m_ballCapacity;
+
+    /// @brief Nombre maximal de ressorts avant d'effectuer une réallocation mémoire.
+    int m_springCapacity;
+} ImplicitSolver;
+
+/// @brief Crée un intégrateur implicite.
+/// @return L'intégrateur créé ou NULL en cas d'erreur.
+ImplicitSolver *Implicit_New();
+
+/// @brief Détruit un intégrateur préalablement alloué avec Implicit_New().
+/// @param[in,out] solver l'intégrateur à détruire.
+void Implicit_Free(ImplicitSolver *solver);
+
+/// @brief Alloue les tableaux temporaires pour les balles et les ressorts de la scène.
+/// Doit être appelée avant chaque pas de temps.
+/// @param[in,out] solver l'intégrateur.
+/// @param[in] scene la scène.
+/// @return EXIT_SUCCESS ou EXIT_FAILURE.
+int Implicit_Reserve(ImplicitSolver *solver, Scene *scene);
+
+/// @brief Effectue un pas de temps implicite pour une île de la scène.
+/// Plusieurs îles peuvent être résolues simultanément par des threads différents
+/// à condition de passer pool = NULL. Le résultat ne dépend pas du nombre de threads.
+/// @param[in,out] solver l'intégrateur.
+/// @param[in,out] scene la scène.
+/// @param[in] island l'indice de l'île.
+/// @param[in] timeStep le pas de temps.
+/// @param[in] pool les threads sur lesquels répartir l'île (ou NULL).
+/// @param[out] energy l'énergie cinétique maximale d'une balle de l'île après le pas de temps.
+/// @return Le nombre d'itérations du gradient conjugué.
+int Implicit_SolveIsland(
+    ImplicitSolver *solver, Scene *scene, int island, float timeStep,
+    ThreadPool *pool, float *energy);
+
+/// @}
+
+#endif
@@ -1,175 +1,270 @@
-#include "Input.h"
-
-Input *Input_New()
-{
-    Input *input = NULL;
-
-    input = (Input *)calloc(1, sizeof(Input));
-    if (!input) goto ERROR_LABEL;
-
-    return input;
-
-ERROR_LABEL:
-    printf("ERROR - Input_New()\n");
-    assert(false);
-    Input_Free(input);
-    return NULL;
-}
-
-void Input_Free(Input *input)
-{
-    if (!input)
-        return;
-
-    free(input);
-}
-
-void Input_Update(Input *input)
-{
-    SDL_Event evt;
-
-    input->quitPressed = false;
-    input->restartPressed = false;
-    input->mouseLPressed = false;
-    input->mouseRPressed = false;
-
-    int lastMouseX = input->mouseX;
-    int lastMouseY = input->mouseY;
-
-    while (SDL_PollEvent(&evt))
-    {
-        switch (evt.type)
-        {
-        case SDL_QUIT:
-            input->quitPressed = true;
-            break;
-
-        case SDL_KEYDOWN:
-            input->isHit = true;
-            if (evt.key.repeat)
-                break;
-
-            switch (evt.key.keysym.scancode)
-            {
-            case SDL_SCANCODE_ESCAPE:
-                input->quitPressed = true;
-                break;
-
-            case SDL_SCANCODE_RETURN:
-                input->restartPressed = true;
-                break;
-
-            case SDL_SCANCODE_D:
-                input->keyStatus = SDL_SCANCODE_D;
-                break;
-
-            case SDL_SCANCODE_T:
-                input->keyStatus = SDL_SCANCODE_T;
-                break;
-
-            case SDL_SCANCODE_K:
-                input->keyStatus = SDL_SCANCODE_K;
-                break;
-
-            case SDL_SCANCODE_Z:
-                input->keyStatus = SDL_SCANCODE_Z;
-                break;
-
-            case SDL_SCANCODE_H:
-                input->keyStatus = SDL_SCANCODE_H;
-                break;
-            
-            case SDL_SCANCODE_N:
-                input->keyStatus = SDL_SCANCODE_N;
-                break;
-
-            default:
-                break;
-            }
-            break;
-
-        case SDL_KEYUP:
-            input->isHit = false;
-            if (evt.key.repeat)
-                break;
-
-            //useless
-            switch (evt.key.keysym.scancode)
-            {
-                case SDL_SCANCODE_D:
-                    input->keyStatus = SDL_SCANCODE_D;
-                    break;
-
-                case SDL_SCANCODE_T:
-                    input->keyStatus = SDL_SCANCODE_T;
-                    break;
-
-                case SDL_SCANCODE_K:
-                    input->keyStatus = SDL_SCANCODE_K;
-                    break;
-
-                case SDL_SCANCODE_Z:
-                    input->keyStatus = SDL_SCANCODE_Z;
-                    break;
-
-                case SDL_SCANCODE_H:
-                    input->keyStatus = SDL_SCANCODE_H;
-                    break;
-
-                case SDL_SCANCODE_N:
-                    input->keyStatus = SDL_SCANCODE_N;
-                    break;
-
-                default:
-                    break;
-            }
-            break;
-
-        case SDL_MOUSEMOTION:
-            input->mouseX = evt.motion.x;
-            input->mouseY = evt.motion.y;
-            break;
-
-        case SDL_MOUSEBUTTONDOWN:
-            input->isHit = true;
-            switch (evt.button.button)
-            {
-            case SDL_BUTTON_LEFT:
-                input->mouseLDown = true;
-                input->mouseLPressed = true;
-
-                input->keyStatus = SDL_BUTTON_LEFT;
-
-                break;
-            case SDL_BUTTON_RIGHT:
-                input->mouseRDown = true;
-                input->mouseRPressed = true;
-
-                input->keyStatus = SDL_BUTTON_RIGHT;
-
-                break;
-            default:
-                break;
-            }
-            break;
-
-        case SDL_MOUSEBUTTONUP:
-            input->isHit = false;
-            switch (evt.button.button)
-            {
-            case SDL_BUTTON_LEFT:
-                input->mouseLDown = false;
-                break;
-            case SDL_BUTTON_RIGHT:
-                input->mouseRDown = false;
-                break;
-            default:
-                break;
-            }
-            break;
-        }
-    }
-
-    input->mouseDeltaX = input->mouseX - lastMouseX;
-    input->mouseDeltaY = input->mouseY - lastMouseY;
+﻿#include "Input.h"
+
+Input *Input_New()
+{
+    Input *input = NULL;
+
+    input = (Input *)calloc(1, sizeof(Input));
+    if (!input) goto ERROR_LABEL;
+
+    return input;
+
+ERROR_LABEL:
+    printf("ERROR - Input_New()\n");
+    assert(false);
+    Input_Free(input);
+    return NULL;
+}
+
+void Input_Free(Input *input)
+{
+    if (!input)
+        return;
+
+    free(input);
+}
+
+void Input_ClearPresses(Input *input)
+{
+    input->quitPressed = false;
+    input->restartPressed = false;
+    input->tracePressed = false;
+    input->pausePressed = false;
+    input->renderTargetsReset = false;
+    input->mouseLPressed = false;
+    input->mouseRPressed = false;
+    input->hitCount = 0;
+}
+
+void Input_Merge(Input *input, const Input *previous)
+{
+    input->quitPressed = input->quitPressed || previous->quitPressed;
+    input->restartPressed = input->restartPressed || previous->restartPressed;
+    input->tracePressed = input->tracePressed || previous->tracePressed;
+    input->pausePressed = input->pausePressed || previous->pausePressed;
+    input->renderTargetsReset = input->renderTargetsReset || previous->renderTargetsReset;
+    input->mouseLPressed = input->mouseLPressed || previous->mouseLPressed;
+    input->mouseRPressed = input->mouseRPressed || previous->mouseRPressed;
+
+    int hits[INPUT_MAX_HITS];
+    int hitCount = previous->hitCount;
+    memcpy(hits, previous->hits, hitCount * sizeof(int));
+    for (int i = 0; (i < input->hitCount) && (hitCount < INPUT_MAX_HITS); ++i)
+    {
+        hits[hitCount++] = input->hits[i];
+    }
+    memcpy(input->hits, hits, hitCount * sizeof(int));
+    input->hitCount = hitCount;
+}
+
+/// @brief Retient l'appui sur une touche du jeu (ignoré au-delà de INPUT_MAX_HITS).
+static void Input_AddHit(Input *input, int key)
+{
+    if (input->hitCount < INPUT_MAX_HITS)
+        input->hits[input->hitCount++] = key;
+}
+
+void Input_Update(Input *input)
+{
+    SDL_Event evt;
+
+    Input_ClearPresses(input);
+    input->mouseWheel = 0;
+
+    int lastMouseX = input->mouseX;
+    int lastMouseY = input->mouseY;
+
+    while (SDL_PollEvent(&evt))
+    {
+        switch (evt.type)
+        {
+        case SDL_QUIT:
+            input->quitPressed = true;
+            break;
+
+        case SDL_RENDER_TARGETS_RESET:
+            input->renderTargetsReset = true;
+            break;
+
+        case SDL_KEYDOWN:
+            input->isHit = true;
+            if (evt.key.repeat)
+                break;
+
+            switch (evt.key.keysym.scancode)
+            {
+            case SDL_SCANCODE_ESCAPE:
+                input->quitPressed = true;
+                break;
+
+            case SDL_SCANCODE_RETURN:
+                input->restartPressed = true;
+                break;
+
+            case SDL_SCANCODE_P:
+                input->pausePressed = true;
+                break;
+
+            case SDL_SCANCODE_F12:
+                input->tracePressed = true;
+                break;
+
+            case SDL_SCANCODE_D:
+                input->keyStatus = SDL_SCANCODE_D;
+                break;
+
+            case SDL_SCANCODE_T:
+                input->keyStatus = SDL_SCANCODE_T;
+                break;
+
+            case SDL_SCANCODE_K:
+                input->keyStatus = SDL_SCANCODE_K;
+                break;
+
+            case SDL_SCANCODE_Z:
+                input->keyStatus = SDL_SCANCODE_Z;
+                break;
+
+            case SDL_SCANCODE_H:
+                input->keyStatus = SDL_SCANCODE_H;
+                break;
+            
+            case SDL_SCANCODE_N:
+                input->keyStatus = SDL_SCANCODE_N;
+                break;
+
+            case SDL_SCANCODE_1:
+                input->keyStatus = SDL_SCANCODE_1;
+                break;
+
+            case SDL_SCANCODE_2:
+                input->keyStatus = SDL_SCANCODE_2;
+                break;
+
+            case SDL_SCANCODE_3:
+                input->keyStatus = SDL_SCANCODE_3;
+                break;
+
+            case SDL_SCANCODE_4:
+                input->keyStatus = SDL_SCANCODE_4;
+                break;
+
+            default:
+                break;
+            }
+
+            // Touche du jeu
+            if (input->keyStatus == (int)evt.key.keysym.scancode)
+                Input_AddHit(input, input->keyStatus);
+            break;
+
+        case SDL_KEYUP:
+            input->isHit = false;
+            if (evt.key.repeat)
+                break;
+
+            //useless
+            switch (evt.key.keysym.scancode)
+            {
+                case SDL_SCANCODE_D:
+                    input->keyStatus = SDL_SCANCODE_D;
+                    break;
+
+                case SDL_SCANCODE_T:
+                    input->keyStatus = SDL_SCANCODE_T;
+                    break;
+
+                case SDL_SCANCODE_K:
+                    input->keyStatus = SDL_SCANCODE_K;
+                    break;
+
+                case SDL_SCANCODE_Z:
+                    input->keyStatus = SDL_SCANCODE_Z;
+                    break;
+
+                case SDL_SCANCODE_H:
+                    input->keyStatus = SDL_SCANCODE_H;
+                    break;
+
+                case SDL_SCANCODE_N:
+                    input->keyStatus = SDL_SCANCODE_N;
+                    break;
+
+                case SDL_SCANCODE_1:
+                    input->keyStatus = SDL_SCANCODE_1;
+                    break;
+
+                case SDL_SCANCODE_2:
+                    input->keyStatus = SDL_SCANCODE_2;
+                    break;
+
+                case SDL_SCANCODE_3:
+                    input->keyStatus = SDL_SCANCODE_3;
+                    break;
+
+                case SDL_SCANCODE_4:
+                    input->keyStatus = SDL_SCANCODE_4;
+                    break;
+
+                default:
+                    break;
+            }
+            break;
+
+        case SDL_MOUSEMOTION:
+            input->mouseX = evt.motion.x;
+            input->mouseY = evt.motion.y;
+            break;
+
+        case SDL_MOUSEWHEEL:
+            // Crans vers le haut (éloignés de l'utilisateur) comptés positivement
+            if (evt.wheel.direction == SDL_MOUSEWHEEL_FLIPPED)
+                input->mouseWheel -= evt.wheel.y;
+            else
+                input->mouseWheel += evt.wheel.y;
+            break;
+
+        case SDL_MOUSEBUTTONDOWN:
+            input->isHit = true;
+            switch (evt.button.button)
+            {
+            case SDL_BUTTON_LEFT:
+                input->mouseLDown = true;
+                input->mouseLPressed = true;
+
+                input->keyStatus = SDL_BUTTON_LEFT;
+                Input_AddHit(input, SDL_BUTTON_LEFT);
+
+                break;
+            case SDL_BUTTON_RIGHT:
+                input->mouseRDown = true;
+                input->mouseRPressed = true;
+
+                input->keyStatus = SDL_BUTTON_RIGHT;
+
+                break;
+            default:
+                break;
+            }
+            break;
+
+        case SDL_MOUSEBUTTONUP:
+            input->isHit = false;
+            switch (evt.button.button)
+            {
+            case SDL_BUTTON_LEFT:
+                input->mouseLDown = false;
+                break;
+            case SDL_BUTTON_RIGHT:
+                input->mouseRDown = false;
+                break;
+            default:
+                break;
+            }
+            break;
+        }
+    }
+
+    input->mouseDeltaX = input->mouseX - lastMouseX;
+    input->mouseDeltaY = input->mouseY - lastMouseY;
 }
\ No newline at end of file
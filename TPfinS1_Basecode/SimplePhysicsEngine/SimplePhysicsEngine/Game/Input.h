@@ -1,30 +1,49 @@
-#ifndef _INPUT_H_
-#define _INPUT_H_
-
-#include "../Settings.h"
-
-typedef struct Input_s
-{
-    bool quitPressed;
-    bool restartPressed;
-
-    bool mouseLPressed;
-    bool mouseRPressed;
-
-    _Bool isHit;
-    int keyStatus;
-
-    bool mouseLDown;
-    bool mouseRDown;
-
-    int mouseX;
-    int mouseY;
-    int mouseDeltaX;
-    int mouseDeltaY;
-} Input;
-
-Input *Input_New();
-void Input_Free(Input *input);
-void Input_Update(Input *input);
-
-#endif
+#ifndef _INPUT_H_
+#define _INPUT_H_
+
+#include "../Settings.h"
+
+/// @brief Nombre maximal d'appuis (touches du jeu et clic gauche) retenus entre deux mises à
+/// jour du jeu.
+#define INPUT_MAX_HITS 16
+
+typedef struct Input_s
+{
+    bool quitPressed;
+    bool restartPressed;
+    bool tracePressed;
+    bool pausePressed;
+    bool renderTargetsReset;
+
+    bool mouseLPressed;
+    bool mouseRPressed;
+
+    _Bool isHit;
+    int keyStatus;
+
+    int hits[INPUT_MAX_HITS];
+    int hitCount;
+
+    bool mouseLDown;
+    bool mouseRDown;
+
+    int mouseX;
+    int mouseY;
+    int mouseDeltaX;
+    int mouseDeltaY;
+
+    int mouseWheel;
+} Input;
+
+Input *Input_New();
+void Input_Free(Input *input);
+void Input_Update(Input *input);
+
+/// @brief Efface les appuis (touches et boutons enfoncés depuis la dernière mise à jour).
+void Input_ClearPresses(Input *input);
+
+/// @brief Ajoute à input les appuis de previous, qui n'ont pas encore été traités.
+/// Les appuis de previous restent les premiers dans l'ordre des touches enfoncées.
+void Input_Merge(Input *input, const Input *previous);
+
+#endif
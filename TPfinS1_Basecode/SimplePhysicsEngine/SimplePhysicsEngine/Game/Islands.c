@@ -0,0 +1,698 @@
+﻿#include "Islands.h"
+#include "Scene.h"
+#include "../Utils/Tools.h"
+
+Islands *Islands_New(int capacity)
+{
+    Islands *islands = NULL;
+
+    islands = (Islands *)calloc(1, sizeof(Islands));
+    if (!islands) goto ERROR_LABEL;
+
+    islands->m_sleepEnergy = ISLAND_SLEEP_ENERGY;
+    islands->m_sleepSteps = ISLAND_SLEEP_STEPS;
+    islands->m_dirty = true;
+    islands->m_springsDirty = true;
+
+    int exitStatus = Islands_Reserve(islands, capacity);
+    if (exitStatus == EXIT_FAILURE) goto ERROR_LABEL;
+
+    islands->m_ballStart[0] = 0;
+    islands->m_springStart[0] = 0;
+
+    return islands;
+
+ERROR_LABEL:
+    printf("ERROR - Islands_New()\n");
+    assert(false);
+    Islands_Free(islands);
+    return NULL;
+}
+
+void Islands_Free(Islands *islands)
+{
+    if (!islands) return;
+
+    free(islands->m_ballIsland);
+    free(islands->m_ballStart);
+    free(islands->m_springStart);
+    free(islands->m_springOrder);
+    free(islands->m_sleeping);
+    free(islands->m_calmSteps);
+    free(islands->m_energy);
+    free(islands->m_awake);
+    free(islands->m_parent);
+    free(islands->m_order);
+    free(islands->m_newIndex);
+    free(islands->m_links);
+    free(islands->m_mark);
+
+    memset(islands, 0, sizeof(Islands));
+    free(islands);
+}
+
+int Islands_Reserve(Islands *islands, int capacity)
+{
+    if (capacity <= islands->m_ballCapacity)
+        return EXIT_SUCCESS;
+
+    // Il y a au plus une île par balle
+    if (Tools_Realloc((void **)&islands->m_ballIsland, capacity, sizeof(int)) == EXIT_FAILURE
+        || Tools_Realloc((void **)&islands->m_parent, capacity, sizeof(int)) == EXIT_FAILURE
+        || Tools_Realloc((void **)&islands->m_order, capacity, sizeof(int)) == EXIT_FAILURE
+        || Tools_Realloc((void **)&islands->m_newIndex, capacity, sizeof(int)) == EXIT_FAILURE
+        || Tools_Realloc((void **)&islands->m_links, capacity, sizeof(BallLinks)) == EXIT_FAILURE
+        || Tools_Realloc((void **)&islands->m_mark, capacity, sizeof(int)) == EXIT_FAILURE
+        || Tools_Realloc((void **)&islands->m_ballStart, capacity + 1, sizeof(int)) == EXIT_FAILURE
+        || Tools_Realloc((void **)&islands->m_springStart, capacity + 1, sizeof(int)) == EXIT_FAILURE
+        || Tools_Realloc((void **)&islands->m_sleeping, capacity, sizeof(bool)) == EXIT_FAILURE
+        || Tools_Realloc((void **)&islands->m_calmSteps, capacity, sizeof(int)) == EXIT_FAILURE
+        || Tools_Realloc((void **)&islands->m_energy, capacity, sizeof(float)) == EXIT_FAILURE
+        || Tools_Realloc((void **)&islands->m_awake, capacity, sizeof(int)) == EXIT_FAILURE)
+        goto ERROR_LABEL;
+
+    // Les nouvelles balles ne sont marquées par aucun parcours
+    memset(islands->m_mark + islands->m_ballCapacity, 0,
+        (capacity - islands->m_ballCapacity) * sizeof(int));
+    islands->m_ballCapacity = capacity;
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - Islands_Reserve()\n");
+    return EXIT_FAILURE;
+}
+
+/// @brief Renvoie le nombre de balles d'une île.
+static int Islands_GetSize(Islands *islands, int island)
+{
+    return islands->m_ballStart[island + 1] - islands->m_ballStart[island];
+}
+
+/// @brief Demande le recalcul des îles à partir de l'île contenant une balle.
+static void Islands_MarkDirty(Islands *islands, int ball)
+{
+    int island = islands->m_ballIsland[ball];
+    int first = ball;
+
+    // Les îles situées avant m_dirtyBall sont à jour : leur première balle est connue
+    if ((island >= 0) && (island < islands->m_islandCount))
+        first = SDL_min(first, islands->m_ballStart[island]);
+
+    islands->m_dirtyBall = islands->m_dirty ? SDL_min(islands->m_dirtyBall, first) : first;
+    islands->m_dirty = true;
+}
+
+/// @brief Rattache les balles de l'île suivante à une île (sans déplacer de balles).
+static void Islands_MergeNext(Islands *islands, int island)
+{
+    int *ballIsland = islands->m_ballIsland;
+    int next = island + 1;
+    int islandCount = islands->m_islandCount;
+
+    islands->m_sleeping[island] = islands->m_sleeping[island] && islands->m_sleeping[next];
+    islands->m_calmSteps[island] = SDL_min(islands->m_calmSteps[island], islands->m_calmSteps[next]);
+
+    for (int i = islands->m_ballStart[next]; i < islands->m_ballStart[next + 1]; ++i)
+    {
+        ballIsland[i] = island;
+    }
+    for (int i = islands->m_ballStart[next + 1]; i < islands->m_ballStart[islandCount]; ++i)
+    {
+        ballIsland[i]--;
+    }
+
+    memmove(&islands->m_ballStart[next], &islands->m_ballStart[next + 1],
+        (islandCount - next) * sizeof(int));
+    memmove(&islands->m_springStart[next], &islands->m_springStart[next + 1],
+        (islandCount - next) * sizeof(int));
+    memmove(&islands->m_sleeping[next], &islands->m_sleeping[next + 1],
+        (islandCount - next - 1) * sizeof(bool));
+    memmove(&islands->m_calmSteps[next], &islands->m_calmSteps[next + 1],
+        (islandCount - next - 1) * sizeof(int));
+    islands->m_islandCount--;
+}
+
+/// @brief Détache la dernière balle d'une île dans une nouvelle île (sans déplacer de balles).
+static void Islands_SplitLast(Islands *islands, int island)
+{
+    int *ballIsland = islands->m_ballIsland;
+    int next = island + 1;
+    int islandCount = islands->m_islandCount;
+
+    memmove(&islands->m_ballStart[next + 1], &islands->m_ballStart[next],
+        (islandCount - next + 1) * sizeof(int));
+    memmove(&islands->m_springStart[next + 1], &islands->m_springStart[next],
+        (islandCount - next + 1) * sizeof(int));
+    memmove(&islands->m_sleeping[next + 1], &islands->m_sleeping[next],
+        (islandCount - next) * sizeof(bool));
+    memmove(&islands->m_calmSteps[next + 1], &islands->m_calmSteps[next],
+        (islandCount - next) * sizeof(int));
+    islands->m_islandCount++;
+
+    // La balle détachée n'a pas de ressort
+    islands->m_ballStart[next] = islands->m_ballStart[next + 1] - 1;
+    islands->m_springStart[next] = islands->m_springStart[next + 1];
+    islands->m_sleeping[next] = islands->m_sleeping[island];
+    islands->m_calmSteps[next] = islands->m_calmSteps[island];
+
+    for (int i = islands->m_ballStart[next]; i < islands->m_ballStart[islands->m_islandCount]; ++i)
+    {
+        ballIsland[i]++;
+    }
+}
+
+/// @brief Indique si une balle est accessible depuis une autre par les ressorts (parcours
+/// en largeur, qui s'arrête dès que la balle est atteinte).
+/// @param[out] visited le nombre de balles visitées.
+static bool Islands_IsConnected(Islands *islands, Scene *scene, int ball1, int ball2, int *visited)
+{
+    Springs *springs = scene->m_springs;
+    BallLinks *links = scene->m_links;
+    int *queue = islands->m_order;
+    int *mark = islands->m_mark;
+
+    if (islands->m_markStamp == INT32_MAX)
+    {
+        memset(mark, 0, islands->m_ballCapacity * sizeof(int));
+        islands->m_markStamp = 0;
+    }
+    int stamp = ++islands->m_markStamp;
+
+    int head = 0, tail = 0;
+    queue[tail++] = ball1;
+    mark[ball1] = stamp;
+
+    while (head < tail)
+    {
+        int ball = queue[head++];
+        for (int i = 0; i < links[ball].springCount; ++i)
+        {
+            int other = Springs_GetOther(springs, links[ball].springs[i], ball);
+            if (other == ball2)
+            {
+                *visited = tail;
+                return true;
+            }
+            if (mark[other] != stamp)
+            {
+                mark[other] = stamp;
+                queue[tail++] = other;
+            }
+        }
+    }
+
+    *visited = tail;
+    return false;
+}
+
+void Islands_AddBall(Islands *islands, int ball)
+{
+    // La balle forme une nouvelle île, à la suite des autres
+    if (!islands->m_dirty && (ball == islands->m_ballStart[islands->m_islandCount]))
+    {
+        int island = islands->m_islandCount++;
+        islands->m_ballIsland[ball] = island;
+        islands->m_ballStart[island + 1] = ball + 1;
+        islands->m_springStart[island + 1] = islands->m_springStart[island];
+        islands->m_sleeping[island] = false;
+        islands->m_calmSteps[island] = 0;
+        return;
+    }
+
+    islands->m_ballIsland[ball] = -1;
+    Islands_MarkDirty(islands, ball);
+}
+
+void Islands_RemoveBall(Islands *islands, int ball, int last)
+{
+    int island = islands->m_ballIsland[ball];
+    int lastIsland = islands->m_ballIsland[last];
+
+    Islands_WakeBall(islands, ball);
+
+    // Une balle seule dans son île est remplacée par la dernière balle, seule dans la dernière
+    // île : cette île prend la place de l'île supprimée
+    if (!islands->m_dirty && (lastIsland == islands->m_islandCount - 1)
+        && (Islands_GetSize(islands, island) == 1) && (Islands_GetSize(islands, lastIsland) == 1))
+    {
+        // La balle déplacée change d'indice
+        if (islands->m_sleeping[lastIsland])
+            islands->m_sleepVersion++;
+
+        islands->m_sleeping[island] = islands->m_sleeping[lastIsland];
+        islands->m_calmSteps[island] = islands->m_calmSteps[lastIsland];
+        islands->m_islandCount--;
+        return;
+    }
+
+    Islands_MarkDirty(islands, ball);
+    Islands_MarkDirty(islands, last);
+    islands->m_ballIsland[ball] = islands->m_ballIsland[last];
+}
+
+void Islands_Link(Islands *islands, int ball1, int ball2)
+{
+    int island1 = islands->m_ballIsland[ball1];
+    int island2 = islands->m_ballIsland[ball2];
+    int island = SDL_min(island1, island2);
+
+    islands->m_springsDirty = true;
+
+    if (!islands->m_dirty)
+    {
+        if (island1 == island2)
+            return;
+
+        // Deux îles voisines fusionnent sans déplacer de balles
+        int cost = islands->m_ballStart[islands->m_islandCount] - islands->m_ballStart[island + 1];
+        if ((abs(island1 - island2) == 1) && (cost <= islands->m_budget))
+        {
+            islands->m_budget -= cost;
+            Islands_MergeNext(islands, island);
+            return;
+        }
+    }
+
+    Islands_MarkDirty(islands, ball1);
+    Islands_MarkDirty(islands, ball2);
+}
+
+void Islands_Unlink(Islands *islands, Scene *scene, int ball1, int ball2)
+{
+    BallLinks *links = scene->m_links;
+
+    islands->m_springsDirty = true;
+
+    if (!islands->m_dirty)
+    {
+        int island = islands->m_ballIsland[ball1];
+        int end = islands->m_ballStart[island + 1];
+        int cost = islands->m_ballStart[islands->m_islandCount] - end + 1;
+
+        // Une balle sans ressort à la fin de son île s'en détache sans déplacer de balles.
+        // Elle n'avait que ce ressort : le reste de l'île ne passait pas par elle.
+        if ((cost <= islands->m_budget)
+            && (((ball1 == end - 1) && (links[ball1].springCount == 0))
+                || ((ball2 == end - 1) && (links[ball2].springCount == 0))))
+        {
+            islands->m_budget -= cost;
+            Islands_SplitLast(islands, island);
+            return;
+        }
+
+        // Sinon, l'île reste entière si la seconde balle est encore accessible depuis la première
+        if (Islands_GetSize(islands, island) <= islands->m_budget)
+        {
+            int visited = 0;
+            bool connected = Islands_IsConnected(islands, scene, ball1, ball2, &visited);
+            islands->m_budget -= visited;
+            if (connected)
+                return;
+        }
+    }
+
+    Islands_MarkDirty(islands, ball1);
+    Islands_MarkDirty(islands, ball2);
+}
+
+void Islands_WakeBall(Islands *islands, int ball)
+{
+    int island = islands->m_ballIsland[ball];
+    if ((island < 0) || (island >= islands->m_islandCount))
+        return;
+
+    // Une île déjà éveillée garde son compteur : elle s'endormira dès qu'elle sera au repos
+    if (!islands->m_sleeping[island])
+        return;
+
+    islands->m_sleeping[island] = false;
+    islands->m_calmSteps[island] = 0;
+    islands->m_sleepVersion++;
+}
+
+void Islands_WakeAll(Islands *islands)
+{
+    for (int i = 0; i < islands->m_islandCount; ++i)
+    {
+        islands->m_sleeping[i] = false;
+        islands->m_calmSteps[i] = 0;
+    }
+    islands->m_sleepVersion++;
+}
+
+/// @brief Renvoie la racine de l'arbre union-find contenant une balle.
+static int Islands_Find(int *parent, int ball)
+{
+    // Compression de chemin par division
+    while (parent[ball] != ball)
+    {
+        parent[ball] = parent[parent[ball]];
+        ball = parent[ball];
+    }
+    return ball;
+}
+
+/// @brief Range les ressorts par île.
+static int Islands_SortSprings(Islands *islands, Scene *scene)
+{
+    Springs *springs = scene->m_springs;
+    int springCount = springs->m_count;
+    int islandCount = islands->m_islandCount;
+    int *ballIsland = islands->m_ballIsland;
+    int *next = islands->m_newIndex;
+
+    if (springCount > islands->m_springCapacity)
+    {
+        int exitStatus = Tools_Realloc(
+            (void **)&islands->m_springOrder, springs->m_capacity, sizeof(int));
+        if (exitStatus == EXIT_FAILURE) goto ERROR_LABEL;
+        islands->m_springCapacity = springs->m_capacity;
+    }
+
+    // Les ressorts étant rangés par couleur dans la liste, un tri par dénombrement stable
+    // les laisse rangés par couleur à l'intérieur de chaque île.
+    memset(islands->m_springStart, 0, (islandCount + 1) * sizeof(int));
+    for (int i = 0; i < springCount; ++i)
+    {
+        islands->m_springStart[ballIsland[springs->m_ball1[i]] + 1]++;
+    }
+    for (int i = 0; i < islandCount; ++i)
+    {
+        islands->m_springStart[i + 1] += islands->m_springStart[i];
+    }
+    for (int i = 0; i < islandCount; ++i)
+    {
+        // Utilise m_newIndex comme position d'insertion courante de chaque île
+        next[i] = islands->m_springStart[i];
+    }
+    for (int i = 0; i < springCount; ++i)
+    {
+        int island = ballIsland[springs->m_ball1[i]];
+        islands->m_springOrder[next[island]++] = i;
+    }
+
+    islands->m_springsDirty = false;
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - Islands_SortSprings()\n");
+    return EXIT_FAILURE;
+}
+
+/// @brief Recalcule les îles à partir de celle qui contient la balle m_dirtyBall et range
+/// ces balles par île. Les îles précédentes ne sont pas modifiées.
+static int Islands_Build(Islands *islands, Scene *scene)
+{
+    Particles *particles = scene->m_particles;
+    Springs *springs = scene->m_springs;
+    BallLinks *links = scene->m_links;
+    int ballCount = particles->m_count;
+
+    int *parent = islands->m_parent;
+    int *order = islands->m_order;
+    int *newIndex = islands->m_newIndex;
+    int *ballIsland = islands->m_ballIsland;
+
+    // Recherche dichotomique de la dernière île qui commence avant m_dirtyBall
+    int low = 0, high = islands->m_islandCount;
+    while (low < high)
+    {
+        int mid = (low + high + 1) / 2;
+        if (islands->m_ballStart[mid] <= islands->m_dirtyBall)
+            low = mid;
+        else
+            high = mid - 1;
+    }
+    int firstIsland = low;
+    int first = SDL_min(islands->m_ballStart[firstIsland], ballCount);
+
+    // Mémorise, pour chaque balle, depuis combien de pas de temps son île est au repos
+    // (-1 - ce nombre si l'île est éveillée, -1 pour une nouvelle balle) : une nouvelle île
+    // reste endormie si toutes ses balles l'étaient, et reprend le plus petit des compteurs
+    bool moveSleeping = false;
+    for (int i = first; i < ballCount; ++i)
+    {
+        int island = ballIsland[i];
+        if ((island < firstIsland) || (island >= islands->m_islandCount))
+        {
+            order[i] = -1;
+        }
+        else if (islands->m_sleeping[island])
+        {
+            order[i] = islands->m_calmSteps[island];
+            moveSleeping = true;
+        }
+        else
+        {
+            order[i] = -1 - islands->m_calmSteps[island];
+        }
+    }
+
+    // Union-find sur le graphe des ressorts. Aucun ressort ne relie ces balles aux îles
+    // précédentes.
+    for (int i = first; i < ballCount; ++i)
+    {
+        parent[i] = i;
+    }
+    for (int i = first; i < ballCount; ++i)
+    {
+        for (int j = 0; j < links[i].springCount; ++j)
+        {
+            int other = Springs_GetOther(springs, links[i].springs[j], i);
+            assert(other >= first);
+            if (other < i)
+                continue;
+
+            int root1 = Islands_Find(parent, i);
+            int root2 = Islands_Find(parent, other);
+            if (root1 < root2)
+                parent[root2] = root1;
+            else if (root2 < root1)
+                parent[root1] = root2;
+        }
+    }
+
+    // Numérote les îles dans l'ordre de leur plus petite balle
+    int islandCount = firstIsland;
+    for (int i = first; i < ballCount; ++i)
+    {
+        int root = Islands_Find(parent, i);
+        if (root == i)
+        {
+            newIndex[i] = islandCount;
+            islands->m_ballStart[islandCount] = 0;
+            islands->m_sleeping[islandCount] = true;
+            islands->m_calmSteps[islandCount] = INT32_MAX;
+            islandCount++;
+        }
+        int island = newIndex[root];
+        ballIsland[i] = island;
+        islands->m_ballStart[island]++;
+
+        int calmSteps = order[i];
+        if (calmSteps < 0)
+        {
+            islands->m_sleeping[island] = false;
+            calmSteps = -1 - calmSteps;
+        }
+        if (calmSteps < islands->m_calmSteps[island])
+            islands->m_calmSteps[island] = calmSteps;
+    }
+    islands->m_islandCount = islandCount;
+
+    // Range les balles par île (tri par dénombrement stable)
+    int start = first;
+    for (int i = firstIsland; i < islandCount; ++i)
+    {
+        int count = islands->m_ballStart[i];
+        islands->m_ballStart[i] = start;
+        start += count;
+    }
+    islands->m_ballStart[islandCount] = start;
+
+    for (int i = first; i < ballCount; ++i)
+    {
+        int index = islands->m_ballStart[ballIsland[i]]++;
+        order[index] = i;
+        newIndex[i] = index;
+    }
+    for (int i = islandCount; i > firstIsland; --i)
+    {
+        islands->m_ballStart[i] = islands->m_ballStart[i - 1];
+    }
+    islands->m_ballStart[firstIsland] = first;
+
+    Particles_Permute(particles, first, order, parent);
+
+    for (int i = first; i < ballCount; ++i)
+    {
+        islands->m_links[i - first] = links[order[i]];
+    }
+    memcpy(links + first, islands->m_links, (ballCount - first) * sizeof(BallLinks));
+
+    for (int i = firstIsland; i < islandCount; ++i)
+    {
+        for (int j = islands->m_ballStart[i]; j < islands->m_ballStart[i + 1]; ++j)
+        {
+            ballIsland[j] = i;
+        }
+    }
+
+    // Met à jour les extrémités des ressorts. Une extrémité déjà renumérotée est notée
+    // -1 - indice pour ne pas être confondue avec un ancien indice.
+    for (int i = first; i < ballCount; ++i)
+    {
+        for (int j = 0; j < links[i].springCount; ++j)
+        {
+            int spring = links[i].springs[j];
+            if (springs->m_ball1[spring] == order[i])
+                springs->m_ball1[spring] = -1 - i;
+            else
+                springs->m_ball2[spring] = -1 - i;
+        }
+    }
+    for (int i = first; i < ballCount; ++i)
+    {
+        for (int j = 0; j < links[i].springCount; ++j)
+        {
+            int spring = links[i].springs[j];
+            if (springs->m_ball1[spring] < 0)
+                springs->m_ball1[spring] = -1 - springs->m_ball1[spring];
+            if (springs->m_ball2[spring] < 0)
+                springs->m_ball2[spring] = -1 - springs->m_ball2[spring];
+        }
+    }
+
+    // Les ressorts ne sont rangés à nouveau que si ces îles en contiennent
+    if (islands->m_springsDirty || (islands->m_springStart[firstIsland] < springs->m_count))
+    {
+        int exitStatus = Islands_SortSprings(islands, scene);
+        if (exitStatus == EXIT_FAILURE) return EXIT_FAILURE;
+    }
+    else
+    {
+        for (int i = firstIsland + 1; i <= islandCount; ++i)
+        {
+            islands->m_springStart[i] = springs->m_count;
+        }
+    }
+
+    islands->m_dirty = false;
+
+    // Les balles endormies réordonnées changent d'indice
+    if (moveSleeping)
+        islands->m_sleepVersion++;
+
+    return EXIT_SUCCESS;
+}
+
+int Islands_Update(Islands *islands, Scene *scene)
+{
+    // Un changement de mode de jeu réveille toutes les îles
+    gameMode_t *gameMode = scene->m_gameMode;
+    if ((gameMode->gravity != islands->m_gravity) || (gameMode->rebond != islands->m_rebond))
+    {
+        islands->m_gravity = gameMode->gravity;
+        islands->m_rebond = gameMode->rebond;
+        Islands_WakeAll(islands);
+    }
+
+    int exitStatus = EXIT_SUCCESS;
+    if (islands->m_dirty)
+        exitStatus = Islands_Build(islands, scene);
+    else if (islands->m_springsDirty)
+        exitStatus = Islands_SortSprings(islands, scene);
+    if (exitStatus == EXIT_FAILURE) return EXIT_FAILURE;
+
+    // Les modifications immédiates peuvent à nouveau parcourir toutes les balles
+    islands->m_budget = scene->m_particles->m_count;
+
+    // Etablit la liste des îles éveillées
+    islands->m_awakeCount = 0;
+    islands->m_sleepingBallCount = 0;
+    for (int i = 0; i < islands->m_islandCount; ++i)
+    {
+        if (islands->m_sleeping[i])
+        {
+            islands->m_sleepingBallCount += islands->m_ballStart[i + 1] - islands->m_ballStart[i];
+        }
+        else
+        {
+            islands->m_awake[islands->m_awakeCount++] = i;
+            islands->m_energy[i] = 0.f;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+void Islands_UpdateSleep(Islands *islands, Scene *scene)
+{
+    Particles *particles = scene->m_particles;
+
+    if (islands->m_sleepSteps <= 0)
+        return;
+
+    for (int i = 0; i < islands->m_awakeCount; ++i)
+    {
+        int island = islands->m_awake[i];
+
+        if (islands->m_energy[island] >= islands->m_sleepEnergy)
+        {
+            islands->m_calmSteps[island] = 0;
+            continue;
+        }
+
+        islands->m_calmSteps[island]++;
+        if (islands->m_calmSteps[island] < islands->m_sleepSteps)
+            continue;
+
+        // Endort l'île : ses balles sont immobilisées
+        islands->m_sleeping[island] = true;
+        islands->m_sleepVersion++;
+        for (int j = islands->m_ballStart[island]; j < islands->m_ballStart[island + 1]; ++j)
+        {
+            particles->m_velX[j] = 0.f;
+            particles->m_velY[j] = 0.f;
+        }
+
+        // Les positions de début de pas d'une île endormie ne sont plus mises à jour :
+        // elles doivent être égales aux positions courantes
+        Particles_SavePositions(
+            particles, islands->m_ballStart[island], islands->m_ballStart[island + 1]);
+    }
+}
+
+void Islands_GetColorRange(
+    Islands *islands, Springs *springs, int island, int color, int *first, int *last)
+{
+    const int *order = islands->m_springOrder;
+    int lower = islands->m_springStart[island];
+    int upper = islands->m_springStart[island + 1];
+
+    // Recherche dichotomique du premier ressort de couleur >= color
+    int low = lower, high = upper;
+    while (low < high)
+    {
+        int mid = (low + high) / 2;
+        if (springs->m_color[order[mid]] < color)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    *first = low;
+
+    // Puis du premier ressort de couleur > color
+    high = upper;
+    while (low < high)
+    {
+        int mid = (low + high) / 2;
+        if (springs->m_color[order[mid]] <= color)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    *last = low;
+}
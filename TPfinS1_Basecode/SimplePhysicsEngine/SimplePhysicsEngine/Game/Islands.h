@@ -0,0 +1,192 @@
+﻿#ifndef _ISLANDS_H_
+#define _ISLANDS_H_
+
+/// @file islands.h
+/// @defgroup Physics
+/// @{
+
+#include "../Settings.h"
+#include "Springs.h"
+
+typedef struct Scene_s Scene;
+
+/// @brief Energie cinétique (exprimée en J) en dessous de laquelle une balle est considérée
+/// comme immobile. Une balle posée sur le sol n'est jamais parfaitement immobile : elle rebondit
+/// sur quelques millimètres avec une énergie cinétique qui atteint 0.08 J (balle de 0.5 kg,
+/// pesanteur terrestre, pas de temps de 1/100 s).
+#define ISLAND_SLEEP_ENERGY 0.1f
+
+/// @brief Nombre de pas de temps consécutifs pendant lesquels toutes les balles d'une île
+/// doivent rester immobiles pour que l'île s'endorme.
+#define ISLAND_SLEEP_STEPS 100
+
+/// @brief Nombre de balles à partir duquel une île est répartie entre plusieurs threads.
+/// Les îles plus petites sont traitées entièrement par un seul thread.
+#define ISLAND_SPLIT_SIZE 2048
+
+/// @brief Décomposition des balles en îles, c'est-à-dire en composantes connexes du graphe
+/// des ressorts. Les îles n'interagissent pas entre elles : chacune peut être simulée
+/// indépendamment des autres, et une île au repos peut être endormie (ni force ni intégration).
+///
+/// Les balles sont rangées par île : les balles de l'île k occupent les indices
+/// [m_ballStart[k], m_ballStart[k + 1][ et ses ressorts sont m_springOrder[m_springStart[k]] ...
+/// m_springOrder[m_springStart[k + 1] - 1], triés par couleur.
+///
+/// Les modifications qui ne déplacent aucune balle sont appliquées immédiatement : une nouvelle
+/// balle forme une nouvelle île, deux îles voisines fusionnent, une balle sans ressort se détache
+/// de la fin de son île. Les autres modifications sont différées : au pas de temps suivant, les îles
+/// sont recalculées (union-find) à partir de la première balle concernée seulement.
+typedef struct Islands_s
+{
+    /// @brief Île de chaque balle (-1 pour une balle créée depuis le dernier calcul des îles).
+    int *m_ballIsland;
+
+    /// @brief Indice de la première balle de chaque île.
+    int *m_ballStart;
+
+    /// @brief Position, dans m_springOrder, du premier ressort de chaque île.
+    int *m_springStart;
+
+    /// @brief Indices des ressorts rangés par île puis par couleur.
+    int *m_springOrder;
+
+    /// @brief Indique pour chaque île si elle est endormie.
+    bool *m_sleeping;
+
+    /// @brief Nombre de pas de temps consécutifs pendant lesquels chaque île est restée au repos.
+    int *m_calmSteps;
+
+    /// @brief Energie cinétique maximale d'une balle de chaque île au dernier pas de temps.
+    float *m_energy;
+
+    /// @brief Îles éveillées, mises à jour par Islands_Update().
+    int *m_awake;
+
+    /// @brief Nombre d'îles éveillées.
+    int m_awakeCount;
+
+    /// @brief Nombre d'îles.
+    int m_islandCount;
+
+    /// @brief Nombre de balles endormies.
+    int m_sleepingBallCount;
+
+    /// @brief Indique que les îles doivent être recalculées à partir de la balle m_dirtyBall.
+    bool m_dirty;
+    int m_dirtyBall;
+
+    /// @brief Indique que les ressorts ont changé depuis le dernier calcul de m_springOrder.
+    bool m_springsDirty;
+
+    /// @brief Nombre de balles que les modifications immédiates peuvent encore parcourir avant
+    /// le prochain pas de temps. Au-delà, les modifications sont différées : une longue série de
+    /// modifications (chargement d'une scène) ne coûte qu'un seul calcul des îles.
+    int m_budget;
+
+    /// @brief Version de l'ensemble des balles endormies, incrémentée lorsqu'une île s'endort
+    /// ou se réveille et lorsque les balles sont réordonnées (voir Collisions).
+    Uint32 m_sleepVersion;
+
+    /// @brief Energie cinétique en dessous de laquelle une balle est considérée comme immobile.
+    float m_sleepEnergy;
+
+    /// @brief Nombre de pas de temps au repos avant qu'une île s'endorme (0 pour ne jamais dormir).
+    int m_sleepSteps;
+
+    /// @brief Pesanteur et coefficient de rebond utilisés lors du dernier pas de temps.
+    /// Un changement de mode de jeu réveille toutes les îles.
+    float m_gravity, m_rebond;
+
+    /// @brief Tableaux temporaires utilisés pour calculer les îles (m_ballCapacity éléments).
+    int *m_parent, *m_order, *m_newIndex;
+    BallLinks *m_links;
+
+    /// @brief Marques des balles visitées lors d'un parcours d'île : une balle est visitée
+    /// si sa marque vaut m_markStamp, incrémenté à chaque parcours.
+    int *m_mark;
+    int m_markStamp;
+
+    /// @brief Nombre maximal de balles avant d'effectuer une réallocation mémoire.
+    int m_ballCapacity;
+
+    /// @brief Nombre maximal de ressorts avant d'effectuer une réallocation mémoire.
+    int m_springCapacity;
+} Islands;
+
+/// @brief Crée une décomposition en îles vide.
+/// @param[in] capacity le nombre maximal de balles initial.
+/// @return La décomposition créée ou NULL en cas d'erreur.
+Islands *Islands_New(int capacity);
+
+/// @brief Détruit une décomposition préalablement allouée avec Islands_New().
+/// @param[in,out] islands la décomposition à détruire.
+void Islands_Free(Islands *islands);
+
+/// @brief Augmente le nombre maximal de balles si nécessaire.
+/// @param[in,out] islands la décomposition.
+/// @param[in] capacity le nombre maximal de balles souhaité.
+/// @return EXIT_SUCCESS ou EXIT_FAILURE.
+int Islands_Reserve(Islands *islands, int capacity);
+
+/// @brief Signale l'ajout d'une balle (éveillée, dans une nouvelle île).
+/// @param[in,out] islands la décomposition.
+/// @param[in] ball l'indice de la balle.
+void Islands_AddBall(Islands *islands, int ball);
+
+/// @brief Signale la suppression d'une balle, remplacée par la balle d'indice last.
+/// L'île de la balle supprimée est réveillée.
+/// @param[in,out] islands la décomposition.
+/// @param[in] ball l'indice de la balle supprimée.
+/// @param[in] last l'indice de la dernière balle.
+void Islands_RemoveBall(Islands *islands, int ball, int last);
+
+/// @brief Signale l'ajout d'un ressort entre deux balles, dont les îles fusionnent.
+/// @param[in,out] islands la décomposition.
+/// @param[in] ball1 l'indice de la première balle.
+/// @param[in] ball2 l'indice de la seconde balle.
+void Islands_Link(Islands *islands, int ball1, int ball2);
+
+/// @brief Signale la suppression du ressort qui liait deux balles. Leur île peut se séparer
+/// en deux : elle reste entière si la seconde balle est encore accessible depuis la première.
+/// @param[in,out] islands la décomposition.
+/// @param[in] scene la scène, dont le ressort a déjà été supprimé.
+/// @param[in] ball1 l'indice de la première balle.
+/// @param[in] ball2 l'indice de la seconde balle.
+void Islands_Unlink(Islands *islands, Scene *scene, int ball1, int ball2);
+
+/// @brief Réveille l'île contenant une balle.
+/// @param[in,out] islands la décomposition.
+/// @param[in] ball l'indice de la balle.
+void Islands_WakeBall(Islands *islands, int ball);
+
+/// @brief Réveille toutes les îles.
+/// @param[in,out] islands la décomposition.
+void Islands_WakeAll(Islands *islands);
+
+/// @brief Recalcule les îles si la topologie a changé, puis établit la liste des îles éveillées.
+/// Le calcul des îles réordonne les balles de la scène (à partir de m_dirtyBall) : les indices
+/// (mais pas les identifiants) de ces balles changent.
+/// @param[in,out] islands la décomposition.
+/// @param[in,out] scene la scène.
+/// @return EXIT_SUCCESS ou EXIT_FAILURE.
+int Islands_Update(Islands *islands, Scene *scene);
+
+/// @brief Endort les îles restées au repos suffisamment longtemps.
+/// Doit être appelée après chaque pas de temps, une fois m_energy calculé pour les îles éveillées.
+/// @param[in,out] islands la décomposition.
+/// @param[in,out] scene la scène.
+void Islands_UpdateSleep(Islands *islands, Scene *scene);
+
+/// @brief Renvoie les ressorts d'une couleur donnée dans une île.
+/// @param[in] islands la décomposition.
+/// @param[in] springs la liste des ressorts.
+/// @param[in] island l'indice de l'île.
+/// @param[in] color la couleur.
+/// @param[out] first la position, dans m_springOrder, du premier ressort de la couleur.
+/// @param[out] last la position suivant celle du dernier ressort de la couleur.
+void Islands_GetColorRange(
+    Islands *islands, Springs *springs, int island, int color, int *first, int *last);
+
+/// @}
+
+#endif
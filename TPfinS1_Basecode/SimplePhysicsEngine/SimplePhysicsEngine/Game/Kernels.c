@@ -0,0 +1,472 @@
+﻿#include "Kernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#  define KERNELS_X86
+#  include <immintrin.h>
+#  if defined(__GNUC__) || defined(__clang__)
+#    define KERNELS_TARGET(isa) __attribute__((target(isa)))
+#  else
+#    define KERNELS_TARGET(isa)
+#  endif
+#endif
+
+// Les versions vectorielles effectuent exactement les mêmes opérations flottantes, dans le même
+// ordre, que les versions scalaires : les résultats sont donc identiques au bit près
+// (à condition de compiler sans contraction en FMA, voir -ffp-contract=off dans le Makefile).
+
+//-------------------------------------------------------------------------------------------------
+// Noyaux scalaires
+
+static void SpringForces_Scalar(
+    const float *posX, const float *posY,
+    const int *ball1, const int *ball2, const float *length, const float *stiffness,
+    float *forceX, float *forceY, const int *order, int first, int last)
+{
+    for (int i = first; i < last; ++i)
+    {
+        int spring = order[i];
+        int b1 = ball1[spring];
+        int b2 = ball2[spring];
+        float dx = posX[b2] - posX[b1];
+        float dy = posY[b2] - posY[b1];
+        float distance = sqrtf(dx * dx + dy * dy);
+        if (distance <= 0.f)
+            continue;
+
+        // Loi de Hooke : la force est portée par la direction du ressort
+        float scale = stiffness[spring] * (distance - length[spring]) / distance;
+        float fx = scale * dx;
+        float fy = scale * dy;
+
+        forceX[b1] += fx;
+        forceY[b1] += fy;
+        forceX[b2] -= fx;
+        forceY[b2] -= fy;
+    }
+}
+
+static void IntegrateVelocity_Scalar(
+    float *velX, float *velY, float *forceX, float *forceY,
+    const float *invMass, const float *friction, float gravity, float timeStep,
+    int first, int last)
+{
+    for (int i = first; i < last; ++i)
+    {
+        float ax = ((-friction[i] * velX[i]) + forceX[i]) * invMass[i];
+        float ay = ((-friction[i] * velY[i]) + forceY[i]) * invMass[i] + gravity;
+
+        velX[i] += ax * timeStep;
+        velY[i] += ay * timeStep;
+
+        forceX[i] = 0.f;
+        forceY[i] = 0.f;
+    }
+}
+
+static void IntegratePosition_Scalar(
+    float *posX, float *posY, const float *velX, float *velY,
+    float rebond, float timeStep, int first, int last)
+{
+    for (int i = first; i < last; ++i)
+    {
+        if (posY[i] + velY[i] * timeStep <= 0.f)
+        {
+            velY[i] *= rebond;
+        }
+
+        posX[i] += velX[i] * timeStep;
+        posY[i] += velY[i] * timeStep;
+    }
+}
+
+static void AffineTransform_Scalar(
+    const float *inX, const float *inY, float *outX, float *outY,
+    float scaleX, float offsetX, float scaleY, float offsetY, int first, int last)
+{
+    for (int i = first; i < last; ++i)
+    {
+        outX[i] = inX[i] * scaleX + offsetX;
+        outY[i] = inY[i] * scaleY + offsetY;
+    }
+}
+
+#ifdef KERNELS_X86
+
+/// @brief Ajoute aux balles les forces calculées pour count ressorts consécutifs.
+/// L'ordre des accumulations est celui de la version scalaire.
+static void SpringForces_Scatter(
+    const int *ball1, const int *ball2, const float *fx, const float *fy,
+    float *forceX, float *forceY, int count)
+{
+    for (int j = 0; j < count; ++j)
+    {
+        forceX[ball1[j]] += fx[j];
+        forceY[ball1[j]] += fy[j];
+        forceX[ball2[j]] -= fx[j];
+        forceY[ball2[j]] -= fy[j];
+    }
+}
+
+//-------------------------------------------------------------------------------------------------
+// Noyaux SSE2 (4 éléments par instruction)
+
+KERNELS_TARGET("sse2")
+static void SpringForces_SSE2(
+    const float *posX, const float *posY,
+    const int *ball1, const int *ball2, const float *length, const float *stiffness,
+    float *forceX, float *forceY, const int *order, int first, int last)
+{
+    const __m128 zero = _mm_setzero_ps();
+    float fx[4], fy[4];
+    int b1[4], b2[4];
+    int i = first;
+
+    for (; i + 4 <= last; i += 4)
+    {
+        const int *s = order + i;
+        for (int j = 0; j < 4; ++j)
+        {
+            b1[j] = ball1[s[j]];
+            b2[j] = ball2[s[j]];
+        }
+
+        __m128 x1 = _mm_setr_ps(posX[b1[0]], posX[b1[1]], posX[b1[2]], posX[b1[3]]);
+        __m128 y1 = _mm_setr_ps(posY[b1[0]], posY[b1[1]], posY[b1[2]], posY[b1[3]]);
+        __m128 x2 = _mm_setr_ps(posX[b2[0]], posX[b2[1]], posX[b2[2]], posX[b2[3]]);
+        __m128 y2 = _mm_setr_ps(posY[b2[0]], posY[b2[1]], posY[b2[2]], posY[b2[3]]);
+        __m128 k = _mm_setr_ps(stiffness[s[0]], stiffness[s[1]], stiffness[s[2]], stiffness[s[3]]);
+        __m128 l = _mm_setr_ps(length[s[0]], length[s[1]], length[s[2]], length[s[3]]);
+
+        __m128 dx = _mm_sub_ps(x2, x1);
+        __m128 dy = _mm_sub_ps(y2, y1);
+        __m128 distance = _mm_sqrt_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)));
+
+        __m128 scale = _mm_div_ps(_mm_mul_ps(k, _mm_sub_ps(distance, l)), distance);
+        scale = _mm_and_ps(scale, _mm_cmpgt_ps(distance, zero));
+
+        _mm_storeu_ps(fx, _mm_mul_ps(scale, dx));
+        _mm_storeu_ps(fy, _mm_mul_ps(scale, dy));
+        SpringForces_Scatter(b1, b2, fx, fy, forceX, forceY, 4);
+    }
+
+    SpringForces_Scalar(
+        posX, posY, ball1, ball2, length, stiffness, forceX, forceY, order, i, last);
+}
+
+KERNELS_TARGET("sse2")
+static void IntegrateVelocity_SSE2(
+    float *velX, float *velY, float *forceX, float *forceY,
+    const float *invMass, const float *friction, float gravity, float timeStep,
+    int first, int last)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 signMask = _mm_set1_ps(-0.f);
+    const __m128 g = _mm_set1_ps(gravity);
+    const __m128 dt = _mm_set1_ps(timeStep);
+    int i = first;
+
+    for (; i + 4 <= last; i += 4)
+    {
+        __m128 vx = _mm_loadu_ps(velX + i);
+        __m128 vy = _mm_loadu_ps(velY + i);
+        __m128 negFriction = _mm_xor_ps(_mm_loadu_ps(friction + i), signMask);
+        __m128 im = _mm_loadu_ps(invMass + i);
+
+        __m128 ax = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(negFriction, vx), _mm_loadu_ps(forceX + i)), im);
+        __m128 ay = _mm_mul_ps(_mm_add_ps(_mm_mul_ps(negFriction, vy), _mm_loadu_ps(forceY + i)), im);
+        ay = _mm_add_ps(ay, g);
+
+        _mm_storeu_ps(velX + i, _mm_add_ps(vx, _mm_mul_ps(ax, dt)));
+        _mm_storeu_ps(velY + i, _mm_add_ps(vy, _mm_mul_ps(ay, dt)));
+        _mm_storeu_ps(forceX + i, zero);
+        _mm_storeu_ps(forceY + i, zero);
+    }
+
+    IntegrateVelocity_Scalar(
+        velX, velY, forceX, forceY, invMass, friction, gravity, timeStep, i, last);
+}
+
+KERNELS_TARGET("sse2")
+static void IntegratePosition_SSE2(
+    float *posX, float *posY, const float *velX, float *velY,
+    float rebond, float timeStep, int first, int last)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 r = _mm_set1_ps(rebond);
+    const __m128 dt = _mm_set1_ps(timeStep);
+    int i = first;
+
+    for (; i + 4 <= last; i += 4)
+    {
+        __m128 px = _mm_loadu_ps(posX + i);
+        __m128 py = _mm_loadu_ps(posY + i);
+        __m128 vx = _mm_loadu_ps(velX + i);
+        __m128 vy = _mm_loadu_ps(velY + i);
+
+        // Rebond sur le sol
+        __m128 ground = _mm_cmple_ps(_mm_add_ps(py, _mm_mul_ps(vy, dt)), zero);
+        vy = _mm_or_ps(_mm_and_ps(ground, _mm_mul_ps(vy, r)), _mm_andnot_ps(ground, vy));
+
+        _mm_storeu_ps(velY + i, vy);
+        _mm_storeu_ps(posX + i, _mm_add_ps(px, _mm_mul_ps(vx, dt)));
+        _mm_storeu_ps(posY + i, _mm_add_ps(py, _mm_mul_ps(vy, dt)));
+    }
+
+    IntegratePosition_Scalar(posX, posY, velX, velY, rebond, timeStep, i, last);
+}
+
+KERNELS_TARGET("sse2")
+static void AffineTransform_SSE2(
+    const float *inX, const float *inY, float *outX, float *outY,
+    float scaleX, float offsetX, float scaleY, float offsetY, int first, int last)
+{
+    const __m128 sx = _mm_set1_ps(scaleX);
+    const __m128 ox = _mm_set1_ps(offsetX);
+    const __m128 sy = _mm_set1_ps(scaleY);
+    const __m128 oy = _mm_set1_ps(offsetY);
+    int i = first;
+
+    for (; i + 4 <= last; i += 4)
+    {
+        __m128 x = _mm_loadu_ps(inX + i);
+        __m128 y = _mm_loadu_ps(inY + i);
+
+        _mm_storeu_ps(outX + i, _mm_add_ps(_mm_mul_ps(x, sx), ox));
+        _mm_storeu_ps(outY + i, _mm_add_ps(_mm_mul_ps(y, sy), oy));
+    }
+
+    AffineTransform_Scalar(inX, inY, outX, outY, scaleX, offsetX, scaleY, offsetY, i, last);
+}
+
+//-------------------------------------------------------------------------------------------------
+// Noyaux AVX2 (8 éléments par instruction)
+
+KERNELS_TARGET("avx2")
+static void SpringForces_AVX2(
+    const float *posX, const float *posY,
+    const int *ball1, const int *ball2, const float *length, const float *stiffness,
+    float *forceX, float *forceY, const int *order, int first, int last)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    float fx[8], fy[8];
+    int b1[8], b2[8];
+    int i = first;
+
+    for (; i + 8 <= last; i += 8)
+    {
+        __m256i s = _mm256_loadu_si256((const __m256i *)(order + i));
+        __m256i v1 = _mm256_i32gather_epi32(ball1, s, 4);
+        __m256i v2 = _mm256_i32gather_epi32(ball2, s, 4);
+
+        __m256 dx = _mm256_sub_ps(_mm256_i32gather_ps(posX, v2, 4), _mm256_i32gather_ps(posX, v1, 4));
+        __m256 dy = _mm256_sub_ps(_mm256_i32gather_ps(posY, v2, 4), _mm256_i32gather_ps(posY, v1, 4));
+        __m256 distance = _mm256_sqrt_ps(_mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy)));
+
+        __m256 scale = _mm256_mul_ps(
+            _mm256_i32gather_ps(stiffness, s, 4),
+            _mm256_sub_ps(distance, _mm256_i32gather_ps(length, s, 4)));
+        scale = _mm256_div_ps(scale, distance);
+        scale = _mm256_and_ps(scale, _mm256_cmp_ps(distance, zero, _CMP_GT_OQ));
+
+        _mm256_storeu_ps(fx, _mm256_mul_ps(scale, dx));
+        _mm256_storeu_ps(fy, _mm256_mul_ps(scale, dy));
+        _mm256_storeu_si256((__m256i *)b1, v1);
+        _mm256_storeu_si256((__m256i *)b2, v2);
+        SpringForces_Scatter(b1, b2, fx, fy, forceX, forceY, 8);
+    }
+
+    SpringForces_SSE2(
+        posX, posY, ball1, ball2, length, stiffness, forceX, forceY, order, i, last);
+}
+
+KERNELS_TARGET("avx2")
+static void IntegrateVelocity_AVX2(
+    float *velX, float *velY, float *forceX, float *forceY,
+    const float *invMass, const float *friction, float gravity, float timeStep,
+    int first, int last)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 signMask = _mm256_set1_ps(-0.f);
+    const __m256 g = _mm256_set1_ps(gravity);
+    const __m256 dt = _mm256_set1_ps(timeStep);
+    int i = first;
+
+    for (; i + 8 <= last; i += 8)
+    {
+        __m256 vx = _mm256_loadu_ps(velX + i);
+        __m256 vy = _mm256_loadu_ps(velY + i);
+        __m256 negFriction = _mm256_xor_ps(_mm256_loadu_ps(friction + i), signMask);
+        __m256 im = _mm256_loadu_ps(invMass + i);
+
+        __m256 ax = _mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(negFriction, vx), _mm256_loadu_ps(forceX + i)), im);
+        __m256 ay = _mm256_mul_ps(_mm256_add_ps(_mm256_mul_ps(negFriction, vy), _mm256_loadu_ps(forceY + i)), im);
+        ay = _mm256_add_ps(ay, g);
+
+        _mm256_storeu_ps(velX + i, _mm256_add_ps(vx, _mm256_mul_ps(ax, dt)));
+        _mm256_storeu_ps(velY + i, _mm256_add_ps(vy, _mm256_mul_ps(ay, dt)));
+        _mm256_storeu_ps(forceX + i, zero);
+        _mm256_storeu_ps(forceY + i, zero);
+    }
+
+    IntegrateVelocity_SSE2(
+        velX, velY, forceX, forceY, invMass, friction, gravity, timeStep, i, last);
+}
+
+KERNELS_TARGET("avx2")
+static void IntegratePosition_AVX2(
+    float *posX, float *posY, const float *velX, float *velY,
+    float rebond, float timeStep, int first, int last)
+{
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256 r = _mm256_set1_ps(rebond);
+    const __m256 dt = _mm256_set1_ps(timeStep);
+    int i = first;
+
+    for (; i + 8 <= last; i += 8)
+    {
+        __m256 px = _mm256_loadu_ps(posX + i);
+        __m256 py = _mm256_loadu_ps(posY + i);
+        __m256 vx = _mm256_loadu_ps(velX + i);
+        __m256 vy = _mm256_loadu_ps(velY + i);
+
+        // Rebond sur le sol
+        __m256 ground = _mm256_cmp_ps(_mm256_add_ps(py, _mm256_mul_ps(vy, dt)), zero, _CMP_LE_OQ);
+        vy = _mm256_blendv_ps(vy, _mm256_mul_ps(vy, r), ground);
+
+        _mm256_storeu_ps(velY + i, vy);
+        _mm256_storeu_ps(posX + i, _mm256_add_ps(px, _mm256_mul_ps(vx, dt)));
+        _mm256_storeu_ps(posY + i, _mm256_add_ps(py, _mm256_mul_ps(vy, dt)));
+    }
+
+    IntegratePosition_SSE2(posX, posY, velX, velY, rebond, timeStep, i, last);
+}
+
+KERNELS_TARGET("avx2")
+static void AffineTransform_AVX2(
+    const float *inX, const float *inY, float *outX, float *outY,
+    float scaleX, float offsetX, float scaleY, float offsetY, int first, int last)
+{
+    const __m256 sx = _mm256_set1_ps(scaleX);
+    const __m256 ox = _mm256_set1_ps(offsetX);
+    const __m256 sy = _mm256_set1_ps(scaleY);
+    const __m256 oy = _mm256_set1_ps(offsetY);
+    int i = first;
+
+    for (; i + 8 <= last; i += 8)
+    {
+        __m256 x = _mm256_loadu_ps(inX + i);
+        __m256 y = _mm256_loadu_ps(inY + i);
+
+        _mm256_storeu_ps(outX + i, _mm256_add_ps(_mm256_mul_ps(x, sx), ox));
+        _mm256_storeu_ps(outY + i, _mm256_add_ps(_mm256_mul_ps(y, sy), oy));
+    }
+
+    AffineTransform_SSE2(inX, inY, outX, outY, scaleX, offsetX, scaleY, offsetY, i, last);
+}
+
+#endif
+
+//-------------------------------------------------------------------------------------------------
+// Sélection des noyaux
+
+typedef void (*SpringForcesFunc)(
+    const float *, const float *, const int *, const int *, const float *, const float *,
+    float *, float *, const int *, int, int);
+typedef void (*IntegrateVelocityFunc)(
+    float *, float *, float *, float *, const float *, const float *, float, float, int, int);
+typedef void (*IntegratePositionFunc)(
+    float *, float *, const float *, float *, float, float, int, int);
+typedef void (*AffineTransformFunc)(
+    const float *, const float *, float *, float *, float, float, float, float, int, int);
+
+static SimdLevel s_level = SIMD_SCALAR;
+static SpringForcesFunc s_springForces = SpringForces_Scalar;
+static IntegrateVelocityFunc s_integrateVelocity = IntegrateVelocity_Scalar;
+static IntegratePositionFunc s_integratePosition = IntegratePosition_Scalar;
+static AffineTransformFunc s_affineTransform = AffineTransform_Scalar;
+
+/// @brief Renvoie le meilleur jeu d'instructions supporté par le processeur.
+static SimdLevel Kernels_GetSupportedLevel()
+{
+#ifdef KERNELS_X86
+    if (SDL_HasAVX2())
+        return SIMD_AVX2;
+    if (SDL_HasSSE2())
+        return SIMD_SSE2;
+#endif
+    return SIMD_SCALAR;
+}
+
+void Kernels_Init()
+{
+    Kernels_SetLevel(SIMD_AVX2);
+}
+
+SimdLevel Kernels_SetLevel(SimdLevel level)
+{
+    SimdLevel supported = Kernels_GetSupportedLevel();
+    if (level > supported)
+        level = supported;
+
+    s_level = level;
+    switch (level)
+    {
+#ifdef KERNELS_X86
+    case SIMD_AVX2:
+        s_springForces = SpringForces_AVX2;
+        s_integrateVelocity = IntegrateVelocity_AVX2;
+        s_integratePosition = IntegratePosition_AVX2;
+        s_affineTransform = AffineTransform_AVX2;
+        break;
+
+    case SIMD_SSE2:
+        s_springForces = SpringForces_SSE2;
+        s_integrateVelocity = IntegrateVelocity_SSE2;
+        s_integratePosition = IntegratePosition_SSE2;
+        s_affineTransform = AffineTransform_SSE2;
+        break;
+#endif
+
+    default:
+        s_level = SIMD_SCALAR;
+        s_springForces = SpringForces_Scalar;
+        s_integrateVelocity = IntegrateVelocity_Scalar;
+        s_integratePosition = IntegratePosition_Scalar;
+        s_affineTransform = AffineTransform_Scalar;
+        break;
+    }
+
+    return s_level;
+}
+
+void Kernels_SpringForces(
+    const float *posX, const float *posY,
+    const int *ball1, const int *ball2, const float *length, const float *stiffness,
+    float *forceX, float *forceY, const int *order, int first, int last)
+{
+    s_springForces(
+        posX, posY, ball1, ball2, length, stiffness, forceX, forceY, order, first, last);
+}
+
+void Kernels_IntegrateVelocity(
+    float *velX, float *velY, float *forceX, float *forceY,
+    const float *invMass, const float *friction, float gravity, float timeStep,
+    int first, int last)
+{
+    s_integrateVelocity(
+        velX, velY, forceX, forceY, invMass, friction, gravity, timeStep, first, last);
+}
+
+void Kernels_IntegratePosition(
+    float *posX, float *posY, const float *velX, float *velY,
+    float rebond, float timeStep, int first, int last)
+{
+    s_integratePosition(posX, posY, velX, velY, rebond, timeStep, first, last);
+}
+
+void Kernels_AffineTransform(
+    const float *inX, const float *inY, float *outX, float *outY,
+    float scaleX, float offsetX, float scaleY, float offsetY, int first, int last)
+{
+    s_affineTransform(inX, inY, outX, outY, scaleX, offsetX, scaleY, offsetY, first, last);
+}
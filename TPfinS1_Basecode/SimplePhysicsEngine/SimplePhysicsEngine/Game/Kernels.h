@@ -0,0 +1,94 @@
+﻿#ifndef _KERNELS_H_
+#define _KERNELS_H_
+
+/// @file kernels.h
+/// @defgroup Physics
+/// @{
+
+#include "../Settings.h"
+
+/// @brief Jeux d'instructions pouvant être utilisés par les noyaux de calcul.
+typedef enum SimdLevel_e
+{
+    /// @brief Code C portable, une balle (ou un ressort) à la fois.
+    SIMD_SCALAR = 0,
+
+    /// @brief SSE2, 4 balles (ou ressorts) par instruction.
+    SIMD_SSE2,
+
+    /// @brief AVX2, 8 balles (ou ressorts) par instruction.
+    SIMD_AVX2,
+} SimdLevel;
+
+/// @brief Détecte (avec CPUID) le meilleur jeu d'instructions disponible et l'utilise.
+/// Tant que cette fonction n'a pas été appelée, les noyaux scalaires sont utilisés.
+void Kernels_Init();
+
+/// @brief Force l'utilisation d'un jeu d'instructions.
+/// Si le processeur ne le supporte pas, le meilleur jeu disponible inférieur est utilisé.
+/// Tous les jeux d'instructions produisent exactement les mêmes résultats.
+/// @param[in] level le jeu d'instructions souhaité.
+/// @return Le jeu d'instructions effectivement utilisé.
+SimdLevel Kernels_SetLevel(SimdLevel level);
+
+/// @brief Calcule la force exercée par les ressorts order[first], ..., order[last - 1]
+/// (loi de Hooke) et l'ajoute aux forces accumulées par leurs deux balles.
+/// Si aucune balle n'est partagée par deux de ces ressorts (ressorts d'une même couleur),
+/// des intervalles disjoints peuvent être traités en parallèle.
+/// @param[in] posX, posY les positions des balles.
+/// @param[in] ball1, ball2 les indices des balles de chaque ressort.
+/// @param[in] length les longueurs au repos des ressorts.
+/// @param[in] stiffness les raideurs des ressorts.
+/// @param[in,out] forceX, forceY les forces accumulées par les balles.
+/// @param[in] order les indices des ressorts à traiter.
+/// @param[in] first la position du premier ressort dans order.
+/// @param[in] last la position suivant celle du dernier ressort dans order.
+void Kernels_SpringForces(
+    const float *posX, const float *posY,
+    const int *ball1, const int *ball2, const float *length, const float *stiffness,
+    float *forceX, float *forceY, const int *order, int first, int last);
+
+/// @brief Met à jour la vitesse des balles d'indices [first, last[ (Euler semi-implicite)
+/// puis remet à zéro leurs forces accumulées.
+/// @param[in,out] velX, velY les vitesses des balles.
+/// @param[in,out] forceX, forceY les forces accumulées par les balles.
+/// @param[in] invMass les inverses des masses des balles.
+/// @param[in] friction les coefficients de friction des balles.
+/// @param[in] gravity l'accélération de la pesanteur.
+/// @param[in] timeStep le pas de temps.
+/// @param[in] first l'indice de la première balle.
+/// @param[in] last l'indice suivant la dernière balle.
+void Kernels_IntegrateVelocity(
+    float *velX, float *velY, float *forceX, float *forceY,
+    const float *invMass, const float *friction, float gravity, float timeStep,
+    int first, int last);
+
+/// @brief Met à jour la position des balles d'indices [first, last[ en fonction de leur vitesse.
+/// La vitesse verticale est multipliée par rebond si la balle va traverser le sol (y = 0).
+/// @param[in,out] posX, posY les positions des balles.
+/// @param[in] velX les vitesses horizontales des balles.
+/// @param[in,out] velY les vitesses verticales des balles.
+/// @param[in] rebond le coefficient de rebond sur le sol.
+/// @param[in] timeStep le pas de temps.
+/// @param[in] first l'indice de la première balle.
+/// @param[in] last l'indice suivant la dernière balle.
+void Kernels_IntegratePosition(
+    float *posX, float *posY, const float *velX, float *velY,
+    float rebond, float timeStep, int first, int last);
+
+/// @brief Applique une transformation affine (sans rotation) aux points d'indices [first, last[ :
+/// outX = inX * scaleX + offsetX et outY = inY * scaleY + offsetY.
+/// Les tableaux de sortie peuvent être les tableaux d'entrée (transformation sur place).
+/// @param[in] inX, inY les coordonnées des points.
+/// @param[out] outX, outY les coordonnées transformées.
+/// @param[in] scaleX, offsetX l'échelle et la translation des abscisses.
+/// @param[in] scaleY, offsetY l'échelle et la translation des ordonnées.
+/// @param[in] first l'indice du premier point.
+/// @param[in] last l'indice suivant le dernier point.
+void Kernels_AffineTransform(
+    const float *inX, const float *inY, float *outX, float *outY,
+    float scaleX, float offsetX, float scaleY, float offsetY, int first, int last);
+
+/// @}
+
+#endif
@@ -0,0 +1,220 @@
+﻿#include "Lod.h"
+#include "Scene.h"
+
+Lod *Lod_New()
+{
+    Lod *lod = NULL;
+
+    lod = (Lod *)calloc(1, sizeof(Lod));
+    if (!lod) goto ERROR_LABEL;
+
+    lod->m_linesScale = LOD_LINES_SCALE;
+    lod->m_heatmapScale = LOD_HEATMAP_SCALE;
+    lod->m_heatmapTile = LOD_HEATMAP_TILE;
+
+    return lod;
+
+ERROR_LABEL:
+    printf("ERROR - Lod_New()\n");
+    assert(false);
+    Lod_Free(lod);
+    return NULL;
+}
+
+void Lod_Free(Lod *lod)
+{
+    if (!lod) return;
+
+    free(lod->m_lineX);
+    free(lod->m_lineY);
+    free(lod->m_points);
+    free(lod->m_tiles);
+    free(lod->m_rects);
+
+    memset(lod, 0, sizeof(Lod));
+    free(lod);
+}
+
+/// @brief Augmente la capacité des tableaux de points.
+static int Lod_ReservePoints(Lod *lod, int capacity)
+{
+    if (capacity <= lod->m_pointCapacity)
+        return EXIT_SUCCESS;
+
+    capacity = SDL_max(capacity, 2 * lod->m_pointCapacity);
+
+    float *newX = (float *)realloc(lod->m_lineX, capacity * sizeof(float));
+    if (!newX) goto ERROR_LABEL;
+    lod->m_lineX = newX;
+
+    float *newY = (float *)realloc(lod->m_lineY, capacity * sizeof(float));
+    if (!newY) goto ERROR_LABEL;
+    lod->m_lineY = newY;
+
+    SDL_FPoint *newPoints = (SDL_FPoint *)realloc(lod->m_points, capacity * sizeof(SDL_FPoint));
+    if (!newPoints) goto ERROR_LABEL;
+    lod->m_points = newPoints;
+
+    lod->m_pointCapacity = capacity;
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - Lod_ReservePoints()\n");
+    return EXIT_FAILURE;
+}
+
+/// @brief Augmente la capacité des tableaux de tuiles.
+static int Lod_ReserveTiles(Lod *lod, int capacity)
+{
+    if (capacity <= lod->m_tileCapacity)
+        return EXIT_SUCCESS;
+
+    int *newTiles = (int *)realloc(lod->m_tiles, capacity * sizeof(int));
+    if (!newTiles) goto ERROR_LABEL;
+    lod->m_tiles = newTiles;
+
+    SDL_FRect *newRects = (SDL_FRect *)realloc(lod->m_rects, capacity * sizeof(SDL_FRect));
+    if (!newRects) goto ERROR_LABEL;
+    lod->m_rects = newRects;
+
+    lod->m_tileCapacity = capacity;
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - Lod_ReserveTiles()\n");
+    return EXIT_FAILURE;
+}
+
+LodLevel Lod_GetLevel(Lod *lod, Camera *camera)
+{
+    float scale = fabsf(camera->m_scaleX);
+
+    if (scale < lod->m_heatmapScale)
+        return LOD_HEATMAP;
+    if (scale < lod->m_linesScale)
+        return LOD_LINES;
+    return LOD_SPRITES;
+}
+
+int Lod_AddLine(Lod *lod, Vec2 start, Vec2 end)
+{
+    int index = 2 * lod->m_lineCount;
+    if (Lod_ReservePoints(lod, index + 2) == EXIT_FAILURE)
+        return EXIT_FAILURE;
+
+    lod->m_lineX[index] = start.x;
+    lod->m_lineY[index] = start.y;
+    lod->m_lineX[index + 1] = end.x;
+    lod->m_lineY[index + 1] = end.y;
+    lod->m_lineCount++;
+
+    return EXIT_SUCCESS;
+}
+
+void Lod_RenderLines(Lod *lod, Scene *scene, float *posX, float *posY, int count)
+{
+    Camera *camera = Scene_GetCamera(scene);
+    int pointCount = 2 * lod->m_lineCount;
+
+    // Les ressorts, sous les balles
+    Camera_WorldToViewArray(
+        camera, lod->m_lineX, lod->m_lineY, lod->m_lineX, lod->m_lineY, pointCount);
+    for (int i = 0; i < pointCount; ++i)
+    {
+        lod->m_points[i].x = lod->m_lineX[i];
+        lod->m_points[i].y = lod->m_lineY[i];
+    }
+    SpriteBatch_DrawLines(
+        scene->m_batch, lod->m_points, lod->m_lineCount, Color_Set(201, 152, 84, 255));
+    lod->m_lineCount = 0;
+
+    // Les balles
+    if (Lod_ReservePoints(lod, count) == EXIT_FAILURE)
+        return;
+
+    Camera_WorldToViewArray(camera, posX, posY, posX, posY, count);
+    for (int i = 0; i < count; ++i)
+    {
+        lod->m_points[i].x = posX[i];
+        lod->m_points[i].y = posY[i];
+    }
+    SpriteBatch_DrawPoints(scene->m_batch, lod->m_points, count, Color_Set(43, 38, 61, 255));
+}
+
+void Lod_RenderHeatmap(Lod *lod, Scene *scene, float *posX, float *posY, int count)
+{
+    Camera *camera = Scene_GetCamera(scene);
+    int tile = SDL_max(lod->m_heatmapTile, 1);
+    int columns = (camera->m_width + tile - 1) / tile;
+    int rows = (camera->m_height + tile - 1) / tile;
+    int tileCount = columns * rows;
+
+    if (Lod_ReserveTiles(lod, tileCount) == EXIT_FAILURE)
+        return;
+
+    // Compte les balles de chaque tuile
+    int *tiles = lod->m_tiles;
+    memset(tiles, 0, tileCount * sizeof(int));
+
+    Camera_WorldToViewArray(camera, posX, posY, posX, posY, count);
+    float invTile = 1.0f / (float)tile;
+    for (int i = 0; i < count; ++i)
+    {
+        int tx = (int)floorf(posX[i] * invTile);
+        int ty = (int)floorf(posY[i] * invTile);
+        if ((tx < 0) || (tx >= columns) || (ty < 0) || (ty >= rows))
+            continue;
+
+        tiles[ty * columns + tx]++;
+    }
+
+    // Remplace le nombre de balles de chaque tuile par sa couleur (-1 pour une tuile vide)
+    // et range les tuiles par couleur (tri par comptage)
+    int levelStart[LOD_HEATMAP_LEVELS + 1] = { 0 };
+    for (int i = 0; i < tileCount; ++i)
+    {
+        int n = tiles[i];
+        int level = -1;
+        while ((n > 0) && (level < LOD_HEATMAP_LEVELS - 1))
+        {
+            n >>= 1;
+            level++;
+        }
+        tiles[i] = level;
+
+        if (level >= 0)
+            levelStart[level + 1]++;
+    }
+    for (int l = 0; l < LOD_HEATMAP_LEVELS; ++l)
+    {
+        levelStart[l + 1] += levelStart[l];
+    }
+
+    int levelEnd[LOD_HEATMAP_LEVELS];
+    memcpy(levelEnd, levelStart, sizeof(levelEnd));
+    for (int i = 0; i < tileCount; ++i)
+    {
+        if (tiles[i] < 0)
+            continue;
+
+        SDL_FRect *rect = &lod->m_rects[levelEnd[tiles[i]]++];
+        rect->x = (float)((i % columns) * tile);
+        rect->y = (float)((i / columns) * tile);
+        rect->w = (float)tile;
+        rect->h = (float)tile;
+    }
+
+    // Dégradé du violet (peu de balles) au jaune (beaucoup de balles)
+    for (int l = 0; l < LOD_HEATMAP_LEVELS; ++l)
+    {
+        float t = (float)l / (float)(LOD_HEATMAP_LEVELS - 1);
+        Color color = Color_Set(
+            (int)(80.f + t * 175.f), (int)(40.f + t * 190.f), (int)(120.f - t * 40.f), 255
+        );
+        SpriteBatch_FillRects(
+            scene->m_batch, &lod->m_rects[levelStart[l]], levelStart[l + 1] - levelStart[l], color
+        );
+    }
+}
@@ -0,0 +1,121 @@
+﻿#ifndef _LOD_H_
+#define _LOD_H_
+
+/// @file lod.h
+/// @defgroup Scene
+/// @{
+
+#include "../Settings.h"
+#include "../Utils/Vector.h"
+
+typedef struct Scene_s Scene;
+typedef struct Camera_s Camera;
+
+/// @brief Echelle (exprimée en pixels par m) en dessous de laquelle les ressorts sont dessinés
+/// par des segments et les balles par des points.
+#define LOD_LINES_SCALE 20.0f
+
+/// @brief Echelle (exprimée en pixels par m) en dessous de laquelle la scène est dessinée par
+/// une carte de densité.
+#define LOD_HEATMAP_SCALE 2.0f
+
+/// @brief Côté (exprimé en pixels) d'une tuile de la carte de densité.
+#define LOD_HEATMAP_TILE 8
+
+/// @brief Nombre de couleurs de la carte de densité.
+/// Une tuile contenant n balles reçoit la couleur floor(log2(n)) (bornée).
+#define LOD_HEATMAP_LEVELS 8
+
+/// @brief Niveau de détail du rendu des balles et des ressorts.
+typedef enum LodLevel_e
+{
+    /// @brief Sprites texturés.
+    LOD_SPRITES,
+
+    /// @brief Ressorts dessinés par des segments et balles dessinées par des points.
+    LOD_LINES,
+
+    /// @brief Nombre de balles par tuile de l'écran (les ressorts ne sont pas dessinés).
+    LOD_HEATMAP,
+} LodLevel;
+
+/// @brief Politique de niveau de détail et tableaux temporaires des rendus simplifiés.
+/// Le niveau est choisi d'après l'échelle de la caméra (nombre de pixels par m) : lorsque les
+/// balles ne font que quelques pixels à l'écran, les textures n'apportent rien et le rendu
+/// d'une scène entière doit rester interactif.
+typedef struct Lod_s
+{
+    /// @brief Echelle (exprimée en pixels par m) en dessous de laquelle LOD_LINES est utilisé.
+    float m_linesScale;
+
+    /// @brief Echelle (exprimée en pixels par m) en dessous de laquelle LOD_HEATMAP est utilisé.
+    float m_heatmapScale;
+
+    /// @brief Côté (exprimé en pixels) d'une tuile de la carte de densité.
+    int m_heatmapTile;
+
+    /// @brief Extrémités des segments ajoutés depuis le dernier rendu (deux par segment),
+    /// d'abord dans le référentiel monde puis dans le référentiel caméra.
+    float *m_lineX, *m_lineY;
+
+    /// @brief Nombre de segments ajoutés depuis le dernier rendu.
+    int m_lineCount;
+
+    /// @brief Points envoyés au moteur de rendu.
+    SDL_FPoint *m_points;
+
+    /// @brief Nombre maximal de points avant d'effectuer une réallocation mémoire.
+    int m_pointCapacity;
+
+    /// @brief Nombre de balles dans chaque tuile de la carte de densité.
+    int *m_tiles;
+
+    /// @brief Rectangles des tuiles non vides, rangés par couleur.
+    SDL_FRect *m_rects;
+
+    /// @brief Nombre maximal de tuiles avant d'effectuer une réallocation mémoire.
+    int m_tileCapacity;
+} Lod;
+
+/// @brief Crée une politique de niveau de détail avec les seuils par défaut.
+/// @return La politique créée ou NULL en cas d'erreur.
+Lod *Lod_New();
+
+/// @brief Détruit une politique préalablement allouée avec Lod_New().
+/// @param[in,out] lod la politique à détruire.
+void Lod_Free(Lod *lod);
+
+/// @brief Renvoie le niveau de détail à utiliser avec une caméra.
+/// @param[in] lod la politique.
+/// @param[in] camera la caméra.
+/// @return Le niveau de détail.
+LodLevel Lod_GetLevel(Lod *lod, Camera *camera);
+
+/// @brief Ajoute un segment à dessiner par Lod_RenderLines().
+/// @param[in,out] lod la politique.
+/// @param[in] start le début du segment dans le référentiel monde.
+/// @param[in] end la fin du segment dans le référentiel monde.
+/// @return EXIT_SUCCESS ou EXIT_FAILURE.
+int Lod_AddLine(Lod *lod, Vec2 start, Vec2 end);
+
+/// @brief Dessine les segments ajoutés depuis le dernier rendu puis des balles par des points.
+/// @param[in,out] lod la politique.
+/// @param[in] scene la scène.
+/// @param[in,out] posX, posY les positions des balles dans le référentiel monde
+/// (remplacées par leurs positions dans le référentiel caméra).
+/// @param[in] count le nombre de balles.
+void Lod_RenderLines(Lod *lod, Scene *scene, float *posX, float *posY, int count);
+
+/// @brief Dessine la carte de densité des balles : l'écran est découpé en tuiles de
+/// m_heatmapTile pixels et chaque tuile non vide est colorée selon son nombre de balles.
+/// Les tuiles sont regroupées par couleur : au plus LOD_HEATMAP_LEVELS appels au moteur de rendu.
+/// @param[in,out] lod la politique.
+/// @param[in] scene la scène.
+/// @param[in,out] posX, posY les positions des balles dans le référentiel monde
+/// (remplacées par leurs positions dans le référentiel caméra).
+/// @param[in] count le nombre de balles.
+void Lod_RenderHeatmap(Lod *lod, Scene *scene, float *posX, float *posY, int count);
+
+/// @}
+
+#endif
@@ -0,0 +1,291 @@
+﻿#include "Particles.h"
+#include "../Utils/Tools.h"
+
+#define BALL_INDEX_MASK ((1u << BALL_INDEX_BITS) - 1u)
+#define BALL_GENERATION_MAX ((1u << (32 - BALL_INDEX_BITS)) - 1u)
+
+/// @brief Construit un identifiant à partir d'un emplacement et d'une génération.
+static BallId Particles_MakeId(int slot, uint32_t generation)
+{
+    return (BallId)((generation << BALL_INDEX_BITS) | (uint32_t)slot);
+}
+
+Particles *Particles_New(int capacity)
+{
+    Particles *particles = NULL;
+
+    particles = (Particles *)calloc(1, sizeof(Particles));
+    if (!particles) goto ERROR_LABEL;
+
+    particles->m_freeSlot = -1;
+
+    int exitStatus = Particles_Reserve(particles, capacity);
+    if (exitStatus == EXIT_FAILURE) goto ERROR_LABEL;
+
+    return particles;
+
+ERROR_LABEL:
+    printf("ERROR - Particles_New()\n");
+    assert(false);
+    Particles_Free(particles);
+    return NULL;
+}
+
+void Particles_Free(Particles *particles)
+{
+    if (!particles) return;
+
+    free(particles->m_posX);
+    free(particles->m_posY);
+    free(particles->m_prevX);
+    free(particles->m_prevY);
+    free(particles->m_velX);
+    free(particles->m_velY);
+    free(particles->m_invMass);
+    free(particles->m_friction);
+    free(particles->m_forceX);
+    free(particles->m_forceY);
+    free(particles->m_ids);
+    free(particles->m_slotIndex);
+    free(particles->m_slotGeneration);
+
+    memset(particles, 0, sizeof(Particles));
+    free(particles);
+}
+
+int Particles_Reserve(Particles *particles, int capacity)
+{
+    if (capacity <= particles->m_capacity)
+        return EXIT_SUCCESS;
+    if (capacity > BALL_MAX_COUNT)
+        capacity = BALL_MAX_COUNT;
+    if (capacity <= particles->m_capacity)
+        goto ERROR_LABEL;
+
+    if (Tools_Realloc((void **)&particles->m_posX, capacity, sizeof(float)) == EXIT_FAILURE
+        || Tools_Realloc((void **)&particles->m_posY, capacity, sizeof(float)) == EXIT_FAILURE
+        || Tools_Realloc((void **)&particles->m_prevX, capacity, sizeof(float)) == EXIT_FAILURE
+        || Tools_Realloc((void **)&particles->m_prevY, capacity, sizeof(float)) == EXIT_FAILURE
+        || Tools_Realloc((void **)&particles->m_velX, capacity, sizeof(float)) == EXIT_FAILURE
+        || Tools_Realloc((void **)&particles->m_velY, capacity, sizeof(float)) == EXIT_FAILURE
+        || Tools_Realloc((void **)&particles->m_invMass, capacity, sizeof(float)) == EXIT_FAILURE
+        || Tools_Realloc((void **)&particles->m_friction, capacity, sizeof(float)) == EXIT_FAILURE
+        || Tools_Realloc((void **)&particles->m_forceX, capacity, sizeof(float)) == EXIT_FAILURE
+        || Tools_Realloc((void **)&particles->m_forceY, capacity, sizeof(float)) == EXIT_FAILURE
+        || Tools_Realloc((void **)&particles->m_ids, capacity, sizeof(BallId)) == EXIT_FAILURE)
+        goto ERROR_LABEL;
+
+    particles->m_capacity = capacity;
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - Particles_Reserve()\n");
+    return EXIT_FAILURE;
+}
+
+/// @brief Prend un nouvel emplacement dans la table des identifiants, en l'agrandissant si
+/// nécessaire.
+/// @return L'emplacement ou -1 si toute la table a été utilisée.
+static int Particles_NewSlot(Particles *particles)
+{
+    if (particles->m_slotCount >= particles->m_slotCapacity)
+    {
+        if (particles->m_slotCapacity >= BALL_MAX_COUNT)
+            goto ERROR_LABEL;
+
+        int capacity = particles->m_slotCapacity > 0
+            ? particles->m_slotCapacity << 1 : SDL_max(particles->m_capacity, 1 << 10);
+        capacity = SDL_min(capacity, BALL_MAX_COUNT);
+
+        if (Tools_Realloc((void **)&particles->m_slotIndex, capacity, sizeof(int)) == EXIT_FAILURE
+            || Tools_Realloc(
+                (void **)&particles->m_slotGeneration, capacity, sizeof(uint32_t)) == EXIT_FAILURE)
+            goto ERROR_LABEL;
+
+        particles->m_slotCapacity = capacity;
+    }
+
+    int slot = particles->m_slotCount++;
+    particles->m_slotGeneration[slot] = 1;
+
+    return slot;
+
+ERROR_LABEL:
+    printf("ERROR - Particles_NewSlot()\n");
+    return -1;
+}
+
+BallId Particles_Add(Particles *particles, Vec2 position, float mass, float friction)
+{
+    if (particles->m_count >= particles->m_capacity)
+    {
+        int capacity = particles->m_capacity > 0 ? particles->m_capacity << 1 : 1 << 10;
+        int exitStatus = Particles_Reserve(particles, capacity);
+        if (exitStatus == EXIT_FAILURE) goto ERROR_LABEL;
+    }
+
+    // Réutilise un emplacement libre ou en prend un nouveau
+    int slot = particles->m_freeSlot;
+    if (slot >= 0)
+    {
+        particles->m_freeSlot = particles->m_slotIndex[slot];
+    }
+    else
+    {
+        slot = Particles_NewSlot(particles);
+        if (slot < 0) goto ERROR_LABEL;
+    }
+
+    int index = particles->m_count;
+    particles->m_count++;
+
+    particles->m_slotIndex[slot] = index;
+    particles->m_ids[index] = Particles_MakeId(slot, particles->m_slotGeneration[slot]);
+
+    particles->m_posX[index] = position.x;
+    particles->m_posY[index] = position.y;
+    particles->m_prevX[index] = position.x;
+    particles->m_prevY[index] = position.y;
+    particles->m_velX[index] = 0.f;
+    particles->m_velY[index] = 0.f;
+    particles->m_invMass[index] = 1.f / mass;
+    particles->m_friction[index] = friction;
+    particles->m_forceX[index] = 0.f;
+    particles->m_forceY[index] = 0.f;
+
+    return particles->m_ids[index];
+
+ERROR_LABEL:
+    printf("ERROR - Particles_Add()\n");
+    return BALL_NONE;
+}
+
+void Particles_Remove(Particles *particles, int index)
+{
+    int last = particles->m_count - 1;
+
+    if (index < 0 || index > last)
+        return;
+
+    // Libère l'emplacement de l'identifiant (la génération suivante invalide l'identifiant).
+    // Un emplacement dont toutes les générations ont été utilisées est retiré : le réutiliser
+    // rendrait de nouveau valide un ancien identifiant.
+    int slot = (int)(particles->m_ids[index] & BALL_INDEX_MASK);
+    uint32_t generation = particles->m_slotGeneration[slot] + 1;
+    if (generation > BALL_GENERATION_MAX)
+    {
+        particles->m_slotGeneration[slot] = 0;
+        particles->m_slotIndex[slot] = -1;
+    }
+    else
+    {
+        particles->m_slotGeneration[slot] = generation;
+        particles->m_slotIndex[slot] = particles->m_freeSlot;
+        particles->m_freeSlot = slot;
+    }
+
+    // Copie la dernière balle à la place de la balle supprimée
+    particles->m_posX[index] = particles->m_posX[last];
+    particles->m_posY[index] = particles->m_posY[last];
+    particles->m_prevX[index] = particles->m_prevX[last];
+    particles->m_prevY[index] = particles->m_prevY[last];
+    particles->m_velX[index] = particles->m_velX[last];
+    particles->m_velY[index] = particles->m_velY[last];
+    particles->m_invMass[index] = particles->m_invMass[last];
+    particles->m_friction[index] = particles->m_friction[last];
+    particles->m_forceX[index] = particles->m_forceX[last];
+    particles->m_forceY[index] = particles->m_forceY[last];
+    particles->m_ids[index] = particles->m_ids[last];
+
+    if (index != last)
+    {
+        int lastSlot = (int)(particles->m_ids[index] & BALL_INDEX_MASK);
+        particles->m_slotIndex[lastSlot] = index;
+    }
+
+    particles->m_count--;
+}
+
+/// @brief Réordonne les éléments [first, count[ d'un tableau d'éléments de 32 bits.
+static void Particles_Permute32(
+    void *array, int first, const int *order, uint32_t *scratch, int count)
+{
+    uint32_t *values = (uint32_t *)array;
+    for (int i = first; i < count; ++i)
+    {
+        scratch[i - first] = values[order[i]];
+    }
+    memcpy(values + first, scratch, (count - first) * sizeof(uint32_t));
+}
+
+void Particles_Permute(Particles *particles, int first, const int *order, void *scratch)
+{
+    int count = particles->m_count;
+
+    Particles_Permute32(particles->m_posX, first, order, scratch, count);
+    Particles_Permute32(particles->m_posY, first, order, scratch, count);
+    Particles_Permute32(particles->m_prevX, first, order, scratch, count);
+    Particles_Permute32(particles->m_prevY, first, order, scratch, count);
+    Particles_Permute32(particles->m_velX, first, order, scratch, count);
+    Particles_Permute32(particles->m_velY, first, order, scratch, count);
+    Particles_Permute32(particles->m_invMass, first, order, scratch, count);
+    Particles_Permute32(particles->m_friction, first, order, scratch, count);
+    Particles_Permute32(particles->m_forceX, first, order, scratch, count);
+    Particles_Permute32(particles->m_forceY, first, order, scratch, count);
+    Particles_Permute32(particles->m_ids, first, order, scratch, count);
+
+    // Met à jour la table des identifiants
+    for (int i = first; i < count; ++i)
+    {
+        int slot = (int)(particles->m_ids[i] & BALL_INDEX_MASK);
+        particles->m_slotIndex[slot] = i;
+    }
+}
+
+Vec2 Particles_GetPosition(Particles *particles, int index)
+{
+    return Vec2_Set(particles->m_posX[index], particles->m_posY[index]);
+}
+
+void Particles_SetPosition(Particles *particles, int index, Vec2 position)
+{
+    particles->m_posX[index] = position.x;
+    particles->m_posY[index] = position.y;
+    particles->m_prevX[index] = position.x;
+    particles->m_prevY[index] = position.y;
+}
+
+void Particles_SavePositions(Particles *particles, int first, int last)
+{
+    int count = last - first;
+    memcpy(particles->m_prevX + first, particles->m_posX + first, count * sizeof(float));
+    memcpy(particles->m_prevY + first, particles->m_posY + first, count * sizeof(float));
+}
+
+Vec2 Particles_GetVelocity(Particles *particles, int index)
+{
+    return Vec2_Set(particles->m_velX[index], particles->m_velY[index]);
+}
+
+int Particles_GetIndex(Particles *particles, BallId id)
+{
+    int slot = (int)(id & BALL_INDEX_MASK);
+    uint32_t generation = id >> BALL_INDEX_BITS;
+
+    if (id == BALL_NONE || slot >= particles->m_slotCount
+        || particles->m_slotGeneration[slot] != generation)
+        return -1;
+
+    return particles->m_slotIndex[slot];
+}
+
+bool Particles_IsValid(Particles *particles, BallId id)
+{
+    return Particles_GetIndex(particles, id) >= 0;
+}
+
+BallId Particles_GetId(Particles *particles, int index)
+{
+    return particles->m_ids[index];
+}
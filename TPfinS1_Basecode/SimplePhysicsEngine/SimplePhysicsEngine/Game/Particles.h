@@ -0,0 +1,178 @@
+﻿#ifndef _PARTICLES_H_
+#define _PARTICLES_H_
+
+/// @file particles.h
+/// @defgroup Physics
+/// @{
+
+#include "../Settings.h"
+#include "../Utils/Vector.h"
+
+/// @brief Identifiant stable d'une balle.
+/// Il s'agit d'une poignée générationnelle sur 32 bits : les BALL_INDEX_BITS bits de poids faible
+/// désignent un emplacement dans la table des identifiants et les bits de poids fort la génération
+/// de cet emplacement. Un identifiant reste valide tant que la balle existe, même si la balle est
+/// déplacée dans les tableaux ; il devient invalide dès que la balle est supprimée.
+typedef uint32_t BallId;
+
+/// @brief Nombre de bits de l'identifiant réservés à l'emplacement.
+#define BALL_INDEX_BITS 22
+
+/// @brief Nombre maximal de balles simultanément présentes.
+#define BALL_MAX_COUNT (1 << BALL_INDEX_BITS)
+
+/// @brief Identifiant ne désignant aucune balle.
+#define BALL_NONE ((BallId)0)
+
+/// @brief Stockage des balles sous forme de structure de tableaux (SoA).
+/// Chaque grandeur physique est rangée dans un tableau contigu indexé par l'indice de la balle,
+/// ce qui permet aux boucles du moteur physique de parcourir une mémoire dense.
+/// La topologie (ressorts) est stockée à part, dans la scène.
+typedef struct Particles_s
+{
+    /// @brief Abscisses des positions des balles.
+    float *m_posX;
+
+    /// @brief Ordonnées des positions des balles.
+    float *m_posY;
+
+    /// @brief Abscisses des positions des balles au début du dernier pas de temps.
+    /// Le rendu interpole entre ces positions et les positions courantes.
+    float *m_prevX;
+
+    /// @brief Ordonnées des positions des balles au début du dernier pas de temps.
+    float *m_prevY;
+
+    /// @brief Abscisses des vitesses des balles.
+    float *m_velX;
+
+    /// @brief Ordonnées des vitesses des balles.
+    float *m_velY;
+
+    /// @brief Inverses des masses des balles (exprimées en kg^-1).
+    float *m_invMass;
+
+    /// @brief Coefficients de friction des balles.
+    float *m_friction;
+
+    /// @brief Abscisses des forces accumulées pendant le pas de temps courant.
+    float *m_forceX;
+
+    /// @brief Ordonnées des forces accumulées pendant le pas de temps courant.
+    float *m_forceY;
+
+    /// @brief Identifiants des balles.
+    BallId *m_ids;
+
+    /// @brief Pour chaque emplacement de la table des identifiants, l'indice de la balle associée
+    /// ou, si l'emplacement est libre, l'emplacement libre suivant (-1 en fin de liste).
+    int *m_slotIndex;
+
+    /// @brief Génération courante de chaque emplacement de la table des identifiants
+    /// (0 pour un emplacement retiré, dont toutes les générations ont été utilisées).
+    uint32_t *m_slotGeneration;
+
+    /// @brief Nombre d'emplacements utilisés au moins une fois dans la table des identifiants.
+    int m_slotCount;
+
+    /// @brief Nombre maximal d'emplacements avant d'effectuer une réallocation mémoire.
+    /// Les emplacements retirés n'étant jamais réutilisés, la table peut dépasser m_capacity.
+    int m_slotCapacity;
+
+    /// @brief Premier emplacement libre de la table des identifiants (-1 si aucun).
+    int m_freeSlot;
+
+    /// @brief Nombre de balles stockées.
+    int m_count;
+
+    /// @brief Nombre maximal de balles avant d'effectuer une réallocation mémoire.
+    int m_capacity;
+} Particles;
+
+/// @brief Crée un stockage de balles vide.
+/// @param[in] capacity la capacité initiale.
+/// @return Le stockage créé ou NULL en cas d'erreur.
+Particles *Particles_New(int capacity);
+
+/// @brief Détruit un stockage préalablement alloué avec Particles_New().
+/// @param[in,out] particles le stockage à détruire.
+void Particles_Free(Particles *particles);
+
+/// @brief Augmente la capacité du stockage si nécessaire.
+/// @param[in,out] particles le stockage.
+/// @param[in] capacity la capacité minimale souhaitée.
+/// @return EXIT_SUCCESS ou EXIT_FAILURE.
+int Particles_Reserve(Particles *particles, int capacity);
+
+/// @brief Ajoute une balle immobile au stockage.
+/// La balle est placée à la fin des tableaux, à l'indice m_count - 1.
+/// @param[in,out] particles le stockage.
+/// @param[in] position la position de la balle.
+/// @param[in] mass la masse de la balle.
+/// @param[in] friction le coefficient de friction de la balle.
+/// @return L'identifiant de la nouvelle balle ou BALL_NONE en cas d'erreur.
+BallId Particles_Add(Particles *particles, Vec2 position, float mass, float friction);
+
+/// @brief Supprime une balle en la remplaçant par la dernière balle du stockage.
+/// L'indice de la dernière balle devient donc index, son identifiant ne change pas.
+/// L'identifiant de la balle supprimée devient invalide.
+/// @param[in,out] particles le stockage.
+/// @param[in] index l'indice de la balle à supprimer.
+void Particles_Remove(Particles *particles, int index);
+
+/// @brief Réordonne les balles d'indices [first, m_count[ du stockage. Les balles précédentes
+/// ne bougent pas, et les identifiants des balles ne changent pas.
+/// @param[in,out] particles le stockage.
+/// @param[in] first l'indice de la première balle à réordonner.
+/// @param[in] order pour chaque nouvel indice i >= first, l'indice actuel (>= first) de la balle
+/// à y placer.
+/// @param[in,out] scratch un tableau temporaire d'au moins m_count - first éléments de 32 bits.
+void Particles_Permute(Particles *particles, int first, const int *order, void *scratch);
+
+/// @brief Renvoie l'indice courant d'une balle dans les tableaux.
+/// @param[in] particles le stockage.
+/// @param[in] id l'identifiant de la balle.
+/// @return L'indice de la balle ou -1 si l'identifiant n'est pas (ou plus) valide.
+int Particles_GetIndex(Particles *particles, BallId id);
+
+/// @brief Indique si un identifiant désigne une balle présente dans le stockage.
+/// @param[in] particles le stockage.
+/// @param[in] id l'identifiant de la balle.
+/// @return true si la balle existe, false sinon.
+bool Particles_IsValid(Particles *particles, BallId id);
+
+/// @brief Renvoie l'identifiant de la balle située à un indice donné.
+/// @param[in] particles le stockage.
+/// @param[in] index l'indice de la balle.
+/// @return L'identifiant de la balle.
+BallId Particles_GetId(Particles *particles, int index);
+
+/// @brief Renvoie la position d'une balle.
+/// @param[in] particles le stockage.
+/// @param[in] index l'indice de la balle.
+/// @return La position de la balle dans le référentiel monde.
+Vec2 Particles_GetPosition(Particles *particles, int index);
+
+/// @brief Modifie la position d'une balle (sans interpolation lors du prochain rendu).
+/// @param[in,out] particles le stockage.
+/// @param[in] index l'indice de la balle.
+/// @param[in] position la nouvelle position dans le référentiel monde.
+void Particles_SetPosition(Particles *particles, int index, Vec2 position);
+
+/// @brief Mémorise les positions courantes des balles d'indices [first, last[ comme positions
+/// de début de pas. Doit être appelée au début de chaque pas de temps pour les balles qui
+/// peuvent bouger, et lorsqu'une balle cesse de bouger.
+/// @param[in,out] particles le stockage.
+/// @param[in] first l'indice de la première balle.
+/// @param[in] last l'indice suivant celui de la dernière balle.
+void Particles_SavePositions(Particles *particles, int first, int last);
+
+/// @brief Renvoie la vitesse d'une balle.
+/// @param[in] particles le stockage.
+/// @param[in] index l'indice de la balle.
+/// @return La vitesse de la balle.
+Vec2 Particles_GetVelocity(Particles *particles, int index);
+
+/// @}
+
+#endif
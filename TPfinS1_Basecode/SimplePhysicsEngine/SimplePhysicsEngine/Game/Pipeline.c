@@ -0,0 +1,174 @@
+﻿#include "Pipeline.h"
+#include "Scene.h"
+#include "Simulation.h"
+#include "../Utils/Timer.h"
+#include "../Utils/Profiler.h"
+
+/// @brief Coefficient de la moyenne glissante des durées des étapes.
+#define PIPELINE_SMOOTHING 0.05
+
+/// @brief Etape "Input" : lit les événements de l'utilisateur.
+static void Pipeline_Input(Scene *scene)
+{
+    Input_Update(scene->m_input);
+}
+
+/// @brief Etape "Simulate" : avance le moteur physique, sauf s'il tourne sur son propre thread.
+static void Pipeline_Simulate(Scene *scene)
+{
+    if (scene->m_simulation)
+        return;
+
+    Scene_Update(scene);
+}
+
+/// @brief Etape "Game" : zoom et déplacement de la caméra, puis logique du jeu.
+/// Avec un thread de simulation, les entrées lui sont transmises et la logique du jeu est
+/// exécutée par ce thread ; sinon, l'état de la scène est publié pour le rendu.
+static void Pipeline_Game(Scene *scene)
+{
+    Vec2 mousePos = Scene_UpdateView(scene);
+
+    if (scene->m_simulation)
+    {
+        Simulation_PostInput(scene->m_simulation, scene->m_input, mousePos);
+    }
+    else
+    {
+        Scene_UpdateGame(scene, scene->m_input, mousePos);
+        SnapshotBuffer_Publish(scene->m_snapshots, scene);
+    }
+
+    PROFILE_ZONE_BEGIN("Camera_Update");
+    Camera_Update(scene->m_camera);
+    PROFILE_ZONE_END();
+}
+
+/// @brief Etape "Render" : dessine le décor et construit les lots de sprites de la scène.
+static void Pipeline_Render(Scene *scene)
+{
+    // Le fond recouvre tout l'écran de façon opaque : l'image n'a pas besoin d'être effacée
+    SpriteBatch_Reset(scene->m_batch);
+    Scene_Render(scene);
+}
+
+/// @brief Etape "Submit" : envoie le dernier lot de sprites au moteur de rendu.
+static void Pipeline_Submit(Scene *scene)
+{
+    SpriteBatch_Flush(scene->m_batch);
+}
+
+/// @brief Etape "Present" : affiche le buffer de rendu.
+static void Pipeline_Present(Scene *scene)
+{
+    Renderer_Update(scene->m_renderer);
+}
+
+Pipeline *Pipeline_New()
+{
+    Pipeline *pipeline = NULL;
+
+    pipeline = (Pipeline *)calloc(1, sizeof(Pipeline));
+    if (!pipeline) goto ERROR_LABEL;
+
+    if (Pipeline_InsertStage(pipeline, NULL, "Input", Pipeline_Input) == EXIT_FAILURE
+        || Pipeline_InsertStage(pipeline, NULL, "Simulate", Pipeline_Simulate) == EXIT_FAILURE
+        || Pipeline_InsertStage(pipeline, NULL, "Game", Pipeline_Game) == EXIT_FAILURE
+        || Pipeline_InsertStage(pipeline, NULL, "Render", Pipeline_Render) == EXIT_FAILURE
+        || Pipeline_InsertStage(pipeline, NULL, "Submit", Pipeline_Submit) == EXIT_FAILURE
+        || Pipeline_InsertStage(pipeline, NULL, "Present", Pipeline_Present) == EXIT_FAILURE)
+        goto ERROR_LABEL;
+
+    return pipeline;
+
+ERROR_LABEL:
+    printf("ERROR - Pipeline_New()\n");
+    assert(false);
+    Pipeline_Free(pipeline);
+    return NULL;
+}
+
+void Pipeline_Free(Pipeline *pipeline)
+{
+    if (!pipeline) return;
+
+    memset(pipeline, 0, sizeof(Pipeline));
+    free(pipeline);
+}
+
+int Pipeline_FindStage(Pipeline *pipeline, const char *name)
+{
+    for (int i = 0; i < pipeline->m_stageCount; ++i)
+    {
+        if (strcmp(pipeline->m_stages[i].m_name, name) == 0)
+            return i;
+    }
+    return -1;
+}
+
+int Pipeline_InsertStage(
+    Pipeline *pipeline, const char *before, const char *name, PipelineStageFunc func)
+{
+    if (pipeline->m_stageCount >= PIPELINE_MAX_STAGES)
+        goto ERROR_LABEL;
+
+    int index = pipeline->m_stageCount;
+    if (before)
+    {
+        index = Pipeline_FindStage(pipeline, before);
+        if (index < 0) goto ERROR_LABEL;
+    }
+
+    // Décale les étapes suivantes
+    PipelineStage *stages = pipeline->m_stages;
+    memmove(&stages[index + 1], &stages[index],
+        (pipeline->m_stageCount - index) * sizeof(PipelineStage));
+    pipeline->m_stageCount++;
+
+    memset(&stages[index], 0, sizeof(PipelineStage));
+    stages[index].m_name = name;
+    stages[index].m_func = func;
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - Pipeline_InsertStage()\n");
+    return EXIT_FAILURE;
+}
+
+void Pipeline_Run(Pipeline *pipeline, Scene *scene)
+{
+    PROFILE_FRAME();
+
+    for (int i = 0; i < pipeline->m_stageCount; ++i)
+    {
+        PipelineStage *stage = &pipeline->m_stages[i];
+        Uint64 start = SDL_GetPerformanceCounter();
+
+        PROFILE_ZONE_BEGIN(stage->m_name);
+        stage->m_func(scene);
+        PROFILE_ZONE_END();
+
+        stage->m_lastTime = Timer_TicksToNs(SDL_GetPerformanceCounter() - start);
+
+        // Moyenne glissante de la durée de l'étape
+        double time = (double)stage->m_lastTime * 1e-9;
+        if (pipeline->m_frameCount > 0)
+            time = (1.0 - PIPELINE_SMOOTHING) * stage->m_meanTime + PIPELINE_SMOOTHING * time;
+        stage->m_meanTime = time;
+    }
+
+    pipeline->m_frameCount++;
+}
+
+void Pipeline_PrintTimings(Pipeline *pipeline)
+{
+    double total = 0.0;
+    for (int i = 0; i < pipeline->m_stageCount; ++i)
+    {
+        PipelineStage *stage = &pipeline->m_stages[i];
+        printf("%-12s %8.3f ms\n", stage->m_name, 1000.0 * stage->m_meanTime);
+        total += stage->m_meanTime;
+    }
+    printf("%-12s %8.3f ms\n", "Frame", 1000.0 * total);
+}
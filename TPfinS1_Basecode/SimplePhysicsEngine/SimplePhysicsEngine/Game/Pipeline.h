@@ -0,0 +1,90 @@
+﻿#ifndef _PIPELINE_H_
+#define _PIPELINE_H_
+
+/// @file pipeline.h
+/// @defgroup Pipeline
+/// @{
+
+#include "../Settings.h"
+
+typedef struct Scene_s Scene;
+
+/// @brief Nombre maximal d'étapes d'un pipeline.
+#define PIPELINE_MAX_STAGES 16
+
+/// @brief Fonction exécutée par une étape du pipeline, une fois par image.
+typedef void (*PipelineStageFunc)(Scene *scene);
+
+/// @brief Etape du pipeline.
+typedef struct PipelineStage_s
+{
+    /// @brief Nom de l'étape (chaîne constante, utilisée aussi par le profileur).
+    const char *m_name;
+
+    /// @brief Fonction exécutée par l'étape.
+    PipelineStageFunc m_func;
+
+    /// @brief Durée de l'étape lors de la dernière image (exprimée en ns).
+    Uint64 m_lastTime;
+
+    /// @brief Durée moyenne de l'étape (exprimée en s).
+    double m_meanTime;
+} PipelineStage;
+
+/// @brief Pipeline d'une image.
+/// Les étapes sont exécutées dans l'ordre, chacune exactement une fois par image.
+/// Le pipeline par défaut est :
+/// entrées -> simulation -> jeu -> rendu (construction des lots) -> envoi des lots
+/// -> présentation.
+/// Si la scène a un thread de simulation (voir Simulation), la simulation et la logique du
+/// jeu sont exécutées par ce thread : le pipeline ne fait que lui transmettre les entrées et
+/// dessiner le dernier instantané publié.
+/// D'autres étapes peuvent être insérées avec Pipeline_InsertStage().
+typedef struct Pipeline_s
+{
+    /// @brief Etapes du pipeline, dans l'ordre d'exécution.
+    PipelineStage m_stages[PIPELINE_MAX_STAGES];
+
+    /// @brief Nombre d'étapes.
+    int m_stageCount;
+
+    /// @brief Nombre d'images exécutées.
+    Uint64 m_frameCount;
+} Pipeline;
+
+/// @brief Crée le pipeline par défaut.
+/// @return Le pipeline créé ou NULL en cas d'erreur.
+Pipeline *Pipeline_New();
+
+/// @brief Détruit un pipeline préalablement alloué avec Pipeline_New().
+/// @param[in,out] pipeline le pipeline à détruire.
+void Pipeline_Free(Pipeline *pipeline);
+
+/// @brief Renvoie l'indice d'une étape du pipeline.
+/// @param[in] pipeline le pipeline.
+/// @param[in] name le nom de l'étape.
+/// @return L'indice de l'étape ou -1 si elle n'existe pas.
+int Pipeline_FindStage(Pipeline *pipeline, const char *name);
+
+/// @brief Insère une étape dans le pipeline.
+/// @param[in,out] pipeline le pipeline.
+/// @param[in] before le nom de l'étape devant laquelle insérer la nouvelle étape
+/// (NULL pour l'ajouter à la fin).
+/// @param[in] name le nom de la nouvelle étape (chaîne constante).
+/// @param[in] func la fonction exécutée par la nouvelle étape.
+/// @return EXIT_SUCCESS ou EXIT_FAILURE.
+int Pipeline_InsertStage(
+    Pipeline *pipeline, const char *before, const char *name, PipelineStageFunc func);
+
+/// @brief Exécute une image : chaque étape du pipeline est exécutée une fois, dans l'ordre.
+/// @param[in,out] pipeline le pipeline.
+/// @param[in,out] scene la scène.
+void Pipeline_Run(Pipeline *pipeline, Scene *scene);
+
+/// @brief Affiche la durée moyenne de chaque étape.
+/// @param[in] pipeline le pipeline.
+void Pipeline_PrintTimings(Pipeline *pipeline);
+
+/// @}
+
+#endif
@@ -1,568 +1,1215 @@
-﻿#include "Scene.h"
-#include "Ball.h"
-#include "Camera.h"
-#include "Background.h"
-#include "../Utils/Timer.h"
-
-int Scene_DoubleCapacity(Scene *scene);
-
-/// default values for the physics
-void setDefault(Scene* scene) {
-    scene->m_gameMode->gravity = -9.81f;
-    scene->m_gameMode->rebond = -0.8f;
-    scene->m_gameMode->mass = 0.5;
-    scene->m_gameMode->isMoon = false;
-}
-
-Scene *Scene_New(Renderer *renderer, int max_connections, float maxDistance)
-{
-    Scene *scene = NULL;
-    int capacity = 1 << 10;
-
-    int width  = Renderer_GetWidth(renderer);
-    int height = Renderer_GetHeight(renderer);
-
-    scene = (Scene *)calloc(1, sizeof(Scene));
-    if (!scene) goto ERROR_LABEL;
-
-    scene->m_textures = Textures_New(renderer);
-    if (!scene->m_textures) goto ERROR_LABEL;
-
-    scene->m_camera = Camera_New(width, height);
-    if (!scene->m_camera) goto ERROR_LABEL;
-
-    scene->m_input = Input_New();
-    if (!scene->m_input) goto ERROR_LABEL;
-
-    scene->m_balls = (Ball *)calloc(capacity, sizeof(Ball));
-    if (!scene->m_balls) goto ERROR_LABEL;
-
-    scene->m_queries = calloc(max_connections, sizeof(BallQuery));
-    scene->m_gameMode = (gameMode_t *)calloc(1, sizeof(gameMode_t));
-
-    scene->m_renderer = renderer;
-    scene->m_ballCount = 0;
-    scene->m_ballCapacity = capacity;
-    scene->m_timeStep = 1.0f / 100.f;
-    scene->m_maxBalls = max_connections;
-    scene->m_maxDistance = maxDistance;
-
-    setDefault(scene);
-    scene->flusher = 0;
-
-    // Création d'une scène minimale avec trois balles reliées
-    Ball *ball1 = Scene_CreateBall(scene, Vec2_Set(-0.75f, 0.0f));
-    Ball *ball2 = Scene_CreateBall(scene, Vec2_Set(+0.75f, 0.0f));
-    Ball *ball3 = Scene_CreateBall(scene, Vec2_Set(0.0f, 1.299f));
-    Ball *ball4= Scene_CreateBall(scene, Vec2_Set(2.77f, 1.299f));
-    Ball *ball5= Scene_CreateBall(scene, Vec2_Set(3.77f, 2.299f));
-    Ball_Connect(ball1, ball2, 1.5f);
-    Ball_Connect(ball1, ball3, 1.5f);
-    Ball_Connect(ball2, ball3, 1.5f);
-    Ball_Connect(ball4, ball3, 1.5f);
-    Ball_Connect(ball5, ball3, 1.5f);
-    Ball_Connect(ball4, ball5, 1.5f);
-
-    // ball3->position = Vec2_Set(3.0f, 3.0f);
-
-    return scene;
-
-ERROR_LABEL:
-    printf("ERROR - Scene_New()\n");
-    assert(false);
-    Scene_Free(scene);
-    return NULL;
-}
-
-void Scene_Free(Scene *scene)
-{
-    if (!scene) return;
-
-    Camera_Free(scene->m_camera);
-    Input_Free(scene->m_input);
-    Textures_Free(scene->m_textures);
-
-    if (scene->m_balls)
-    {
-        free(scene->m_balls);
-    }
-
-    memset(scene, 0, sizeof(Scene));
-    free(scene);
-}
-
-Renderer *Scene_GetRenderer(Scene *scene)
-{
-    return scene->m_renderer;
-}
-
-Camera *Scene_GetCamera(Scene *scene)
-{
-    return scene->m_camera;
-}
-
-Input *Scene_GetInput(Scene *scene)
-{
-    return scene->m_input;
-}
-
-Vec2 Scene_GetMousePosition(Scene *scene)
-{
-    return scene->m_mousePos;
-}
-
-int Scene_DoubleCapacity(Scene *scene)
-{
-    Ball *newBalls = NULL;
-    int newCapacity = scene->m_ballCapacity << 1;
-
-    newBalls = (Ball *)realloc(scene->m_balls, newCapacity * sizeof(Ball));
-    if (!newBalls) goto ERROR_LABEL;
-
-    scene->m_balls = newBalls;
-    scene->m_ballCapacity = newCapacity;
-
-    return EXIT_SUCCESS;
-
-ERROR_LABEL:
-    printf("ERROR - Scene_DoubleCapacity()\n");
-    return EXIT_FAILURE;
-}
-
-Ball *Scene_CreateBall(Scene *scene, Vec2 position)
-{
-    if (scene->m_ballCount >= scene->m_ballCapacity)
-    {
-        int exitStatus = Scene_DoubleCapacity(scene);
-        if (exitStatus == EXIT_FAILURE) goto ERROR_LABEL;
-    }
-
-    Ball *ball = &scene->m_balls[scene->m_ballCount];
-    scene->m_ballCount++;
-
-    *ball = Ball_Set(scene, position);
-
-    return ball;
-
-ERROR_LABEL:
-    printf("ERROR - Scene_CreateBall()\n");
-    return NULL;
-}
-
-void Scene_RemoveBall(Scene *scene, Ball *ball)
-{
-    int ballCount = Scene_GetBallCount(scene);
-    Ball *balls = Scene_GetBalls(scene);
-    int index = (int)(ball - balls);
-    int springCount = 0;
-
-    if (index < 0 || index >= ballCount)
-        return;
-
-    // Supprime les ressorts liés à la balle
-    springCount = ball->springCount;
-    for (int i = 0; i < springCount; ++i)
-    {
-        Ball_Deconnect(ball, ball->springs[i].other);
-    }
-
-    Ball *lastBall = &balls[ballCount - 1];
-    if (ball != lastBall)
-    {
-        // Copie la dernière balle à la position de la balle à supprimer
-        *ball = *lastBall;
-
-        // Met à jour ses ressorts
-        ball->springCount = 0;
-        springCount = lastBall->springCount;
-        for (int i = 0; i < springCount; ++i)
-        {
-            Ball *other = lastBall->springs[i].other;
-            float length = lastBall->springs[i].length;
-            Ball_Deconnect(lastBall, other);
-            Ball_Connect(ball, other, length);
-        }
-    }
-
-    // Supprime la dernière balle
-    scene->m_ballCount--;
-}
-
-int Scene_GetBallCount(Scene *scene)
-{
-    return scene->m_ballCount;
-}
-
-Ball *Scene_GetBalls(Scene *scene)
-{
-    return scene->m_balls;
-}
-
-BallQuery Scene_GetNearestBall(Scene *scene, Vec2 position)
-{
-    BallQuery query = { 0 };
-    Ball *balls = Scene_GetBalls(scene); 
-    int ballCount = Scene_GetBallCount(scene);
-
-    // query.ball is already NULL
-    if (!ballCount) return query;
-
-    int min = Vec2_Distance(balls[0].position, position);
-    for (size_t i = 0; i < ballCount; i++) {
-        if (Vec2_Distance(balls[i].position, position) < min) {
-            query.ball = &balls[i];
-            query.distance = Vec2_Distance(balls[i].position, position);
-        }
-    }
-
-    return query;
-}
-
-float scalar_product(Vec2 a, Vec2 b)
-{
-    return a.x * b.x + a.y * b.y;
-}
-
-void BubbleSortBalls(Ball* balls, int ballCount, Vec2 pos)
-{
-    if (1 == ballCount) {
-        return;
-    }
-
-    for (size_t i = 0; i < ballCount - 1; i++) {
-        if (Vec2_Distance(balls[i].position, pos) > Vec2_Distance(balls[i+1].position, pos)) {
-            Ball saved = balls[i];
-            balls[i] = balls[i+1];
-            balls[i+1] = saved;
-        }
-    }
-
-    BubbleSortBalls(balls, ballCount - 1, pos);
-}
-
-/// are v1 and v1 too far from each other
-_Bool isValidLength(Scene* scene, Vec2 v1, Vec2 v2) {
-    return Vec2_Distance(v1, v2) < scene->m_maxDistance ? true : false;
-}
-
-
-int Scene_GetNearestBalls(Scene *scene, Vec2 position, BallQuery *queries, int queryCount)
-{
-    Ball* saved = calloc(Scene_GetBallCount(scene), sizeof(Ball));
-    Ball *balls = Scene_GetBalls(scene);
-    int ballCount = Scene_GetBallCount(scene);
-
-    if (!ballCount) return EXIT_FAILURE;
-
-    memcpy(saved, balls, ballCount * sizeof(Ball));
-    BubbleSortBalls(saved, ballCount, position);
-
-    scene->m_validCount = 0;
-    for (int i = 0; i < queryCount; i++) {
-        for (int k = 0; k < ballCount; ++k) {
-            if (saved[i].position.x == balls[k].position.x && saved[i].position.y == balls[k].position.y && isValidLength(scene, balls[k].position, position)) {
-                queries[i].ball = &balls[k];
-                queries[i].distance = Vec2_Distance(queries[i].ball->position, position);
-                assert(isValidLength(scene, balls[k].position, position));
-                scene->m_validCount++;
-            }
-        }
-    }
-
-    if (scene->m_validCount != queryCount) return EXIT_FAILURE;
-
-    free(saved);
-    return EXIT_SUCCESS;
-}
-
-
-/// deletes the ball right next to pos
-int mayDeleteBall(Scene* scene, Vec2 pos)
-{
-    if (EXIT_FAILURE == Scene_GetNearestBalls(scene, pos, scene->m_queries, 1)) {
-        return 0;
-    }
-
-    if (Vec2_Distance(scene->m_queries[0].ball->position, pos) < 0.2f) {
-        for (int i = 0; i < scene->m_queries[0].ball->springCount; ++i) Ball_Deconnect(scene->m_queries[0].ball, scene->m_queries[0].ball->springs[i].other);
-        Scene_RemoveBall(scene, scene->m_queries[0].ball);
-    }
-
-    return 0;
-}
-
-/// checks if we have to move or not the ball
-int mayMoveBall(Scene* scene, Vec2 pos)
-{
-    if (Vec2_Distance(scene->m_ballToMove->position, pos) > 0.2f) {
-        scene->m_ballToMove->position = pos;
-        return EXIT_SUCCESS;
-    }
-
-    return EXIT_FAILURE;
-}
-
-void Scene_FixedUpdate(Scene *scene, float timeStep)
-{
-    int ballCount = Scene_GetBallCount(scene);
-    Ball *balls = Scene_GetBalls(scene);
-
-    for (int i = 0; i < ballCount; i++)
-    {
-        Ball_UpdateVelocity(scene, &balls[i], timeStep);
-    }
-    for (int i = 0; i < ballCount; i++)
-    {
-        Ball_UpdatePosition(scene, &balls[i], timeStep);
-    }
-}
-
-// void print_ball(Ball* ball) {
-//     fprintf(stdout, "ball.position.x / y: %f / %f, ball.velocity.x / y: %f / %f, ball.friction: %f, mass: %f\n"
-//                     , ball->position.x, ball->position.y, ball->velocity.x, ball->velocity.y, ball->friction, ball->mass);
-// }
-
-Spring* InSpring(Scene* scene, Vec2 pos)
-{
-    BallQuery query = {0};
-    Scene_GetNearestBalls(scene, pos, &query, 1);
-
-    for (size_t i = 0; i < query.ball->springCount; i++) {
-        if (!scalar_product(Vec2_Sub(pos, query.ball->springs[i].other->position), query.ball->position)) {
-            return &query.ball->springs[i];
-        }
-    }
-
-    return (void* )-1;
-}
-
-/// Create and link the ball @ scene->m_mouPos to the n nearest balls which are not too far (max_length)
-int connect_n(Scene* scene, int n, int max_length) {
-    int ballCount = Scene_GetBallCount(scene);
-
-    if (n > ballCount) {
-        Scene_CreateBall(scene, scene->m_mousePos);
-        return EXIT_FAILURE;
-    }
-
-    Scene_GetNearestBalls(scene, scene->m_mousePos, scene->m_queries, n);
-
-    if (scene->m_validCount) {
-        Ball *ball_created = Scene_CreateBall(scene, scene->m_mousePos);
-
-        for (size_t i = 0; i < scene->m_validCount; i++) {
-            Ball_Connect(ball_created, scene->m_queries[i].ball, 2.3f);
-        }
-    } else {
-        Scene_CreateBall(scene, scene->m_mousePos);
-    }
-
-    if (n != scene->m_validCount) return EXIT_FAILURE;
-
-    return EXIT_SUCCESS;
-}
-
-// Some mode
-
-void luneMode(Scene* scene) {
-    scene->m_gameMode->gravity = LUNE_GRAVITY_ACCELERATION;
-    scene->m_gameMode->mass = LUNE_MASS;
-    scene->m_gameMode->rebond = LUNE_REBOND_COEFFICIENT;
-}
-
-void noGrav(Scene* scene) {
-    scene->m_gameMode->gravity = NOGRAV_GRAVITY_ACCELERATION;
-    scene->m_gameMode->mass = NOGRAV_MASS;
-    scene->m_gameMode->rebond = NOGRAV_REBOND_COEFFICIENT;
-
-    scene->m_gameMode->isNoGrav = true;
-}
-
-
-void Scene_UpdateGame(Scene *scene)
-{
-    Input *input = Scene_GetInput(scene);
-    Camera *camera = Scene_GetCamera(scene);
-
-    // Initialise les requêtes
-    scene->m_validCount = 0;
-
-    // Calcule la position de la souris et son déplacement
-    Vec2 mousePos = Vec2_Set(0.0f, 0.0f);
-    Vec2 mouseDelta = Vec2_Set(0.0f, 0.0f);
-    Camera_ViewToWorld(camera, (float)input->mouseX, (float)input->mouseY, &mousePos);
-    Camera_ViewToWorld(
-        camera,
-        (float)(input->mouseX + input->mouseDeltaX),
-        (float)(input->mouseY + input->mouseDeltaY),
-        &mouseDelta
-    );
-    mouseDelta = Vec2_Sub(mouseDelta, mousePos);
-    scene->m_mousePos = mousePos;
-
-    // Déplacement de la caméra
-    if (input->mouseRDown)
-    {
-        Camera_Move(camera, Vec2_Scale(mouseDelta, -1.f));
-        return;
-    }
-
-    memset(scene->m_queries, 0x0, sizeof(BallQuery) * scene->m_maxBalls);
-
-    if (scene->m_gameMode->isDefault) {
-        setDefault(scene);
-    }
-
-    /// If a key / button is hit
-    if (scene->m_input->isHit) {
-        switch (scene->m_input->keyStatus) {
-            /// Is it a left click (create and link a ball)
-            case SDL_BUTTON_LEFT:
-                if (scene->m_mousePos.y > 0.0f && scene->flusher > 3) {
-                    connect_n(scene, 3, scene->m_maxDistance);
-                    scene->flusher = 0;
-                } else {
-                    scene->flusher++;
-                }
-                break;
-
-            /// Delete ball
-            case SDL_SCANCODE_D:
-                mayDeleteBall(scene, scene->m_mousePos);
-                break;
-
-            /// teleport the ball
-            case SDL_SCANCODE_T:
-                if (scene->m_toMove && Vec2_Distance(scene->m_mousePos, scene->m_ballToMove->position) < 0.2f) {
-                    return;
-                } else if (scene->m_toMove) {
-                    mayMoveBall(scene, scene->m_mousePos);
-                    scene->m_toMove = false;
-                } else if (!scene->m_toMove) {
-                    if (EXIT_FAILURE != Scene_GetNearestBalls(scene, scene->m_mousePos, scene->m_queries, 1) && Vec2_Distance(scene->m_mousePos, scene->m_queries[0].ball->position) < 0.2f) scene->m_ballToMove = scene->m_queries[0].ball;
-
-                    scene->m_toMove = true;
-                }
-                break;
-
-            /// Moon mode
-            case SDL_SCANCODE_K:
-                if (!scene->m_gameMode->isMoon) {
-                    luneMode(scene);
-                }
-                break;
-
-            /// Default settings
-            case SDL_SCANCODE_H:
-                setDefault(scene);
-                break;
-
-            /// No gravity mode
-            case SDL_SCANCODE_N:
-                if (!scene->m_gameMode->isNoGrav) {
-                    noGrav(scene);
-                }
-
-            default:
-                break;
-        }
-    } else {
-        /// Call Scene_GetNearestBalls to update scene->m_validCount
-        Scene_GetNearestBalls(scene, scene->m_mousePos, scene->m_queries, 3);
-    }
-}
-
-void Scene_Update(Scene *scene)
-{
-    float timeStep = scene->m_timeStep;
-
-    // Met à jour les entrées de l'utilisateur
-    Input_Update(scene->m_input);
-
-    // Met à jour le moteur physique (pas de temps fixe)
-    scene->m_accu += Timer_GetDelta(g_time);
-    while (scene->m_accu >= timeStep)
-    {
-        Scene_FixedUpdate(scene, timeStep);
-        scene->m_accu -= timeStep;
-    }
-
-    // Met à jour la caméra (déplacement)
-    Camera_Update(scene->m_camera);
-
-    Scene_Render(scene);
-
-    // Met à jour le jeu
-    Scene_UpdateGame(scene);
-}
-
-void Scene_RenderBalls(Scene *scene)
-{
-    int ballCount = Scene_GetBallCount(scene);
-    Ball *balls = Scene_GetBalls(scene);
-    for (int i = 0; i < ballCount; i++)
-    {
-        Ball *ball = &balls[i];
-        int springCount = ball->springCount;
-        for (int j = 0; j < springCount; j++)
-        {
-            // Supprime le flag
-            ball->springs[j].flags &= ~SPRING_RENDERED;
-        }
-    }
-
-    for (int i = 0; i < ballCount; i++)
-    {
-        Ball *ball = &balls[i];
-        Vec2 start = Ball_GetPosition(ball);
-
-        int springCount = ball->springCount;
-        for (int j = 0; j < springCount; j++)
-        {
-            Spring *spring = ball->springs + j;
-            if ((spring->flags & SPRING_RENDERED) != 0)
-            {
-                continue;
-            }
-
-            // Ajoute le flag
-            spring->flags |= SPRING_RENDERED;
-
-            // Affiche le ressort
-            Vec2 end = Ball_GetPosition(spring->other);
-            Ball_RenderSpring(start, end, scene, true);
-        }
-    }
-
-    for (int i = 0; i < ballCount; i++)
-    {
-        // Affiche la balle
-        Ball_Render(&balls[i], scene);
-    }
-}
-
-void Scene_Render(Scene *scene)
-{
-    // Dessine le fond (avec parallax)
-    Background_Render(scene);
-
-    // Dessine le sol
-    TileMap_Render(scene);
-
-    if (scene->m_input->mouseRDown == false)
-    {
-        // Dessine les ressorts inactifs
-        int validCount = scene->m_validCount;
-        BallQuery *queries = scene->m_queries;
-        for (int i = 0; i < validCount; ++i)
-        {
-            Vec2 start = Scene_GetMousePosition(scene);
-            Vec2 end = Ball_GetPosition(queries[i].ball);
-
-            Ball_RenderSpring(start, end, scene, false);
-        }
-    }
-
-    // Dessine les balles (avec les ressorts actifs)
-    Scene_RenderBalls(scene);
-}
\ No newline at end of file
+﻿#include "Scene.h"
+#include "Ball.h"
+#include "Kernels.h"
+#include "Camera.h"
+#include "Background.h"
+#include "../Utils/Timer.h"
+#include "../Utils/ThreadPool.h"
+#include "../Utils/Profiler.h"
+#include <float.h>
+
+int Scene_DoubleCapacity(Scene *scene);
+
+/// default values for the physics
+void setDefault(Scene* scene) {
+    scene->m_gameMode->gravity = -9.81f;
+    scene->m_gameMode->rebond = -0.8f;
+    scene->m_gameMode->mass = 0.5;
+    scene->m_gameMode->isMoon = false;
+}
+
+Scene *Scene_New(Renderer *renderer, int max_connections, float maxDistance)
+{
+    Scene *scene = NULL;
+    int capacity = 1 << 10;
+
+    scene = (Scene *)calloc(1, sizeof(Scene));
+    if (!scene) goto ERROR_LABEL;
+
+    // Une scène sans moteur de rendu (simulation sans fenêtre) n'a ni textures, ni caméra,
+    // ni entrées : seule la physique est disponible
+    if (renderer)
+    {
+        int width  = Renderer_GetWidth(renderer);
+        int height = Renderer_GetHeight(renderer);
+
+        scene->m_textures = Textures_New(renderer);
+        if (!scene->m_textures) goto ERROR_LABEL;
+
+        scene->m_batch = SpriteBatch_New(renderer);
+        if (!scene->m_batch) goto ERROR_LABEL;
+
+        scene->m_lod = Lod_New();
+        if (!scene->m_lod) goto ERROR_LABEL;
+
+        scene->m_background = BackgroundCache_New();
+        if (!scene->m_background) goto ERROR_LABEL;
+
+        scene->m_snapshots = SnapshotBuffer_New();
+        if (!scene->m_snapshots) goto ERROR_LABEL;
+
+        scene->m_renderGrid = Grid_New(2.f * BALL_RADIUS);
+        if (!scene->m_renderGrid) goto ERROR_LABEL;
+
+        scene->m_camera = Camera_New(width, height);
+        if (!scene->m_camera) goto ERROR_LABEL;
+
+        scene->m_input = Input_New();
+        if (!scene->m_input) goto ERROR_LABEL;
+    }
+
+    // Choisit les noyaux de calcul adaptés au processeur
+    Kernels_Init();
+
+    scene->m_particles = Particles_New(capacity);
+    if (!scene->m_particles) goto ERROR_LABEL;
+
+    scene->m_springs = Springs_New(capacity);
+    if (!scene->m_springs) goto ERROR_LABEL;
+
+    scene->m_links = (BallLinks *)calloc(capacity, sizeof(BallLinks));
+    if (!scene->m_links) goto ERROR_LABEL;
+
+    scene->m_islands = Islands_New(capacity);
+    if (!scene->m_islands) goto ERROR_LABEL;
+
+    scene->m_implicit = Implicit_New();
+    if (!scene->m_implicit) goto ERROR_LABEL;
+
+    scene->m_xpbd = Xpbd_New();
+    if (!scene->m_xpbd) goto ERROR_LABEL;
+
+    scene->m_grid = Grid_New(2.f * BALL_RADIUS);
+    if (!scene->m_grid) goto ERROR_LABEL;
+
+    scene->m_collisions = Collisions_New();
+    if (!scene->m_collisions) goto ERROR_LABEL;
+
+    scene->m_time = Timer_New();
+    if (!scene->m_time) goto ERROR_LABEL;
+
+    scene->m_queries = calloc(max_connections, sizeof(BallQuery));
+    scene->m_gameMode = (gameMode_t *)calloc(1, sizeof(gameMode_t));
+
+    scene->m_renderer = renderer;
+    scene->m_ballCapacity = capacity;
+    scene->m_timeStep = 1.0f / 100.f;
+    scene->m_maxSubsteps = SCENE_MAX_SUBSTEPS;
+    scene->m_stepBudget = SCENE_STEP_BUDGET;
+    scene->m_stepPolicy = STEP_POLICY_DROP;
+    scene->m_solverMode = SOLVER_EXPLICIT;
+    scene->m_springStiffness = SPRING_STIFFNESS;
+    scene->m_maxBalls = max_connections;
+    scene->m_maxDistance = maxDistance;
+    scene->m_ballToMove = BALL_NONE;
+
+    setDefault(scene);
+    scene->m_holdCounter = 0;
+
+    // Création d'une scène minimale avec trois balles reliées
+    BallId ball1 = Scene_CreateBall(scene, Vec2_Set(-0.75f, 0.0f));
+    BallId ball2 = Scene_CreateBall(scene, Vec2_Set(+0.75f, 0.0f));
+    BallId ball3 = Scene_CreateBall(scene, Vec2_Set(0.0f, 1.299f));
+    BallId ball4 = Scene_CreateBall(scene, Vec2_Set(2.77f, 1.299f));
+    BallId ball5 = Scene_CreateBall(scene, Vec2_Set(3.77f, 2.299f));
+    Ball_Connect(scene, ball1, ball2, 1.5f);
+    Ball_Connect(scene, ball1, ball3, 1.5f);
+    Ball_Connect(scene, ball2, ball3, 1.5f);
+    Ball_Connect(scene, ball4, ball3, 1.5f);
+    Ball_Connect(scene, ball5, ball3, 1.5f);
+    Ball_Connect(scene, ball4, ball5, 1.5f);
+
+    return scene;
+
+ERROR_LABEL:
+    printf("ERROR - Scene_New()\n");
+    assert(false);
+    Scene_Free(scene);
+    return NULL;
+}
+
+void Scene_Free(Scene *scene)
+{
+    if (!scene) return;
+
+    Camera_Free(scene->m_camera);
+    Input_Free(scene->m_input);
+    Textures_Free(scene->m_textures);
+    SpriteBatch_Free(scene->m_batch);
+    Lod_Free(scene->m_lod);
+    BackgroundCache_Free(scene->m_background);
+    SnapshotBuffer_Free(scene->m_snapshots);
+    Grid_Free(scene->m_renderGrid);
+
+    Particles_Free(scene->m_particles);
+    Springs_Free(scene->m_springs);
+
+    if (scene->m_links)
+    {
+        free(scene->m_links);
+    }
+
+    Islands_Free(scene->m_islands);
+    Implicit_Free(scene->m_implicit);
+    Xpbd_Free(scene->m_xpbd);
+    Grid_Free(scene->m_grid);
+    Collisions_Free(scene->m_collisions);
+    Timer_Free(scene->m_time);
+
+    free(scene->m_queryIndices);
+    free(scene->m_queryDistances);
+    free(scene->m_renderX);
+    free(scene->m_renderY);
+    free(scene->m_renderIndices);
+
+    memset(scene, 0, sizeof(Scene));
+    free(scene);
+}
+
+Renderer *Scene_GetRenderer(Scene *scene)
+{
+    return scene->m_renderer;
+}
+
+Camera *Scene_GetCamera(Scene *scene)
+{
+    return scene->m_camera;
+}
+
+Input *Scene_GetInput(Scene *scene)
+{
+    return scene->m_input;
+}
+
+Vec2 Scene_GetMousePosition(Scene *scene)
+{
+    return scene->m_mousePos;
+}
+
+int Scene_DoubleCapacity(Scene *scene)
+{
+    BallLinks *newLinks = NULL;
+    int newCapacity = scene->m_ballCapacity << 1;
+
+    int exitStatus = Particles_Reserve(scene->m_particles, newCapacity);
+    if (exitStatus == EXIT_FAILURE) goto ERROR_LABEL;
+
+    newLinks = (BallLinks *)realloc(scene->m_links, newCapacity * sizeof(BallLinks));
+    if (!newLinks) goto ERROR_LABEL;
+
+    scene->m_links = newLinks;
+
+    exitStatus = Islands_Reserve(scene->m_islands, newCapacity);
+    if (exitStatus == EXIT_FAILURE) goto ERROR_LABEL;
+
+    scene->m_ballCapacity = newCapacity;
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - Scene_DoubleCapacity()\n");
+    return EXIT_FAILURE;
+}
+
+BallId Scene_CreateBall(Scene *scene, Vec2 position)
+{
+    if (Scene_GetBallCount(scene) >= scene->m_ballCapacity)
+    {
+        int exitStatus = Scene_DoubleCapacity(scene);
+        if (exitStatus == EXIT_FAILURE) goto ERROR_LABEL;
+    }
+
+    BallId ball = Particles_Add(scene->m_particles, position, BALL_MASS, BALL_FRICTION);
+    if (ball == BALL_NONE) goto ERROR_LABEL;
+
+    int index = Scene_GetBallCount(scene) - 1;
+    scene->m_links[index].springCount = 0;
+    Islands_AddBall(scene->m_islands, index);
+    scene->m_gridDirty = true;
+    scene->m_topologyVersion++;
+
+    return ball;
+
+ERROR_LABEL:
+    printf("ERROR - Scene_CreateBall()\n");
+    return BALL_NONE;
+}
+
+void Scene_RemoveBall(Scene *scene, BallId id)
+{
+    Springs *springs = scene->m_springs;
+    BallLinks *links = scene->m_links;
+    int ball = Particles_GetIndex(scene->m_particles, id);
+    int last = Scene_GetBallCount(scene) - 1;
+
+    if (ball < 0)
+        return;
+
+    // Supprime les ressorts liés à la balle
+    while (links[ball].springCount > 0)
+    {
+        Ball_RemoveSpring(scene, links[ball].springs[0]);
+    }
+
+    // La dernière balle change d'indice
+    Islands_RemoveBall(scene->m_islands, ball, last);
+
+    if (ball != last)
+    {
+        // Copie la dernière balle à la position de la balle à supprimer
+        links[ball] = links[last];
+
+        // Met à jour les extrémités de ses ressorts
+        for (int i = 0; i < links[ball].springCount; ++i)
+        {
+            int spring = links[ball].springs[i];
+            if (springs->m_ball1[spring] == last)
+                springs->m_ball1[spring] = ball;
+            else
+                springs->m_ball2[spring] = ball;
+        }
+    }
+
+    // Supprime la dernière balle (l'identifiant de la balle supprimée devient invalide)
+    Particles_Remove(scene->m_particles, ball);
+    scene->m_gridDirty = true;
+    scene->m_topologyVersion++;
+}
+
+void Scene_Clear(Scene *scene)
+{
+    // Supprime les balles en partant de la dernière pour éviter les déplacements
+    while (Scene_GetBallCount(scene) > 0)
+    {
+        int last = Scene_GetBallCount(scene) - 1;
+        Scene_RemoveBall(scene, Particles_GetId(scene->m_particles, last));
+    }
+}
+
+int Scene_Load(Scene *scene, const char *path)
+{
+    FILE *file = NULL;
+    BallId *balls = NULL;
+    int ballCount = 0;
+    int ballCapacity = 0;
+    int lineNumber = 0;
+    char line[256];
+
+    file = fopen(path, "r");
+    if (!file) goto ERROR_LABEL;
+
+    Scene_Clear(scene);
+
+    while (fgets(line, sizeof(line), file))
+    {
+        float x, y, length;
+        int ball1, ball2;
+        char keyword[16];
+
+        lineNumber++;
+
+        // Ignore les lignes vides et les commentaires
+        if (sscanf(line, " %15s", keyword) != 1 || keyword[0] == '#')
+            continue;
+
+        if ((strcmp(keyword, "ball") == 0) && (sscanf(line, " ball %f %f", &x, &y) == 2))
+        {
+            if (ballCount >= ballCapacity)
+            {
+                ballCapacity = SDL_max(2 * ballCapacity, 64);
+                BallId *newBalls = (BallId *)realloc(balls, ballCapacity * sizeof(BallId));
+                if (!newBalls) goto ERROR_LABEL;
+                balls = newBalls;
+            }
+
+            balls[ballCount] = Scene_CreateBall(scene, Vec2_Set(x, y));
+            if (balls[ballCount] == BALL_NONE) goto ERROR_LABEL;
+            ballCount++;
+        }
+        else if ((strcmp(keyword, "spring") == 0)
+            && (sscanf(line, " spring %d %d %f", &ball1, &ball2, &length) == 3)
+            && (ball1 >= 0) && (ball1 < ballCount) && (ball2 >= 0) && (ball2 < ballCount))
+        {
+            Ball_Connect(scene, balls[ball1], balls[ball2], length);
+        }
+        else
+        {
+            printf("ERROR - Scene_Load() %s:%d invalid line\n", path, lineNumber);
+            goto ERROR_LABEL;
+        }
+    }
+
+    free(balls);
+    fclose(file);
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - Scene_Load()\n");
+    free(balls);
+    if (file) fclose(file);
+    return EXIT_FAILURE;
+}
+
+int Scene_Save(Scene *scene, const char *path)
+{
+    Particles *balls = Scene_GetBalls(scene);
+    Springs *springs = scene->m_springs;
+    int ballCount = Scene_GetBallCount(scene);
+
+    FILE *file = fopen(path, "w");
+    if (!file) goto ERROR_LABEL;
+
+    fprintf(file, "# %d balls, %d springs\n", ballCount, springs->m_count);
+    for (int i = 0; i < ballCount; ++i)
+    {
+        fprintf(file, "ball %.9g %.9g\n", balls->m_posX[i], balls->m_posY[i]);
+    }
+    for (int i = 0; i < springs->m_count; ++i)
+    {
+        fprintf(
+            file, "spring %d %d %.9g\n",
+            springs->m_ball1[i], springs->m_ball2[i], springs->m_length[i]
+        );
+    }
+
+    fclose(file);
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - Scene_Save()\n");
+    return EXIT_FAILURE;
+}
+
+int Scene_GetBallCount(Scene *scene)
+{
+    return scene->m_particles->m_count;
+}
+
+Particles *Scene_GetBalls(Scene *scene)
+{
+    return scene->m_particles;
+}
+
+/// @brief Reconstruit la grille si des balles ont bougé depuis sa dernière construction.
+static int Scene_UpdateGrid(Scene *scene)
+{
+    if (!scene->m_gridDirty)
+        return EXIT_SUCCESS;
+
+    Particles *balls = Scene_GetBalls(scene);
+    int exitStatus = Grid_Build(scene->m_grid, balls->m_posX, balls->m_posY, balls->m_count);
+    if (exitStatus == EXIT_FAILURE) return EXIT_FAILURE;
+
+    scene->m_gridDirty = false;
+
+    return EXIT_SUCCESS;
+}
+
+/// @brief Augmente la capacité des tableaux de résultats des recherches.
+static int Scene_ReserveQueries(Scene *scene, int capacity)
+{
+    if (capacity <= scene->m_queryCapacity)
+        return EXIT_SUCCESS;
+
+    int *newIndices = (int *)realloc(scene->m_queryIndices, capacity * sizeof(int));
+    if (!newIndices) goto ERROR_LABEL;
+    scene->m_queryIndices = newIndices;
+
+    float *newDistances = (float *)realloc(scene->m_queryDistances, capacity * sizeof(float));
+    if (!newDistances) goto ERROR_LABEL;
+    scene->m_queryDistances = newDistances;
+
+    scene->m_queryCapacity = capacity;
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - Scene_ReserveQueries()\n");
+    return EXIT_FAILURE;
+}
+
+/// @brief Augmente la capacité des tableaux d'indices et de positions des balles à dessiner.
+static int Scene_ReserveRender(Scene *scene, int capacity)
+{
+    if (capacity <= scene->m_renderCapacity)
+        return EXIT_SUCCESS;
+
+    int *newIndices = (int *)realloc(scene->m_renderIndices, capacity * sizeof(int));
+    if (!newIndices) goto ERROR_LABEL;
+    scene->m_renderIndices = newIndices;
+
+    float *newX = (float *)realloc(scene->m_renderX, capacity * sizeof(float));
+    if (!newX) goto ERROR_LABEL;
+    scene->m_renderX = newX;
+
+    float *newY = (float *)realloc(scene->m_renderY, capacity * sizeof(float));
+    if (!newY) goto ERROR_LABEL;
+    scene->m_renderY = newY;
+
+    scene->m_renderCapacity = capacity;
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - Scene_ReserveRender()\n");
+    return EXIT_FAILURE;
+}
+
+int Scene_GetBallsInRadius(
+    Scene *scene, Vec2 position, float radius, BallQuery *queries, int maxCount)
+{
+    Particles *balls = Scene_GetBalls(scene);
+
+    if ((Scene_UpdateGrid(scene) == EXIT_FAILURE)
+        || (Scene_ReserveQueries(scene, maxCount) == EXIT_FAILURE))
+        return -1;
+
+    int count = Grid_FindNearest(
+        scene->m_grid, balls->m_posX, balls->m_posY, position.x, position.y,
+        radius, maxCount, scene->m_queryIndices, scene->m_queryDistances
+    );
+    for (int i = 0; i < count; i++) {
+        queries[i].ball = Particles_GetId(balls, scene->m_queryIndices[i]);
+        queries[i].distance = scene->m_queryDistances[i];
+    }
+
+    return count;
+}
+
+int Scene_GetNearestBalls(Scene *scene, Vec2 position, BallQuery *queries, int queryCount)
+{
+    int ballCount = Scene_GetBallCount(scene);
+
+    scene->m_validCount = 0;
+    if (!ballCount) return EXIT_FAILURE;
+
+    if (queryCount > ballCount) queryCount = ballCount;
+
+    // Seules les balles assez proches pour être reliées sont retenues
+    int count = Scene_GetBallsInRadius(scene, position, scene->m_maxDistance, queries, queryCount);
+    if (count < 0) return EXIT_FAILURE;
+
+    scene->m_validCount = count;
+    if (scene->m_validCount != queryCount) return EXIT_FAILURE;
+
+    return EXIT_SUCCESS;
+}
+
+
+/// deletes the ball right next to pos
+int mayDeleteBall(Scene* scene, Vec2 pos)
+{
+    if (EXIT_FAILURE == Scene_GetNearestBalls(scene, pos, scene->m_queries, 1)) {
+        return 0;
+    }
+
+    if (scene->m_queries[0].distance < 0.2f) {
+        Scene_RemoveBall(scene, scene->m_queries[0].ball);
+    }
+
+    return 0;
+}
+
+/// checks if we have to move or not the ball
+int mayMoveBall(Scene* scene, Vec2 pos)
+{
+    int ball = Particles_GetIndex(scene->m_particles, scene->m_ballToMove);
+    if (ball < 0) {
+        return EXIT_FAILURE;
+    }
+
+    if (Vec2_Distance(Particles_GetPosition(scene->m_particles, ball), pos) > 0.2f) {
+        Particles_SetPosition(scene->m_particles, ball, pos);
+        Islands_WakeBall(scene->m_islands, ball);
+        scene->m_gridDirty = true;
+        return EXIT_SUCCESS;
+    }
+
+    return EXIT_FAILURE;
+}
+
+/// @brief Nombre minimal de ressorts traités par un thread.
+#define SCENE_SPRING_BATCH 1024
+
+/// @brief Nombre minimal de balles traitées par un thread.
+#define SCENE_BALL_BATCH 512
+
+/// @brief Nombre minimal de petites îles traitées par un thread.
+#define SCENE_ISLAND_BATCH 8
+
+/// @brief Paramètres d'un pas de simulation partagés par les threads.
+typedef struct SceneStep_s
+{
+    Scene *scene;
+    float timeStep;
+
+    /// @brief Grande île en cours de traitement.
+    int island;
+
+    /// @brief Position du premier ressort (de la couleur en cours de traitement)
+    /// ou indice de la première balle de la grande île.
+    int offset;
+
+    /// @brief Plus grand nombre d'itérations de l'intégrateur implicite pour une île.
+    int iterations;
+
+    /// @brief Protège l'énergie de la grande île en cours de traitement
+    /// et le nombre d'itérations de l'intégrateur implicite.
+    SDL_SpinLock lock;
+} SceneStep;
+
+/// @brief Simule entièrement des petites îles, chacune sur un seul thread.
+static void Scene_IslandTask(void *data, int first, int last)
+{
+    SceneStep *step = (SceneStep *)data;
+    Scene *scene = step->scene;
+    Islands *islands = scene->m_islands;
+
+    for (int i = first; i < last; ++i)
+    {
+        int island = islands->m_awake[i];
+        int firstBall = islands->m_ballStart[island];
+        int lastBall = islands->m_ballStart[island + 1];
+        if (lastBall - firstBall >= ISLAND_SPLIT_SIZE)
+            continue;
+
+        if (scene->m_solverMode == SOLVER_IMPLICIT)
+        {
+            int iterations = Implicit_SolveIsland(
+                scene->m_implicit, scene, island, step->timeStep, NULL,
+                &islands->m_energy[island]
+            );
+
+            SDL_AtomicLock(&step->lock);
+            step->iterations = SDL_max(step->iterations, iterations);
+            SDL_AtomicUnlock(&step->lock);
+            continue;
+        }
+
+        if (scene->m_solverMode == SOLVER_XPBD)
+        {
+            islands->m_energy[island] =
+                Xpbd_SolveIsland(scene->m_xpbd, scene, island, step->timeStep, NULL);
+            continue;
+        }
+
+        Ball_ApplySpringForces(
+            scene, islands->m_springOrder,
+            islands->m_springStart[island], islands->m_springStart[island + 1]
+        );
+        Ball_UpdateVelocity(scene, firstBall, lastBall, step->timeStep);
+        Ball_UpdatePosition(scene, firstBall, lastBall, step->timeStep);
+        islands->m_energy[island] = Ball_GetMaxKineticEnergy(scene, firstBall, lastBall);
+    }
+}
+
+/// @brief Applique les forces d'une partie des ressorts d'une couleur d'une grande île.
+static void Scene_SpringTask(void *data, int first, int last)
+{
+    SceneStep *step = (SceneStep *)data;
+    Ball_ApplySpringForces(
+        step->scene, step->scene->m_islands->m_springOrder,
+        step->offset + first, step->offset + last
+    );
+}
+
+/// @brief Intègre une partie des balles d'une grande île.
+static void Scene_BallTask(void *data, int first, int last)
+{
+    SceneStep *step = (SceneStep *)data;
+    Islands *islands = step->scene->m_islands;
+    first += step->offset;
+    last += step->offset;
+
+    Ball_UpdateVelocity(step->scene, first, last, step->timeStep);
+    Ball_UpdatePosition(step->scene, first, last, step->timeStep);
+
+    float energy = Ball_GetMaxKineticEnergy(step->scene, first, last);
+    SDL_AtomicLock(&step->lock);
+    if (energy > islands->m_energy[step->island])
+        islands->m_energy[step->island] = energy;
+    SDL_AtomicUnlock(&step->lock);
+}
+
+void Scene_FixedUpdate(Scene *scene, float timeStep)
+{
+    Springs *springs = scene->m_springs;
+    Islands *islands = scene->m_islands;
+    SceneStep step = {
+        .scene = scene, .timeStep = timeStep, .island = 0, .offset = 0, .iterations = 0, .lock = 0
+    };
+
+    // Le calcul des îles réordonne les balles
+    if (islands->m_dirty)
+    {
+        scene->m_gridDirty = true;
+        scene->m_topologyVersion++;
+    }
+
+    // Recalcule les îles si la topologie a changé
+    PROFILE_ZONE_BEGIN("Islands_Update");
+    int exitStatus = Islands_Update(islands, scene);
+    PROFILE_ZONE_END();
+    if (exitStatus == EXIT_FAILURE)
+        return;
+
+    // Positions de départ pour l'interpolation du rendu. Les balles endormies ne bougent pas :
+    // seules les balles des îles éveillées sont copiées.
+    for (int i = 0; i < islands->m_awakeCount; )
+    {
+        int island = islands->m_awake[i++];
+        int firstBall = islands->m_ballStart[island];
+
+        // Des îles éveillées consécutives forment une seule plage de balles
+        while ((i < islands->m_awakeCount) && (islands->m_awake[i] == island + 1))
+            island = islands->m_awake[i++];
+
+        Particles_SavePositions(scene->m_particles, firstBall, islands->m_ballStart[island + 1]);
+    }
+
+    if ((scene->m_solverMode == SOLVER_IMPLICIT)
+        && (Implicit_Reserve(scene->m_implicit, scene) == EXIT_FAILURE))
+        return;
+
+    if ((scene->m_solverMode == SOLVER_XPBD)
+        && (Xpbd_Reserve(scene->m_xpbd, scene) == EXIT_FAILURE))
+        return;
+
+    // Les îles sont indépendantes : chaque petite île éveillée est simulée par un seul thread
+    PROFILE_ZONE_BEGIN("Scene_SolveIslands");
+    ThreadPool_ParallelFor(
+        g_threadPool, islands->m_awakeCount, SCENE_ISLAND_BATCH, Scene_IslandTask, &step);
+
+    // Les grandes îles sont réparties entre tous les threads
+    for (int i = 0; i < islands->m_awakeCount; ++i)
+    {
+        int island = islands->m_awake[i];
+        int firstBall = islands->m_ballStart[island];
+        int lastBall = islands->m_ballStart[island + 1];
+        if (lastBall - firstBall < ISLAND_SPLIT_SIZE)
+            continue;
+
+        step.island = island;
+
+        if (scene->m_solverMode == SOLVER_IMPLICIT)
+        {
+            int iterations = Implicit_SolveIsland(
+                scene->m_implicit, scene, island, timeStep, g_threadPool,
+                &islands->m_energy[island]
+            );
+            step.iterations = SDL_max(step.iterations, iterations);
+            continue;
+        }
+
+        if (scene->m_solverMode == SOLVER_XPBD)
+        {
+            islands->m_energy[island] =
+                Xpbd_SolveIsland(scene->m_xpbd, scene, island, timeStep, g_threadPool);
+            continue;
+        }
+
+        // Deux ressorts d'une même couleur n'ont aucune balle en commun : chaque couleur
+        // est traitée en parallèle sans que deux threads n'écrivent dans la même case
+        for (int color = 0; color < springs->m_colorCount; ++color)
+        {
+            int first, last;
+            Islands_GetColorRange(islands, springs, island, color, &first, &last);
+
+            step.offset = first;
+            ThreadPool_ParallelFor(
+                g_threadPool, last - first, SCENE_SPRING_BATCH, Scene_SpringTask, &step);
+        }
+
+        // Chaque balle ne modifie que sa propre vitesse et sa propre position
+        step.offset = firstBall;
+        ThreadPool_ParallelFor(
+            g_threadPool, lastBall - firstBall, SCENE_BALL_BATCH, Scene_BallTask, &step);
+    }
+
+    PROFILE_ZONE_END();
+
+    scene->m_implicit->m_iterations = step.iterations;
+
+    // Sépare les balles qui se chevauchent
+    if (islands->m_awakeCount > 0)
+    {
+        PROFILE_ZONE_BEGIN("Collisions_Solve");
+        Collisions_Solve(scene->m_collisions, scene, g_threadPool);
+        PROFILE_ZONE_END();
+        scene->m_gridDirty = true;
+    }
+
+    // Endort les îles au repos
+    Islands_UpdateSleep(islands, scene);
+}
+
+void Scene_SetSolver(Scene *scene, SolverMode mode)
+{
+    Springs *springs = scene->m_springs;
+
+    if (mode == scene->m_solverMode)
+        return;
+
+    // Les méthodes implicite et XPBD restent stables avec des pas de temps plus grands
+    // et des ressorts plus raides
+    scene->m_solverMode = mode;
+    switch (mode)
+    {
+    case SOLVER_IMPLICIT:
+        scene->m_timeStep = IMPLICIT_TIME_STEP;
+        scene->m_springStiffness = IMPLICIT_SPRING_STIFFNESS;
+        break;
+
+    case SOLVER_XPBD:
+        scene->m_timeStep = XPBD_TIME_STEP;
+        scene->m_springStiffness = XPBD_SPRING_STIFFNESS;
+        break;
+
+    default:
+        scene->m_timeStep = 1.0f / 100.f;
+        scene->m_springStiffness = SPRING_STIFFNESS;
+        break;
+    }
+
+    for (int i = 0; i < springs->m_count; ++i)
+    {
+        springs->m_stiffness[i] = scene->m_springStiffness;
+    }
+
+    Islands_WakeAll(scene->m_islands);
+}
+
+/// Create and link the ball @ scene->m_mouPos to the n nearest balls which are not too far (max_length)
+int connect_n(Scene* scene, int n, int max_length) {
+    int ballCount = Scene_GetBallCount(scene);
+
+    if (n > ballCount) {
+        Scene_CreateBall(scene, scene->m_mousePos);
+        return EXIT_FAILURE;
+    }
+
+    Scene_GetNearestBalls(scene, scene->m_mousePos, scene->m_queries, n);
+
+    if (scene->m_validCount) {
+        BallId ball_created = Scene_CreateBall(scene, scene->m_mousePos);
+
+        for (int i = 0; i < scene->m_validCount; i++) {
+            Ball_Connect(scene, ball_created, scene->m_queries[i].ball, 2.3f);
+        }
+    } else {
+        Scene_CreateBall(scene, scene->m_mousePos);
+    }
+
+    if (n != scene->m_validCount) return EXIT_FAILURE;
+
+    return EXIT_SUCCESS;
+}
+
+// Some mode
+
+void luneMode(Scene* scene) {
+    scene->m_gameMode->gravity = LUNE_GRAVITY_ACCELERATION;
+    scene->m_gameMode->mass = LUNE_MASS;
+    scene->m_gameMode->rebond = LUNE_REBOND_COEFFICIENT;
+}
+
+void noGrav(Scene* scene) {
+    scene->m_gameMode->gravity = NOGRAV_GRAVITY_ACCELERATION;
+    scene->m_gameMode->mass = NOGRAV_MASS;
+    scene->m_gameMode->rebond = NOGRAV_REBOND_COEFFICIENT;
+
+    scene->m_gameMode->isNoGrav = true;
+}
+
+
+Vec2 Scene_UpdateView(Scene *scene)
+{
+    Input *input = Scene_GetInput(scene);
+    Camera *camera = Scene_GetCamera(scene);
+
+    // Calcule la position de la souris et son déplacement
+    Vec2 mousePos = Vec2_Set(0.0f, 0.0f);
+    Vec2 mouseDelta = Vec2_Set(0.0f, 0.0f);
+    Camera_ViewToWorld(camera, (float)input->mouseX, (float)input->mouseY, &mousePos);
+    Camera_ViewToWorld(
+        camera,
+        (float)(input->mouseX + input->mouseDeltaX),
+        (float)(input->mouseY + input->mouseDeltaY),
+        &mouseDelta
+    );
+    mouseDelta = Vec2_Sub(mouseDelta, mousePos);
+
+    // Zoom centré sur la souris
+    if (input->mouseWheel != 0)
+    {
+        Camera_Zoom(camera, powf(CAMERA_ZOOM_STEP, (float)-input->mouseWheel), mousePos);
+    }
+
+    // Déplacement de la caméra
+    if (input->mouseRDown)
+    {
+        Camera_Move(camera, Vec2_Scale(mouseDelta, -1.f));
+    }
+
+    return mousePos;
+}
+
+/// @brief Effectue l'action d'une touche (ou du clic gauche) sur la scène.
+/// Maintenus, seuls le clic gauche et la touche D répètent leur action (création et suppression
+/// de balles), au plus une fois par SCENE_HOLD_INTERVAL de temps réel : la cadence ne dépend
+/// pas du nombre de mises à jour du jeu.
+/// @param[in,out] scene la scène.
+/// @param[in] key la touche (SDL_Scancode) ou SDL_BUTTON_LEFT.
+/// @param[in] pressed vrai si la touche vient d'être enfoncée, faux si elle est maintenue.
+static void Scene_UpdateKey(Scene *scene, int key, bool pressed)
+{
+    Uint64 counter = SDL_GetPerformanceCounter();
+
+    if (!pressed) {
+        if ((key != SDL_BUTTON_LEFT) && (key != SDL_SCANCODE_D))
+            return;
+
+        double elapsed = 1e-9 * (double)Timer_TicksToNs(counter - scene->m_holdCounter);
+        if (elapsed < SCENE_HOLD_INTERVAL)
+            return;
+    }
+
+    switch (key) {
+        /// Is it a left click (create and link a ball)
+        case SDL_BUTTON_LEFT:
+            if (scene->m_mousePos.y > 0.0f) {
+                connect_n(scene, 3, scene->m_maxDistance);
+                scene->m_holdCounter = counter;
+            }
+            break;
+
+        /// Delete ball
+        case SDL_SCANCODE_D:
+            mayDeleteBall(scene, scene->m_mousePos);
+            scene->m_holdCounter = counter;
+            break;
+
+        /// teleport the ball
+        case SDL_SCANCODE_T:
+            if (scene->m_toMove && Particles_IsValid(scene->m_particles, scene->m_ballToMove) && Vec2_Distance(scene->m_mousePos, Ball_GetPosition(scene, scene->m_ballToMove)) < 0.2f) {
+                return;
+            } else if (scene->m_toMove) {
+                mayMoveBall(scene, scene->m_mousePos);
+                scene->m_toMove = false;
+            } else if (!scene->m_toMove) {
+                if (EXIT_FAILURE != Scene_GetNearestBalls(scene, scene->m_mousePos, scene->m_queries, 1) && scene->m_queries[0].distance < 0.2f) scene->m_ballToMove = scene->m_queries[0].ball;
+
+                scene->m_toMove = true;
+            }
+            break;
+
+        /// Moon mode
+        case SDL_SCANCODE_K:
+            if (!scene->m_gameMode->isMoon) {
+                luneMode(scene);
+            }
+            break;
+
+        /// Default settings
+        case SDL_SCANCODE_H:
+            setDefault(scene);
+            break;
+
+        /// No gravity mode
+        case SDL_SCANCODE_N:
+            if (!scene->m_gameMode->isNoGrav) {
+                noGrav(scene);
+            }
+            break;
+
+        /// Explicit integrator
+        case SDL_SCANCODE_1:
+            Scene_SetSolver(scene, SOLVER_EXPLICIT);
+            break;
+
+        /// Implicit integrator
+        case SDL_SCANCODE_2:
+            Scene_SetSolver(scene, SOLVER_IMPLICIT);
+            break;
+
+        /// XPBD solver (Gauss-Seidel)
+        case SDL_SCANCODE_3:
+            scene->m_xpbd->m_method = XPBD_GAUSS_SEIDEL;
+            Scene_SetSolver(scene, SOLVER_XPBD);
+            break;
+
+        /// XPBD solver (Jacobi)
+        case SDL_SCANCODE_4:
+            scene->m_xpbd->m_method = XPBD_JACOBI;
+            Scene_SetSolver(scene, SOLVER_XPBD);
+            break;
+
+        default:
+            break;
+    }
+}
+
+void Scene_UpdateGame(Scene *scene, const Input *input, Vec2 mousePos)
+{
+    // Met en pause (ou relance) la simulation
+    if (input->pausePressed)
+        Timer_SetPaused(scene->m_time, !Timer_IsPaused(scene->m_time));
+
+    // Initialise les requêtes
+    scene->m_validCount = 0;
+    scene->m_mousePos = mousePos;
+
+    // La caméra est déplacée (voir Scene_UpdateView())
+    if (input->mouseRDown)
+        return;
+
+    memset(scene->m_queries, 0x0, sizeof(BallQuery) * scene->m_maxBalls);
+
+    if (scene->m_gameMode->isDefault) {
+        setDefault(scene);
+    }
+
+    /// Keys / buttons hit since the last update, in order
+    for (int i = 0; i < input->hitCount; ++i) {
+        Scene_UpdateKey(scene, input->hits[i], true);
+    }
+
+    /// If a key / button is held
+    if (input->isHit) {
+        Scene_UpdateKey(scene, input->keyStatus, false);
+    } else {
+        /// Call Scene_GetNearestBalls to update scene->m_validCount
+        Scene_GetNearestBalls(scene, scene->m_mousePos, scene->m_queries, 3);
+    }
+}
+
+/// @brief Effectue les pas de temps fixes correspondant au temps accumulé.
+/// Le nombre de pas est limité par m_maxSubsteps et par le budget m_stepBudget : après une
+/// image lente, le moteur ne doit pas prendre toujours plus de retard (spirale de la mort).
+/// Le retard restant est alors abandonné ou conservé selon m_stepPolicy.
+static void Scene_Step(Scene *scene, float timeStep)
+{
+    Uint64 start = SDL_GetPerformanceCounter();
+    int substepCount = 0;
+
+    while (scene->m_accu >= timeStep && substepCount < scene->m_maxSubsteps)
+    {
+        // Prévoit la durée du prochain pas d'après la durée moyenne des précédents
+        double elapsed = (double)Timer_TicksToNs(SDL_GetPerformanceCounter() - start) * 1e-9;
+        if ((substepCount > 0) && (scene->m_stepBudget > 0.0)
+            && (elapsed + scene->m_stepCost > scene->m_stepBudget))
+            break;
+
+        Uint64 stepStart = SDL_GetPerformanceCounter();
+
+        PROFILE_ZONE_BEGIN("Scene_FixedUpdate");
+        Scene_FixedUpdate(scene, timeStep);
+        PROFILE_ZONE_END();
+
+        // Moyenne glissante de la durée d'un pas
+        double cost = (double)Timer_TicksToNs(SDL_GetPerformanceCounter() - stepStart) * 1e-9;
+        if (scene->m_stepCost > 0.0)
+            cost = 0.9 * scene->m_stepCost + 0.1 * cost;
+        scene->m_stepCost = cost;
+
+        scene->m_accu -= timeStep;
+        substepCount++;
+    }
+    scene->m_substepCount = substepCount;
+
+    if (scene->m_accu < timeStep)
+        return;
+
+    // Le moteur ne suit plus le temps réel : seule la fraction de pas est conservée
+    // (plus une image de retard au ralenti), le reste est abandonné
+    double debt = (scene->m_stepPolicy == STEP_POLICY_SLOW_MOTION)
+        ? (double)scene->m_maxSubsteps * timeStep : 0.0;
+    double keep = fmod(scene->m_accu, (double)timeStep) + debt;
+    if (scene->m_accu > keep)
+    {
+        scene->m_droppedTime += scene->m_accu - keep;
+        scene->m_accu = keep;
+    }
+}
+
+void Scene_Update(Scene *scene)
+{
+    float timeStep = scene->m_timeStep;
+
+    // Met à jour le moteur physique (pas de temps fixe)
+    Timer_Update(scene->m_time);
+    scene->m_accu += (double)Timer_GetDeltaNs(scene->m_time) * 1e-9;
+    Scene_Step(scene, timeStep);
+}
+
+/// @brief Indique si une position est dans un rectangle (bords compris).
+static bool Scene_IsInRect(float x, float y, float minX, float minY, float maxX, float maxY)
+{
+    return (x >= minX) && (x <= maxX) && (y >= minY) && (y <= maxY);
+}
+
+/// @brief Reconstruit la grille du rendu si un nouvel instantané a été publié.
+static int Scene_UpdateRenderGrid(Scene *scene, const Snapshot *snapshot)
+{
+    if (scene->m_renderSerial == snapshot->m_serial)
+        return EXIT_SUCCESS;
+
+    int exitStatus = Grid_Build(
+        scene->m_renderGrid, snapshot->m_posX, snapshot->m_posY, snapshot->m_ballCount);
+    if (exitStatus == EXIT_FAILURE) return EXIT_FAILURE;
+
+    scene->m_renderSerial = snapshot->m_serial;
+
+    return EXIT_SUCCESS;
+}
+
+void Scene_RenderBalls(Scene *scene, const Snapshot *snapshot, float alpha)
+{
+    int ballCount = snapshot->m_ballCount;
+    RenderStats *stats = &scene->m_renderStats;
+    Rect view = Camera_GetView(scene->m_camera);
+    LodLevel lod = Lod_GetLevel(scene->m_lod, scene->m_camera);
+
+    stats->drawnBalls = 0;
+    stats->drawnSprings = 0;
+    stats->lod = lod;
+
+    // Vue élargie de l'épaisseur d'une balle (et d'un ressort)
+    float viewMinX = view.x - BALL_RADIUS;
+    float viewMinY = view.y - BALL_RADIUS;
+    float viewMaxX = view.x + view.w + BALL_RADIUS;
+    float viewMaxY = view.y + view.h + BALL_RADIUS;
+
+    // Un ressort traversant la vue a ses deux extrémités à une distance de la vue inférieure
+    // à sa longueur : les balles recherchées couvrent donc les extrémités des ressorts visibles
+    // (la carte de densité ne dessine pas les ressorts)
+    float margin = SCENE_CULL_MARGIN;
+    if (lod != LOD_HEATMAP)
+        margin += SCENE_CULL_STRETCH * snapshot->m_maxSpringLength;
+    float minX = viewMinX - margin;
+    float minY = viewMinY - margin;
+    float maxX = viewMaxX + margin;
+    float maxY = viewMaxY + margin;
+
+    if (Scene_ReserveRender(scene, ballCount) == EXIT_FAILURE)
+    {
+        stats->culledBalls = ballCount;
+        stats->culledSprings = snapshot->m_springCount;
+        return;
+    }
+
+    int *indices = NULL;
+    int count = ballCount;
+    if (Scene_UpdateRenderGrid(scene, snapshot) == EXIT_SUCCESS)
+    {
+        indices = scene->m_renderIndices;
+        count = Grid_FindInRect(
+            scene->m_renderGrid, snapshot->m_posX, snapshot->m_posY,
+            minX, minY, maxX, maxY, indices
+        );
+    }
+
+    // Dessine les ressorts attachés aux balles trouvées
+    for (int k = 0; (k < count) && (lod != LOD_HEATMAP); k++)
+    {
+        int ball = indices ? indices[k] : k;
+        const BallLinks *links = &snapshot->m_links[ball];
+
+        for (int j = 0; j < links->springCount; j++)
+        {
+            int spring = links->springs[j];
+            int ball1 = snapshot->m_ball1[spring];
+
+            // Un ressort dont les deux balles ont été trouvées n'est dessiné
+            // qu'à partir de sa première balle
+            if ((ball != ball1) && (indices == NULL || Scene_IsInRect(
+                snapshot->m_posX[ball1], snapshot->m_posY[ball1], minX, minY, maxX, maxY)))
+                continue;
+
+            Vec2 start = Snapshot_GetInterpolatedPosition(snapshot, ball1, alpha);
+            Vec2 end = Snapshot_GetInterpolatedPosition(snapshot, snapshot->m_ball2[spring], alpha);
+
+            // Elimine les ressorts dont la boîte englobante est hors de la vue
+            if ((SDL_max(start.x, end.x) < viewMinX) || (SDL_min(start.x, end.x) > viewMaxX)
+                || (SDL_max(start.y, end.y) < viewMinY) || (SDL_min(start.y, end.y) > viewMaxY))
+                continue;
+
+            if (lod == LOD_SPRITES)
+                Ball_RenderSpring(start, end, scene, true);
+            else
+                Lod_AddLine(scene->m_lod, start, end);
+            stats->drawnSprings++;
+        }
+    }
+
+    // Rassemble les positions des balles visibles puis les dessine en une passe
+    float *renderX = scene->m_renderX;
+    float *renderY = scene->m_renderY;
+    for (int k = 0; k < count; k++)
+    {
+        int ball = indices ? indices[k] : k;
+        Vec2 position = Snapshot_GetInterpolatedPosition(snapshot, ball, alpha);
+
+        if (!Scene_IsInRect(position.x, position.y, viewMinX, viewMinY, viewMaxX, viewMaxY))
+            continue;
+
+        renderX[stats->drawnBalls] = position.x;
+        renderY[stats->drawnBalls] = position.y;
+        stats->drawnBalls++;
+    }
+
+    switch (lod)
+    {
+    case LOD_SPRITES:
+        Ball_Render(renderX, renderY, stats->drawnBalls, scene);
+        break;
+
+    case LOD_LINES:
+        Lod_RenderLines(scene->m_lod, scene, renderX, renderY, stats->drawnBalls);
+        break;
+
+    default:
+        Lod_RenderHeatmap(scene->m_lod, scene, renderX, renderY, stats->drawnBalls);
+        break;
+    }
+
+    stats->culledBalls = ballCount - stats->drawnBalls;
+    stats->culledSprings = snapshot->m_springCount - stats->drawnSprings;
+}
+
+void Scene_Render(Scene *scene)
+{
+    // Dernier état publié par le moteur physique (ne bloque jamais)
+    const Snapshot *snapshot = SnapshotBuffer_Acquire(scene->m_snapshots);
+    float alpha = Snapshot_GetAlpha(snapshot);
+
+    scene->m_renderStats.drawnTiles = 0;
+
+    // Le moteur de rendu a perdu le contenu de ses textures cibles
+    if (scene->m_input->renderTargetsReset)
+        BackgroundCache_Invalidate(scene->m_background);
+
+    // Dessine le fond (avec parallax) et le sol, recomposés seulement si la caméra a bougé
+    PROFILE_ZONE_BEGIN("BackgroundCache_Render");
+    BackgroundCache_Render(scene->m_background, scene);
+    PROFILE_ZONE_END();
+
+    if (scene->m_input->mouseRDown == false)
+    {
+        // Dessine les ressorts inactifs
+        for (int i = 0; i < snapshot->m_previewCount; ++i)
+        {
+            Vec2 start = snapshot->m_mousePos;
+            Vec2 end = Snapshot_GetInterpolatedPosition(snapshot, snapshot->m_previewBalls[i], alpha);
+
+            Ball_RenderSpring(start, end, scene, false);
+        }
+    }
+
+    // Dessine les balles (avec les ressorts actifs)
+    PROFILE_ZONE_BEGIN("Scene_RenderBalls");
+    Scene_RenderBalls(scene, snapshot, alpha);
+    PROFILE_ZONE_END();
+}
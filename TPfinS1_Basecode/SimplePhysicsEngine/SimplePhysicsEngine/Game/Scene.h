@@ -1,182 +1,423 @@
-﻿#ifndef _SCENE_H_
-#define _SCENE_H_
-
-/// @file scene.h
-/// @defgroup Scene
-/// @{
-
-#include "../Settings.h"
-#include "../Utils/Renderer.h"
-
-#include "Ball.h"
-#include "Camera.h"
-#include "Textures.h"
-#include "Input.h"
-
-#define LUNE_GRAVITY_ACCELERATION 0.1f
-#define LUNE_MASS 0.5f
-#define LUNE_REBOND_COEFFICIENT 0.8f
-
-#define NOGRAV_GRAVITY_ACCELERATION 0.0f
-#define NOGRAV_MASS 0.1f
-#define NOGRAV_REBOND_COEFFICIENT 0.8f
-
-/// @brief Structure représentant le résultat d'une recherche de balle.
-typedef struct BallQuery_s
-{
-    /// @brief Pointeur vers la balle.
-    Ball *ball;
-
-    /// @brief Distance entre la balle et la position donnée.
-    float distance;
-} BallQuery;
-
-#define MAX_QUERY_COUNT 4
-
-typedef struct gameMode_s
-{
-    float mass;
-    float gravity;
-    float rebond;
-    _Bool isMoon;
-    _Bool isNoGrav;
-    _Bool isDefault;
-} gameMode_t;
-
-/// @brief Structure représentant la scène de la simulation.
-/// Elle contient la caméra par laquelle la scène est vue ainsi que toutes les balles.
-typedef struct Scene_s
-{
-    /// @brief Moteur de rendu.
-    Renderer *m_renderer;
-
-    Input *m_input;
-
-    /// @brief Caméra par laquelle la scène est vue.
-    Camera *m_camera;
-
-    Textures *m_textures;
-
-    /// @brief Tableau contenant les balles présentes dans la scène.
-    Ball *m_balls;
-
-    /// @brief Nombre de balles dans la scène.
-    int m_ballCount;
-
-    /// @brief Nombre maximal de balles avant d'effectuer une réallocation mémoire.
-    int m_ballCapacity;
-
-    /// @brief Position de la souris dans le référentiel monde.
-    Vec2 m_mousePos;
-
-    /// @brief Dernières requêtes effectuées sur les balles.
-    BallQuery* m_queries;
-
-    /// @brief Nombre de requêtes valides.
-    int m_validCount;
-
-    /// @brief Pas de temps fixe utilisé pour la physique.
-    float m_timeStep;
-
-    /// @brief Accumulateur pour le pas de temps fixe.
-    float m_accu;
-
-    /// @brief Nombre de balles maximum
-    int m_maxBalls;
-
-    /// Distance maximale
-    float m_maxDistance;
-
-    /// Nouvelle coordonnée
-    _Bool m_toMove;
-
-    /// ball we have to move
-    Ball* m_ballToMove;
-
-    /// pointer toward the gameMode structure holding some values to describre the physics
-    gameMode_t* m_gameMode;
-
-    /// flusher 
-    unsigned long flusher;
-} Scene;
-
-/// @brief Construit une scène.
-/// @param[in] renderer le moteur de rendu.
-/// @return La scène créée. Renvoie NULL en cas d'erreur.
-Scene *Scene_New(Renderer *renderer, int max_connections, float maxDistance);
-
-/// @brief Détruit une scène précédemment construite avec Scene_New().
-/// Le pointeur vers la scène doit être affecté à NULL après l'appel à cette fonction.
-/// @param[in,out] scene la scène à détruire.
-void Scene_Free(Scene *scene);
-
-/// @brief Renvoie le moteur de rendu associé à la scène.
-/// @param[in] scene la scène.
-/// @return Le moteur de rendu associé à la scène.
-Renderer *Scene_GetRenderer(Scene *scene);
-
-/// @brief Renvoie la caméra par laquelle la scène est vue.
-/// @param[in] scene la scène.
-/// @return La caméra associée à la scène.
-Camera *Scene_GetCamera(Scene *scene);
-
-Input *Scene_GetInput(Scene *scene);
-
-/// @brief Renvoie la position de la souris dans le référentiel monde.
-/// @param scene la scène.
-/// @return La position de la souris dans le référentiel monde.
-Vec2 Scene_GetMousePosition(Scene *scene);
-
-/// @brief Ajoute une balle à la scène.
-/// @param[in,out] scene la scène.
-/// @param[in] position la position de la nouvelle balle.
-/// @return EXIT_SUCCESS ou EXIT_FAILURE.
-Ball *Scene_CreateBall(Scene *scene, Vec2 position);
-
-/// @brief Supprime une balle de la scène.
-/// Les adresses des balles sont invalidées après l'appel à cette fonction.
-/// @param[in,out] scene la scène.
-/// @param[in,out] ball pointeur vers la balle à supprimer.
-void Scene_RemoveBall(Scene *scene, Ball *ball);
-
-/// @brief Renvoie le nombre de balles présentes dans la scène.
-/// @param[in] scene la scène.
-/// @return Le nombre de balles présentes dans la scène.
-int Scene_GetBallCount(Scene *scene);
-
-/// @brief Renvoie le tableau contenant les balles présentes dans la scène.
-/// La taille de ce tableau s'obtient avec la fonction Scene_GetBallCount().
-/// @param[in] scene la scène.
-/// @return Le tableau contenant les balles présentes dans la scène.
-Ball *Scene_GetBalls(Scene *scene);
-
-/// @brief Met à jour les positions des balles présentes dans la scène.
-/// Cette fonction correspond au moteur physique.
-/// @param[in,out] scene la scène.
-void Scene_Update(Scene *scene);
-
-/// @brief Calcule le rendu de la scène vue par sa caméra.
-/// @param[in] scene la scène à rendre.
-void Scene_Render(Scene *scene);
-
-//-------------------------------------------------------------------------------------------------
-// Fonctions de recherche
-
-/// @brief Recherche dans une scène la balle la plus proche d'une position donnée.
-/// @param[in] scene la scène dans laquelle faire la recherche.
-/// @param[in] position la position autour de laquelle faire la recherche.
-/// @return Une structure BallQuery contenant un pointeur vers la balle la plus proche
-/// ainsi que sa distance avec la position spécifiée.
-/// Si la scène ne contient aucune balle, le pointeur vers la balle vaut NULL.
-BallQuery Scene_GetNearestBall(Scene *scene, Vec2 position);
-
-/// @brief Recherche dans une scène les balles les plus proches d'une position donnée.
-/// @param[in] scene la scène dans laquelle faire la recherche.
-/// @param[in] position la position autour de laquelle faire la recherche.
-/// @param[out] queries tableau dans lequel vont être écrit les résultats.
-/// Il doit contenir au moins queryCount cases.
-/// @param[in] queryCount le nombre de balles à rechercher.
-/// @return EXIT_SUCCESS ou EXIT_FAILURE. Le resultat de la recherche est écrit dans le tableau queries.
-int Scene_GetNearestBalls(Scene *scene, Vec2 position, BallQuery *queries, int queryCount);
-
-#endif
+﻿#ifndef _SCENE_H_
+#define _SCENE_H_
+
+/// @file scene.h
+/// @defgroup Scene
+/// @{
+
+#include "../Settings.h"
+#include "../Utils/Renderer.h"
+#include "../Utils/Timer.h"
+#include "../Utils/SpriteBatch.h"
+
+#include "Ball.h"
+#include "Particles.h"
+#include "Springs.h"
+#include "Islands.h"
+#include "Implicit.h"
+#include "Xpbd.h"
+#include "Grid.h"
+#include "Collisions.h"
+#include "Lod.h"
+#include "Background.h"
+#include "Snapshot.h"
+#include "Camera.h"
+#include "Textures.h"
+#include "Input.h"
+
+typedef struct Simulation_s Simulation;
+
+#define LUNE_GRAVITY_ACCELERATION 0.1f
+#define LUNE_MASS 0.5f
+#define LUNE_REBOND_COEFFICIENT 0.8f
+
+#define NOGRAV_GRAVITY_ACCELERATION 0.0f
+#define NOGRAV_MASS 0.1f
+#define NOGRAV_REBOND_COEFFICIENT 0.8f
+
+/// @brief Structure représentant le résultat d'une recherche de balle.
+typedef struct BallQuery_s
+{
+    /// @brief Identifiant de la balle.
+    BallId ball;
+
+    /// @brief Distance entre la balle et la position donnée.
+    float distance;
+} BallQuery;
+
+#define MAX_QUERY_COUNT 4
+
+/// @brief Méthode d'intégration utilisée par le moteur physique.
+typedef enum SolverMode_e
+{
+    /// @brief Euler explicite (pas de temps de 1/100 s).
+    SOLVER_EXPLICIT,
+
+    /// @brief Euler implicite résolu par gradient conjugué (voir ImplicitSolver).
+    SOLVER_IMPLICIT,
+
+    /// @brief Dynamique basée sur les positions (voir XpbdSolver).
+    SOLVER_XPBD,
+} SolverMode;
+
+/// @brief Nombre maximal de pas de temps fixes effectués par image, par défaut.
+#define SCENE_MAX_SUBSTEPS 8
+
+/// @brief Durée réelle maximale (exprimée en s) consacrée à la physique par image, par défaut.
+#define SCENE_STEP_BUDGET (1.0 / 40.0)
+
+/// @brief Comportement du moteur physique lorsqu'il ne parvient plus à suivre le temps réel
+/// (nombre maximal de pas de temps ou budget atteint).
+typedef enum StepPolicy_e
+{
+    /// @brief Abandonne le retard : la simulation saute le temps qu'elle n'a pas pu simuler.
+    STEP_POLICY_DROP,
+
+    /// @brief Conserve au plus une image de retard : la simulation ralentit et rattrape
+    /// son retard dès que la charge diminue.
+    STEP_POLICY_SLOW_MOTION,
+} StepPolicy;
+
+/// @brief Durée réelle (exprimée en s) entre deux balles créées ou supprimées tant que le clic
+/// gauche ou la touche D est maintenu.
+#define SCENE_HOLD_INTERVAL (5.0 / 60.0)
+
+/// @brief Marge (exprimée en m) ajoutée à la vue pour rechercher les balles à dessiner.
+/// La grille indexe les positions de la fin du pas de temps alors que les balles sont dessinées
+/// à des positions interpolées : une balle plus rapide que SCENE_CULL_MARGIN par pas de temps
+/// peut disparaître pendant une image au bord de l'écran.
+#define SCENE_CULL_MARGIN 0.5f
+
+/// @brief Allongement maximal (relatif à la plus grande longueur au repos) d'un ressort
+/// dessiné alors que ses deux extrémités sont hors de la vue.
+#define SCENE_CULL_STRETCH 2.0f
+
+/// @brief Statistiques du rendu de la dernière image.
+typedef struct RenderStats_s
+{
+    /// @brief Nombre de balles dessinées et éliminées (hors de la vue).
+    int drawnBalls, culledBalls;
+
+    /// @brief Nombre de ressorts dessinés et éliminés (hors de la vue).
+    int drawnSprings, culledSprings;
+
+    /// @brief Nombre de tuiles (sol et calques du fond) dessinées.
+    int drawnTiles;
+
+    /// @brief Niveau de détail utilisé.
+    LodLevel lod;
+} RenderStats;
+
+typedef struct gameMode_s
+{
+    float mass;
+    float gravity;
+    float rebond;
+    _Bool isMoon;
+    _Bool isNoGrav;
+    _Bool isDefault;
+} gameMode_t;
+
+/// @brief Structure représentant la scène de la simulation.
+/// Elle contient la caméra par laquelle la scène est vue ainsi que toutes les balles.
+typedef struct Scene_s
+{
+    /// @brief Moteur de rendu.
+    Renderer *m_renderer;
+
+    Input *m_input;
+
+    /// @brief Caméra par laquelle la scène est vue.
+    Camera *m_camera;
+
+    Textures *m_textures;
+
+    /// @brief Lot de sprites dans lequel sont dessinés les balles et les ressorts.
+    SpriteBatch *m_batch;
+
+    /// @brief Politique de niveau de détail du rendu des balles et des ressorts.
+    Lod *m_lod;
+
+    /// @brief Fond et sol composés dans une texture cible.
+    BackgroundCache *m_background;
+
+    /// @brief Instantanés de la scène publiés par le moteur physique et lus par le rendu.
+    SnapshotBuffer *m_snapshots;
+
+    /// @brief Thread de simulation exécutant le moteur physique et la logique du jeu,
+    /// ou NULL s'ils sont exécutés par le pipeline du thread principal.
+    /// Il n'appartient pas à la scène (voir Simulation_New()).
+    Simulation *m_simulation;
+
+    /// @brief Grandeurs physiques des balles présentes dans la scène.
+    Particles *m_particles;
+
+    /// @brief Liste de tous les ressorts de la scène.
+    Springs *m_springs;
+
+    /// @brief Tableau contenant la topologie (les indices des ressorts) de chaque balle.
+    /// Il est indexé comme m_particles.
+    BallLinks *m_links;
+
+    /// @brief Décomposition des balles en îles indépendantes.
+    Islands *m_islands;
+
+    /// @brief Nombre maximal de balles avant d'effectuer une réallocation mémoire.
+    int m_ballCapacity;
+
+    /// @brief Version de la topologie, incrémentée à chaque ajout ou suppression de balle ou de
+    /// ressort et à chaque réorganisation des balles (voir Snapshot).
+    Uint32 m_topologyVersion;
+
+    /// @brief Position de la souris dans le référentiel monde.
+    Vec2 m_mousePos;
+
+    /// @brief Dernières requêtes effectuées sur les balles.
+    BallQuery* m_queries;
+
+    /// @brief Nombre de requêtes valides.
+    int m_validCount;
+
+    /// @brief Indices et distances des balles trouvées par la dernière recherche.
+    int *m_queryIndices;
+    float *m_queryDistances;
+
+    /// @brief Nombre maximal de résultats d'une recherche avant d'effectuer une réallocation.
+    int m_queryCapacity;
+
+    /// @brief Positions des balles à dessiner (transformées en une passe vers le référentiel
+    /// caméra).
+    float *m_renderX, *m_renderY;
+
+    /// @brief Indices des balles de l'instantané proches de la vue.
+    int *m_renderIndices;
+
+    /// @brief Nombre maximal de balles à dessiner avant d'effectuer une réallocation.
+    int m_renderCapacity;
+
+    /// @brief Grille indexant les positions de l'instantané lu par le rendu.
+    /// Elle est distincte de m_grid, utilisée par le moteur physique sur son propre thread.
+    Grid *m_renderGrid;
+
+    /// @brief Numéro de l'instantané indexé par m_renderGrid.
+    Uint64 m_renderSerial;
+
+    /// @brief Pas de temps fixe utilisé pour la physique.
+    float m_timeStep;
+
+    /// @brief Méthode d'intégration utilisée pour la physique.
+    SolverMode m_solverMode;
+
+    /// @brief Intégrateur implicite (utilisé avec SOLVER_IMPLICIT).
+    ImplicitSolver *m_implicit;
+
+    /// @brief Solveur XPBD (utilisé avec SOLVER_XPBD).
+    XpbdSolver *m_xpbd;
+
+    /// @brief Grille uniforme indexant les positions des balles pour les recherches.
+    Grid *m_grid;
+
+    /// @brief Indique que les balles ont bougé depuis la dernière construction de la grille.
+    /// La grille est alors reconstruite avant la prochaine recherche.
+    bool m_gridDirty;
+
+    /// @brief Solveur des collisions entre balles.
+    Collisions *m_collisions;
+
+    /// @brief Raideur des ressorts (exprimée en N/m).
+    float m_springStiffness;
+
+    /// @brief Horloge de la simulation (peut être mise en pause ou ralentie).
+    Timer *m_time;
+
+    /// @brief Accumulateur pour le pas de temps fixe (exprimé en s).
+    double m_accu;
+
+    /// @brief Nombre maximal de pas de temps fixes par image.
+    int m_maxSubsteps;
+
+    /// @brief Durée réelle maximale (exprimée en s) consacrée à la physique par image
+    /// (0 pour ne pas limiter la durée).
+    double m_stepBudget;
+
+    /// @brief Comportement lorsque le moteur physique ne suit plus le temps réel.
+    StepPolicy m_stepPolicy;
+
+    /// @brief Durée réelle moyenne d'un pas de temps fixe (exprimée en s).
+    double m_stepCost;
+
+    /// @brief Nombre de pas de temps fixes effectués lors de la dernière image.
+    int m_substepCount;
+
+    /// @brief Temps de simulation abandonné depuis la création de la scène (exprimé en s).
+    double m_droppedTime;
+
+    /// @brief Statistiques du rendu de la dernière image.
+    RenderStats m_renderStats;
+
+    /// @brief Nombre de balles maximum
+    int m_maxBalls;
+
+    /// Distance maximale
+    float m_maxDistance;
+
+    /// Nouvelle coordonnée
+    _Bool m_toMove;
+
+    /// id of the ball we have to move
+    BallId m_ballToMove;
+
+    /// pointer toward the gameMode structure holding some values to describre the physics
+    gameMode_t* m_gameMode;
+
+    /// @brief Valeur du compteur haute résolution lors de la dernière balle créée ou supprimée
+    /// (voir SCENE_HOLD_INTERVAL).
+    Uint64 m_holdCounter;
+} Scene;
+
+/// @brief Construit une scène.
+/// @param[in] renderer le moteur de rendu, ou NULL pour une simulation sans fenêtre.
+/// Une scène sans moteur de rendu n'a ni textures, ni caméra, ni entrées : seules
+/// Scene_FixedUpdate() et les fonctions de manipulation des balles peuvent être utilisées.
+/// @return La scène créée. Renvoie NULL en cas d'erreur.
+Scene *Scene_New(Renderer *renderer, int max_connections, float maxDistance);
+
+/// @brief Détruit une scène précédemment construite avec Scene_New().
+/// Le pointeur vers la scène doit être affecté à NULL après l'appel à cette fonction.
+/// @param[in,out] scene la scène à détruire.
+void Scene_Free(Scene *scene);
+
+/// @brief Renvoie le moteur de rendu associé à la scène.
+/// @param[in] scene la scène.
+/// @return Le moteur de rendu associé à la scène.
+Renderer *Scene_GetRenderer(Scene *scene);
+
+/// @brief Renvoie la caméra par laquelle la scène est vue.
+/// @param[in] scene la scène.
+/// @return La caméra associée à la scène.
+Camera *Scene_GetCamera(Scene *scene);
+
+Input *Scene_GetInput(Scene *scene);
+
+/// @brief Renvoie la position de la souris dans le référentiel monde.
+/// @param scene la scène.
+/// @return La position de la souris dans le référentiel monde.
+Vec2 Scene_GetMousePosition(Scene *scene);
+
+/// @brief Ajoute une balle à la scène.
+/// @param[in,out] scene la scène.
+/// @param[in] position la position de la nouvelle balle.
+/// @return L'identifiant de la balle créée ou BALL_NONE en cas d'erreur.
+BallId Scene_CreateBall(Scene *scene, Vec2 position);
+
+/// @brief Supprime une balle de la scène ainsi que ses ressorts.
+/// Les identifiants des autres balles restent valides.
+/// @param[in,out] scene la scène.
+/// @param[in] ball l'identifiant de la balle à supprimer.
+void Scene_RemoveBall(Scene *scene, BallId ball);
+
+/// @brief Supprime toutes les balles et tous les ressorts de la scène.
+/// @param[in,out] scene la scène.
+void Scene_Clear(Scene *scene);
+
+/// @brief Remplace le contenu de la scène par celui d'un fichier texte.
+/// Chaque ligne du fichier est vide, un commentaire (commençant par #) ou de la forme
+/// "ball x y" ou "spring i j longueur", où i et j sont les numéros des balles
+/// dans l'ordre du fichier (à partir de 0).
+/// @param[in,out] scene la scène.
+/// @param[in] path le chemin du fichier.
+/// @return EXIT_SUCCESS ou EXIT_FAILURE.
+int Scene_Load(Scene *scene, const char *path);
+
+/// @brief Enregistre les positions des balles et les ressorts de la scène dans un fichier
+/// texte lisible par Scene_Load().
+/// @param[in] scene la scène.
+/// @param[in] path le chemin du fichier.
+/// @return EXIT_SUCCESS ou EXIT_FAILURE.
+int Scene_Save(Scene *scene, const char *path);
+
+/// @brief Renvoie le nombre de balles présentes dans la scène.
+/// @param[in] scene la scène.
+/// @return Le nombre de balles présentes dans la scène.
+int Scene_GetBallCount(Scene *scene);
+
+/// @brief Renvoie le stockage contenant les balles présentes dans la scène.
+/// Le nombre de balles s'obtient avec la fonction Scene_GetBallCount().
+/// @param[in] scene la scène.
+/// @return Le stockage (structure de tableaux) des balles présentes dans la scène.
+Particles *Scene_GetBalls(Scene *scene);
+
+/// @brief Met à jour les positions des balles présentes dans la scène.
+/// Cette fonction correspond au moteur physique : elle effectue les pas de temps fixes
+/// correspondant au temps écoulé sur l'horloge de la scène.
+/// @param[in,out] scene la scène.
+void Scene_Update(Scene *scene);
+
+/// @brief Met à jour la vue en fonction des entrées de l'utilisateur (zoom et déplacement de
+/// la caméra). N'accède ni aux balles, ni aux ressorts : elle est exécutée par le thread
+/// principal pendant que le moteur physique tourne.
+/// @param[in,out] scene la scène.
+/// @return La position de la souris dans le référentiel monde.
+Vec2 Scene_UpdateView(Scene *scene);
+
+/// @brief Met à jour le jeu en fonction des entrées de l'utilisateur (création, suppression
+/// et déplacement des balles, modes de jeu).
+/// Doit être appelée par le thread qui exécute le moteur physique.
+/// @param[in,out] scene la scène.
+/// @param[in] input les entrées de l'utilisateur.
+/// @param[in] mousePos la position de la souris dans le référentiel monde
+/// (voir Scene_UpdateView()).
+void Scene_UpdateGame(Scene *scene, const Input *input, Vec2 mousePos);
+
+/// @brief Effectue un pas de temps de la physique.
+/// Ne dépend ni du rendu, ni des entrées : peut être utilisée sans fenêtre.
+/// @param[in,out] scene la scène.
+/// @param[in] timeStep le pas de temps.
+void Scene_FixedUpdate(Scene *scene, float timeStep);
+
+/// @brief Change la méthode d'intégration utilisée par le moteur physique.
+/// Le pas de temps et la raideur de tous les ressorts sont adaptés à la méthode choisie.
+/// @param[in,out] scene la scène.
+/// @param[in] mode la méthode d'intégration.
+void Scene_SetSolver(Scene *scene, SolverMode mode);
+
+/// @brief Calcule le rendu de la scène vue par sa caméra.
+/// Les balles et les ressorts sont lus dans le dernier instantané publié (voir m_snapshots) :
+/// le rendu n'attend jamais le moteur physique.
+/// Les balles et les ressorts sont ajoutés au lot de sprites m_batch : ils ne sont dessinés
+/// qu'à l'appel de SpriteBatch_Flush().
+/// Seuls les objets visibles sont ajoutés : les balles proches de la vue sont recherchées dans
+/// la grille m_renderGrid et les ressorts sont trouvés à partir de leurs extrémités. Le nombre d'objets
+/// dessinés et éliminés est écrit dans m_renderStats.
+/// Selon l'échelle de la caméra, les balles et les ressorts sont dessinés par des sprites,
+/// par des points et des segments, ou par une carte de densité (voir m_lod).
+/// @param[in] scene la scène à rendre.
+void Scene_Render(Scene *scene);
+
+//-------------------------------------------------------------------------------------------------
+// Fonctions de recherche
+
+/// @brief Recherche dans une scène les balles les plus proches d'une position donnée.
+/// @param[in] scene la scène dans laquelle faire la recherche.
+/// @param[in] position la position autour de laquelle faire la recherche.
+/// @param[out] queries tableau dans lequel vont être écrit les résultats.
+/// Il doit contenir au moins queryCount cases.
+/// @param[in] queryCount le nombre de balles à rechercher.
+/// @return EXIT_SUCCESS ou EXIT_FAILURE. Le resultat de la recherche est écrit dans le tableau queries.
+int Scene_GetNearestBalls(Scene *scene, Vec2 position, BallQuery *queries, int queryCount);
+
+/// @brief Recherche dans une scène les balles situées à une distance strictement inférieure
+/// à radius d'une position donnée.
+/// Les résultats sont triés par distance croissante ; seules les maxCount balles les plus
+/// proches sont conservées.
+/// @param[in] scene la scène dans laquelle faire la recherche.
+/// @param[in] position la position autour de laquelle faire la recherche.
+/// @param[in] radius le rayon de recherche.
+/// @param[out] queries tableau dans lequel vont être écrit les résultats.
+/// Il doit contenir au moins maxCount cases.
+/// @param[in] maxCount le nombre maximal de balles à rechercher.
+/// @return Le nombre de balles trouvées ou -1 en cas d'erreur.
+int Scene_GetBallsInRadius(
+    Scene *scene, Vec2 position, float radius, BallQuery *queries, int maxCount);
+
+#endif
@@ -0,0 +1,180 @@
+﻿#include "Simulation.h"
+#include "Scene.h"
+#include "../Utils/Timer.h"
+#include "../Utils/ThreadPool.h"
+#include "../Utils/Profiler.h"
+
+Simulation *Simulation_New(Scene *scene)
+{
+    Simulation *simulation = NULL;
+
+    simulation = (Simulation *)calloc(1, sizeof(Simulation));
+    if (!simulation) goto ERROR_LABEL;
+
+    simulation->m_wakeUp = SDL_CreateSemaphore(0);
+    if (!simulation->m_wakeUp) goto ERROR_LABEL;
+
+    simulation->m_scene = scene;
+
+    return simulation;
+
+ERROR_LABEL:
+    printf("ERROR - Simulation_New()\n");
+    assert(false);
+    Simulation_Free(simulation);
+    return NULL;
+}
+
+void Simulation_Free(Simulation *simulation)
+{
+    if (!simulation) return;
+
+    Simulation_Stop(simulation);
+
+    if (simulation->m_wakeUp)
+    {
+        SDL_DestroySemaphore(simulation->m_wakeUp);
+    }
+
+    memset(simulation, 0, sizeof(Simulation));
+    free(simulation);
+}
+
+/// @brief Récupère les entrées transmises depuis le dernier appel.
+/// @return true si de nouvelles entrées sont disponibles.
+static bool Simulation_TakeInput(
+    Simulation *simulation, Uint64 *serial, Input *input, Vec2 *mousePos)
+{
+    bool available = false;
+
+    SDL_AtomicLock(&simulation->m_inputLock);
+    if (simulation->m_inputSerial != *serial)
+    {
+        *serial = simulation->m_inputSerial;
+        *input = simulation->m_input;
+        *mousePos = simulation->m_mousePos;
+        Input_ClearPresses(&simulation->m_input);
+        available = true;
+    }
+    SDL_AtomicUnlock(&simulation->m_inputLock);
+
+    return available;
+}
+
+/// @brief Attend le prochain pas de temps ou de nouvelles entrées.
+static void Simulation_Wait(Simulation *simulation)
+{
+    Scene *scene = simulation->m_scene;
+    Timer *time = scene->m_time;
+
+    // Temps réel restant avant que le temps accumulé n'atteigne un pas de temps
+    double wait = scene->m_timeStep;
+    double scale = Timer_IsPaused(time) ? 0.0 : time->m_scale;
+    if (scale > 0.0)
+        wait = (scene->m_timeStep - scene->m_accu) / scale;
+
+    // Le moteur est en retard : le pas suivant est effectué immédiatement
+    if (wait <= 0.0)
+        return;
+
+    Uint32 timeout = (Uint32)SDL_min(ceil(1000.0 * wait), 1000.0);
+    PROFILE_ZONE_BEGIN("Simulation_Wait");
+    SDL_SemWaitTimeout(simulation->m_wakeUp, timeout);
+    PROFILE_ZONE_END();
+}
+
+/// @brief Boucle du thread de simulation.
+static int Simulation_Main(void *data)
+{
+    Simulation *simulation = (Simulation *)data;
+    Scene *scene = simulation->m_scene;
+    Uint64 inputSerial = 0;
+    Input input;
+    Vec2 mousePos;
+
+    PROFILE_THREAD_NAME("Simulation");
+
+    // Ce thread lance les tâches du moteur physique : il est le thread 0 du groupe
+    ThreadPool_PinCallingThread(g_threadPool);
+
+    while (SDL_AtomicGet(&simulation->m_running))
+    {
+        // Logique du jeu, une fois par image du thread principal
+        bool hasInput = Simulation_TakeInput(simulation, &inputSerial, &input, &mousePos);
+        if (hasInput)
+        {
+            PROFILE_ZONE_BEGIN("Scene_UpdateGame");
+            Scene_UpdateGame(scene, &input, mousePos);
+            PROFILE_ZONE_END();
+        }
+
+        PROFILE_ZONE_BEGIN("Scene_Update");
+        Scene_Update(scene);
+        PROFILE_ZONE_END();
+
+        // Publie l'état de la scène s'il a changé
+        if (hasInput || (scene->m_substepCount > 0))
+        {
+            PROFILE_ZONE_BEGIN("SnapshotBuffer_Publish");
+            SnapshotBuffer_Publish(scene->m_snapshots, scene);
+            PROFILE_ZONE_END();
+        }
+
+        Simulation_Wait(simulation);
+    }
+
+    return 0;
+}
+
+int Simulation_Start(Simulation *simulation)
+{
+    Scene *scene = simulation->m_scene;
+
+    if (simulation->m_thread)
+        return EXIT_SUCCESS;
+
+    // Le rendu dispose de l'état initial de la scène avant le premier pas de temps
+    int exitStatus = SnapshotBuffer_Publish(scene->m_snapshots, scene);
+    if (exitStatus == EXIT_FAILURE) goto ERROR_LABEL;
+
+    // Le temps écoulé pendant l'arrêt du thread n'est pas simulé
+    Timer_Update(scene->m_time);
+
+    SDL_AtomicSet(&simulation->m_running, 1);
+    simulation->m_thread = SDL_CreateThread(Simulation_Main, "Simulation", simulation);
+    if (!simulation->m_thread) goto ERROR_LABEL;
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - Simulation_Start()\n");
+    SDL_AtomicSet(&simulation->m_running, 0);
+    return EXIT_FAILURE;
+}
+
+void Simulation_Stop(Simulation *simulation)
+{
+    if (!simulation->m_thread)
+        return;
+
+    SDL_AtomicSet(&simulation->m_running, 0);
+    SDL_SemPost(simulation->m_wakeUp);
+    SDL_WaitThread(simulation->m_thread, NULL);
+    simulation->m_thread = NULL;
+
+    // Vide les réveils restants
+    while (SDL_SemTryWait(simulation->m_wakeUp) == 0);
+}
+
+void Simulation_PostInput(Simulation *simulation, const Input *input, Vec2 mousePos)
+{
+    SDL_AtomicLock(&simulation->m_inputLock);
+    Input previous = simulation->m_input;
+    simulation->m_input = *input;
+    Input_Merge(&simulation->m_input, &previous);
+    simulation->m_mousePos = mousePos;
+    simulation->m_inputSerial++;
+    SDL_AtomicUnlock(&simulation->m_inputLock);
+
+    SDL_SemPost(simulation->m_wakeUp);
+}
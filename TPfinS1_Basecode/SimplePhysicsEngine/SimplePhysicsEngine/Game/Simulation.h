@@ -0,0 +1,83 @@
+﻿#ifndef _SIMULATION_H_
+#define _SIMULATION_H_
+
+/// @file simulation.h
+/// @defgroup Scene
+/// @{
+
+#include "../Settings.h"
+#include "../Utils/Vector.h"
+#include "Input.h"
+
+typedef struct Scene_s Scene;
+
+/// @brief Thread de simulation.
+/// Le moteur physique et la logique du jeu sont exécutés sur un thread dédié, au rythme du pas
+/// de temps fixe de la scène, indépendamment des images affichées par le thread principal.
+/// Après ses pas de temps, le thread publie un instantané de la scène (voir SnapshotBuffer)
+/// que le rendu lit sans jamais l'attendre : une attente de la synchronisation verticale ne
+/// ralentit plus la physique et un pas de temps coûteux ne fait plus sauter d'image.
+/// Tant que le thread tourne, seul lui accède aux balles, aux ressorts et à la logique du jeu ;
+/// le thread principal ne lui transmet que ses entrées (voir Simulation_PostInput()).
+typedef struct Simulation_s
+{
+    /// @brief Scène simulée.
+    Scene *m_scene;
+
+    /// @brief Thread de simulation (NULL s'il est arrêté).
+    SDL_Thread *m_thread;
+
+    /// @brief Indique que le thread doit continuer à tourner.
+    SDL_atomic_t m_running;
+
+    /// @brief Réveille le thread lorsque de nouvelles entrées sont disponibles
+    /// ou qu'il doit s'arrêter.
+    SDL_sem *m_wakeUp;
+
+    /// @brief Protège les entrées transmises au thread (m_input, m_mousePos et m_inputSerial).
+    SDL_SpinLock m_inputLock;
+
+    /// @brief Dernières entrées du thread principal.
+    /// Les appuis (touches, clics, pause) sont cumulés jusqu'à ce que le thread les lise.
+    Input m_input;
+
+    /// @brief Position de la souris dans le référentiel monde, calculée par le thread principal
+    /// avec sa caméra.
+    Vec2 m_mousePos;
+
+    /// @brief Numéro des dernières entrées transmises (0 si aucune).
+    Uint64 m_inputSerial;
+} Simulation;
+
+/// @brief Crée le thread de simulation d'une scène, sans le lancer.
+/// La scène doit avoir un moteur de rendu (voir Scene_New()).
+/// @param[in] scene la scène à simuler.
+/// @return Le thread de simulation créé ou NULL en cas d'erreur.
+Simulation *Simulation_New(Scene *scene);
+
+/// @brief Arrête puis détruit un thread de simulation préalablement alloué avec
+/// Simulation_New(). La scène n'est pas détruite.
+/// @param[in,out] simulation le thread de simulation à détruire.
+void Simulation_Free(Simulation *simulation);
+
+/// @brief Publie l'état courant de la scène puis lance le thread de simulation.
+/// @param[in,out] simulation le thread de simulation.
+/// @return EXIT_SUCCESS ou EXIT_FAILURE.
+int Simulation_Start(Simulation *simulation);
+
+/// @brief Arrête le thread de simulation et attend la fin de son pas de temps en cours.
+/// La scène peut ensuite être lue et modifiée par le thread appelant.
+/// @param[in,out] simulation le thread de simulation.
+void Simulation_Stop(Simulation *simulation);
+
+/// @brief Transmet les entrées de l'image courante au thread de simulation. Ne bloque pas.
+/// Les appuis transmis avant que le thread ne se réveille sont tous traités, dans l'ordre ;
+/// seul l'état maintenu (boutons enfoncés, souris) des dernières entrées est conservé.
+/// @param[in,out] simulation le thread de simulation.
+/// @param[in] input les entrées de l'utilisateur.
+/// @param[in] mousePos la position de la souris dans le référentiel monde.
+void Simulation_PostInput(Simulation *simulation, const Input *input, Vec2 mousePos);
+
+/// @}
+
+#endif
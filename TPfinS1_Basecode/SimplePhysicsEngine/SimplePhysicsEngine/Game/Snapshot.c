@@ -0,0 +1,190 @@
+﻿#include "Snapshot.h"
+#include "Scene.h"
+#include "../Utils/Timer.h"
+#include "../Utils/Tools.h"
+
+SnapshotBuffer *SnapshotBuffer_New()
+{
+    SnapshotBuffer *buffer = NULL;
+
+    buffer = (SnapshotBuffer *)calloc(1, sizeof(SnapshotBuffer));
+    if (!buffer) goto ERROR_LABEL;
+
+    // Le lecteur possède l'instantané 0, l'écrivain le 1 ; le 2 n'a jamais été publié
+    buffer->m_read = 0;
+    buffer->m_write = 1;
+    SDL_AtomicSet(&buffer->m_latest, 2);
+
+    return buffer;
+
+ERROR_LABEL:
+    printf("ERROR - SnapshotBuffer_New()\n");
+    assert(false);
+    SnapshotBuffer_Free(buffer);
+    return NULL;
+}
+
+void SnapshotBuffer_Free(SnapshotBuffer *buffer)
+{
+    if (!buffer) return;
+
+    for (int i = 0; i < SNAPSHOT_COUNT; ++i)
+    {
+        Snapshot *snapshot = &buffer->m_snapshots[i];
+        free(snapshot->m_prevX);
+        free(snapshot->m_prevY);
+        free(snapshot->m_posX);
+        free(snapshot->m_posY);
+        free(snapshot->m_ball1);
+        free(snapshot->m_ball2);
+        free(snapshot->m_links);
+    }
+
+    memset(buffer, 0, sizeof(SnapshotBuffer));
+    free(buffer);
+}
+
+/// @brief Augmente la capacité des tableaux d'un instantané.
+static int Snapshot_Reserve(Snapshot *snapshot, int ballCount, int springCount)
+{
+    if (ballCount > snapshot->m_ballCapacity)
+    {
+        int capacity = SDL_max(ballCount, 2 * snapshot->m_ballCapacity);
+
+        if ((Tools_Realloc((void **)&snapshot->m_prevX, capacity, sizeof(float)) == EXIT_FAILURE)
+            || (Tools_Realloc((void **)&snapshot->m_prevY, capacity, sizeof(float)) == EXIT_FAILURE)
+            || (Tools_Realloc((void **)&snapshot->m_posX, capacity, sizeof(float)) == EXIT_FAILURE)
+            || (Tools_Realloc((void **)&snapshot->m_posY, capacity, sizeof(float)) == EXIT_FAILURE)
+            || (Tools_Realloc((void **)&snapshot->m_links, capacity, sizeof(BallLinks)) == EXIT_FAILURE))
+            goto ERROR_LABEL;
+
+        snapshot->m_ballCapacity = capacity;
+    }
+
+    if (springCount > snapshot->m_springCapacity)
+    {
+        int capacity = SDL_max(springCount, 2 * snapshot->m_springCapacity);
+
+        if ((Tools_Realloc((void **)&snapshot->m_ball1, capacity, sizeof(int)) == EXIT_FAILURE)
+            || (Tools_Realloc((void **)&snapshot->m_ball2, capacity, sizeof(int)) == EXIT_FAILURE))
+            goto ERROR_LABEL;
+
+        snapshot->m_springCapacity = capacity;
+    }
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - Snapshot_Reserve()\n");
+    return EXIT_FAILURE;
+}
+
+/// @brief Copie l'état de la scène dans un instantané.
+static int Snapshot_Capture(Snapshot *snapshot, Scene *scene)
+{
+    Particles *particles = Scene_GetBalls(scene);
+    Springs *springs = scene->m_springs;
+    Timer *time = scene->m_time;
+    int ballCount = particles->m_count;
+    int springCount = springs->m_count;
+
+    if (Snapshot_Reserve(snapshot, ballCount, springCount) == EXIT_FAILURE)
+    {
+        // L'instantané devra être entièrement recopié
+        snapshot->m_topologyVersion = 0;
+        return EXIT_FAILURE;
+    }
+
+    // Les positions changent à chaque pas de temps
+    memcpy(snapshot->m_prevX, particles->m_prevX, ballCount * sizeof(float));
+    memcpy(snapshot->m_prevY, particles->m_prevY, ballCount * sizeof(float));
+    memcpy(snapshot->m_posX, particles->m_posX, ballCount * sizeof(float));
+    memcpy(snapshot->m_posY, particles->m_posY, ballCount * sizeof(float));
+    snapshot->m_ballCount = ballCount;
+
+    // La topologie change rarement : elle n'est recopiée que si la scène a été modifiée
+    // depuis la dernière publication de cet instantané
+    if (snapshot->m_topologyVersion != scene->m_topologyVersion)
+    {
+        memcpy(snapshot->m_ball1, springs->m_ball1, springCount * sizeof(int));
+        memcpy(snapshot->m_ball2, springs->m_ball2, springCount * sizeof(int));
+        memcpy(snapshot->m_links, scene->m_links, ballCount * sizeof(BallLinks));
+        snapshot->m_springCount = springCount;
+        snapshot->m_maxSpringLength = springs->m_maxLength;
+        snapshot->m_topologyVersion = scene->m_topologyVersion;
+    }
+
+    // Ressorts inactifs entre la souris et les balles les plus proches
+    snapshot->m_mousePos = scene->m_mousePos;
+    snapshot->m_previewCount = 0;
+    for (int i = 0; (i < scene->m_validCount) && (i < SNAPSHOT_MAX_PREVIEWS); ++i)
+    {
+        int ball = Particles_GetIndex(particles, scene->m_queries[i].ball);
+        if (ball >= 0)
+            snapshot->m_previewBalls[snapshot->m_previewCount++] = ball;
+    }
+
+    snapshot->m_accu = scene->m_accu;
+    snapshot->m_timeStep = scene->m_timeStep;
+    snapshot->m_timeScale = Timer_IsPaused(time) ? 0.0 : time->m_scale;
+    snapshot->m_counter = SDL_GetPerformanceCounter();
+
+    return EXIT_SUCCESS;
+}
+
+int SnapshotBuffer_Publish(SnapshotBuffer *buffer, Scene *scene)
+{
+    Snapshot *snapshot = &buffer->m_snapshots[buffer->m_write];
+
+    if (Snapshot_Capture(snapshot, scene) == EXIT_FAILURE)
+        goto ERROR_LABEL;
+
+    snapshot->m_serial = ++buffer->m_serial;
+
+    // Les écritures dans l'instantané doivent être visibles avant sa publication.
+    // L'instantané publié précédemment, s'il n'a pas été lu, devient celui de l'écrivain.
+    SDL_MemoryBarrierRelease();
+    int previous = SDL_AtomicSet(&buffer->m_latest, buffer->m_write | SNAPSHOT_FRESH);
+    buffer->m_write = previous & SNAPSHOT_INDEX_MASK;
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - SnapshotBuffer_Publish()\n");
+    return EXIT_FAILURE;
+}
+
+const Snapshot *SnapshotBuffer_Acquire(SnapshotBuffer *buffer)
+{
+    // Echange l'instantané du lecteur avec le dernier publié s'il n'a pas encore été lu
+    if (SDL_AtomicGet(&buffer->m_latest) & SNAPSHOT_FRESH)
+    {
+        int latest = SDL_AtomicSet(&buffer->m_latest, buffer->m_read);
+        SDL_MemoryBarrierAcquire();
+        buffer->m_read = latest & SNAPSHOT_INDEX_MASK;
+    }
+
+    return &buffer->m_snapshots[buffer->m_read];
+}
+
+float Snapshot_GetAlpha(const Snapshot *snapshot)
+{
+    if (snapshot->m_timeStep <= 0.f)
+        return 1.f;
+
+    Uint64 elapsed = Timer_TicksToNs(SDL_GetPerformanceCounter() - snapshot->m_counter);
+    double accu = snapshot->m_accu + (double)elapsed * 1e-9 * snapshot->m_timeScale;
+
+    return (float)SDL_min(accu / snapshot->m_timeStep, 1.0);
+}
+
+Vec2 Snapshot_GetInterpolatedPosition(const Snapshot *snapshot, int index, float alpha)
+{
+    float prevX = snapshot->m_prevX[index];
+    float prevY = snapshot->m_prevY[index];
+
+    return Vec2_Set(
+        prevX + alpha * (snapshot->m_posX[index] - prevX),
+        prevY + alpha * (snapshot->m_posY[index] - prevY)
+    );
+}
@@ -0,0 +1,151 @@
+﻿#ifndef _SNAPSHOT_H_
+#define _SNAPSHOT_H_
+
+/// @file snapshot.h
+/// @defgroup Scene
+/// @{
+
+#include "../Settings.h"
+#include "../Utils/Vector.h"
+#include "Springs.h"
+
+typedef struct Scene_s Scene;
+
+/// @brief Nombre maximal de ressorts inactifs (aperçu des liaisons d'une nouvelle balle)
+/// copiés dans un instantané.
+#define SNAPSHOT_MAX_PREVIEWS MAX_EDGES
+
+/// @brief Nombre d'instantanés du triple buffer.
+#define SNAPSHOT_COUNT 3
+
+/// @brief Bit de m_latest indiquant que l'instantané publié n'a pas encore été lu.
+#define SNAPSHOT_FRESH 0x4
+
+/// @brief Masque de l'indice de l'instantané dans m_latest.
+#define SNAPSHOT_INDEX_MASK 0x3
+
+/// @brief Copie immuable de l'état de la scène nécessaire au rendu.
+/// Un instantané est rempli par le moteur physique après ses pas de temps puis lu par le rendu,
+/// qui n'accède jamais directement aux balles et aux ressorts de la scène.
+typedef struct Snapshot_s
+{
+    /// @brief Positions des balles au début du dernier pas de temps.
+    float *m_prevX, *m_prevY;
+
+    /// @brief Positions des balles à la fin du dernier pas de temps.
+    float *m_posX, *m_posY;
+
+    /// @brief Nombre de balles.
+    int m_ballCount;
+
+    /// @brief Nombre maximal de balles avant d'effectuer une réallocation mémoire.
+    int m_ballCapacity;
+
+    /// @brief Indices des balles de chaque ressort.
+    int *m_ball1, *m_ball2;
+
+    /// @brief Nombre de ressorts.
+    int m_springCount;
+
+    /// @brief Nombre maximal de ressorts avant d'effectuer une réallocation mémoire.
+    int m_springCapacity;
+
+    /// @brief Plus grande longueur au repos d'un ressort (voir Springs).
+    float m_maxSpringLength;
+
+    /// @brief Topologie (indices des ressorts) de chaque balle.
+    BallLinks *m_links;
+
+    /// @brief Version de la topologie de la scène copiée dans l'instantané (0 si aucune).
+    /// Les ressorts et m_links ne sont recopiés que si la topologie a changé.
+    Uint32 m_topologyVersion;
+
+    /// @brief Position de la souris (référentiel monde) utilisée par la logique du jeu.
+    Vec2 m_mousePos;
+
+    /// @brief Indices des balles auxquelles serait reliée une nouvelle balle.
+    int m_previewBalls[SNAPSHOT_MAX_PREVIEWS];
+
+    /// @brief Nombre de ressorts inactifs à dessiner.
+    int m_previewCount;
+
+    /// @brief Temps accumulé (exprimé en s) non encore simulé lors de la publication.
+    double m_accu;
+
+    /// @brief Pas de temps fixe du moteur physique.
+    float m_timeStep;
+
+    /// @brief Facteur d'échelle de l'horloge de la scène (0 si elle est en pause).
+    double m_timeScale;
+
+    /// @brief Valeur du compteur haute résolution lors de la publication.
+    Uint64 m_counter;
+
+    /// @brief Numéro de l'instantané (1 pour le premier publié, 0 pour un instantané vide).
+    Uint64 m_serial;
+} Snapshot;
+
+/// @brief Triple buffer sans verrou transmettant les instantanés du moteur physique au rendu.
+/// A tout instant, un instantané appartient à l'écrivain (moteur physique), un au lecteur
+/// (rendu) et le troisième est le dernier publié. Publier ou lire échange son instantané avec
+/// le dernier publié par une seule opération atomique : ni l'écrivain ni le lecteur n'attendent
+/// jamais l'autre. Le lecteur obtient toujours l'instantané complet le plus récent ; les
+/// instantanés publiés entre deux lectures sont perdus.
+typedef struct SnapshotBuffer_s
+{
+    /// @brief Instantanés.
+    Snapshot m_snapshots[SNAPSHOT_COUNT];
+
+    /// @brief Indice du dernier instantané publié, avec le bit SNAPSHOT_FRESH s'il n'a pas
+    /// encore été lu.
+    SDL_atomic_t m_latest;
+
+    /// @brief Indice de l'instantané de l'écrivain (lu et modifié par l'écrivain seulement).
+    int m_write;
+
+    /// @brief Indice de l'instantané du lecteur (lu et modifié par le lecteur seulement).
+    int m_read;
+
+    /// @brief Numéro du dernier instantané publié (écrivain seulement).
+    Uint64 m_serial;
+} SnapshotBuffer;
+
+/// @brief Crée un triple buffer d'instantanés vides.
+/// @return Le triple buffer créé ou NULL en cas d'erreur.
+SnapshotBuffer *SnapshotBuffer_New();
+
+/// @brief Détruit un triple buffer préalablement alloué avec SnapshotBuffer_New().
+/// @param[in,out] buffer le triple buffer à détruire.
+void SnapshotBuffer_Free(SnapshotBuffer *buffer);
+
+/// @brief Copie l'état de la scène dans l'instantané de l'écrivain puis le publie.
+/// Doit être appelée par le thread qui met à jour la scène.
+/// @param[in,out] buffer le triple buffer.
+/// @param[in] scene la scène.
+/// @return EXIT_SUCCESS ou EXIT_FAILURE (rien n'est alors publié).
+int SnapshotBuffer_Publish(SnapshotBuffer *buffer, Scene *scene);
+
+/// @brief Renvoie l'instantané le plus récent. Ne bloque jamais.
+/// L'instantané reste valide et inchangé jusqu'au prochain appel par le lecteur.
+/// @param[in,out] buffer le triple buffer.
+/// @return L'instantané le plus récent (vide si aucun n'a encore été publié).
+const Snapshot *SnapshotBuffer_Acquire(SnapshotBuffer *buffer);
+
+/// @brief Renvoie le coefficient d'interpolation du rendu entre les positions du début et de
+/// la fin du dernier pas de temps de l'instantané.
+/// Le temps écoulé depuis la publication est ajouté au temps accumulé : le rendu reste fluide
+/// lorsque le moteur physique et le rendu ne tournent pas au même rythme.
+/// @param[in] snapshot l'instantané.
+/// @return Le coefficient d'interpolation, entre 0 et 1.
+float Snapshot_GetAlpha(const Snapshot *snapshot);
+
+/// @brief Renvoie la position interpolée d'une balle de l'instantané.
+/// @param[in] snapshot l'instantané.
+/// @param[in] index l'indice de la balle.
+/// @param[in] alpha le coefficient d'interpolation.
+/// @return La position interpolée de la balle.
+Vec2 Snapshot_GetInterpolatedPosition(const Snapshot *snapshot, int index, float alpha);
+
+/// @}
+
+#endif
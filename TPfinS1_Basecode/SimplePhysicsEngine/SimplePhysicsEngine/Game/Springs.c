@@ -0,0 +1,225 @@
+﻿#include "Springs.h"
+
+/// @brief Augmente la capacité de la liste.
+static int Springs_Reserve(Springs *springs, int capacity)
+{
+    int *newBall1 = NULL, *newBall2 = NULL, *newColor = NULL;
+    float *newLength = NULL, *newStiffness = NULL;
+
+    newBall1 = (int *)realloc(springs->m_ball1, capacity * sizeof(int));
+    if (!newBall1) goto ERROR_LABEL;
+    springs->m_ball1 = newBall1;
+
+    newBall2 = (int *)realloc(springs->m_ball2, capacity * sizeof(int));
+    if (!newBall2) goto ERROR_LABEL;
+    springs->m_ball2 = newBall2;
+
+    newLength = (float *)realloc(springs->m_length, capacity * sizeof(float));
+    if (!newLength) goto ERROR_LABEL;
+    springs->m_length = newLength;
+
+    newStiffness = (float *)realloc(springs->m_stiffness, capacity * sizeof(float));
+    if (!newStiffness) goto ERROR_LABEL;
+    springs->m_stiffness = newStiffness;
+
+    newColor = (int *)realloc(springs->m_color, capacity * sizeof(int));
+    if (!newColor) goto ERROR_LABEL;
+    springs->m_color = newColor;
+
+    springs->m_capacity = capacity;
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - Springs_Reserve()\n");
+    return EXIT_FAILURE;
+}
+
+/// @brief Remplace un indice de ressort dans la topologie d'une balle.
+static void BallLinks_Replace(BallLinks *links, int oldSpring, int newSpring)
+{
+    for (int i = 0; i < links->springCount; ++i)
+    {
+        if (links->springs[i] == oldSpring)
+        {
+            links->springs[i] = newSpring;
+            return;
+        }
+    }
+}
+
+/// @brief Supprime un ressort de la topologie d'une balle.
+static void BallLinks_Remove(BallLinks *links, int spring)
+{
+    for (int i = 0; i < links->springCount; ++i)
+    {
+        if (links->springs[i] == spring)
+        {
+            links->springs[i] = links->springs[links->springCount - 1];
+            links->springCount--;
+            return;
+        }
+    }
+}
+
+/// @brief Déplace un ressort vers un indice inoccupé et met à jour la topologie de ses balles.
+static void Springs_Move(Springs *springs, BallLinks *links, int src, int dst)
+{
+    if (src == dst)
+        return;
+
+    springs->m_ball1[dst] = springs->m_ball1[src];
+    springs->m_ball2[dst] = springs->m_ball2[src];
+    springs->m_length[dst] = springs->m_length[src];
+    springs->m_stiffness[dst] = springs->m_stiffness[src];
+    springs->m_color[dst] = springs->m_color[src];
+
+    BallLinks_Replace(&links[springs->m_ball1[dst]], src, dst);
+    BallLinks_Replace(&links[springs->m_ball2[dst]], src, dst);
+}
+
+/// @brief Renvoie le masque des couleurs utilisées par les ressorts d'une balle.
+static uint32_t Springs_GetUsedColors(Springs *springs, BallLinks *links)
+{
+    uint32_t used = 0;
+    for (int i = 0; i < links->springCount; ++i)
+    {
+        used |= (uint32_t)1 << springs->m_color[links->springs[i]];
+    }
+    return used;
+}
+
+Springs *Springs_New(int capacity)
+{
+    Springs *springs = NULL;
+
+    springs = (Springs *)calloc(1, sizeof(Springs));
+    if (!springs) goto ERROR_LABEL;
+
+    int exitStatus = Springs_Reserve(springs, capacity);
+    if (exitStatus == EXIT_FAILURE) goto ERROR_LABEL;
+
+    return springs;
+
+ERROR_LABEL:
+    printf("ERROR - Springs_New()\n");
+    assert(false);
+    Springs_Free(springs);
+    return NULL;
+}
+
+void Springs_Free(Springs *springs)
+{
+    if (!springs) return;
+
+    free(springs->m_ball1);
+    free(springs->m_ball2);
+    free(springs->m_length);
+    free(springs->m_stiffness);
+    free(springs->m_color);
+
+    memset(springs, 0, sizeof(Springs));
+    free(springs);
+}
+
+int Springs_Add(
+    Springs *springs, BallLinks *links,
+    int ball1, int ball2, float length, float stiffness)
+{
+    if ((links[ball1].springCount >= MAX_EDGES) || (links[ball2].springCount >= MAX_EDGES))
+        goto ERROR_LABEL;
+
+    if (springs->m_count >= springs->m_capacity)
+    {
+        int capacity = springs->m_capacity > 0 ? springs->m_capacity << 1 : 1 << 10;
+        int exitStatus = Springs_Reserve(springs, capacity);
+        if (exitStatus == EXIT_FAILURE) goto ERROR_LABEL;
+    }
+
+    // Choisit la plus petite couleur libre pour les deux balles
+    uint32_t used = Springs_GetUsedColors(springs, &links[ball1])
+                  | Springs_GetUsedColors(springs, &links[ball2]);
+    int color = 0;
+    while (used & ((uint32_t)1 << color))
+        color++;
+    assert(color < SPRINGS_MAX_COLORS);
+
+    // Ajoute les couleurs manquantes (vides) à la fin de la liste
+    while (springs->m_colorCount <= color)
+    {
+        springs->m_colorCount++;
+        springs->m_colorStart[springs->m_colorCount] = springs->m_count;
+    }
+
+    // Libère une case à la fin de la couleur choisie en déplaçant le premier ressort
+    // de chacune des couleurs suivantes à la fin de sa couleur
+    int index = springs->m_count;
+    for (int c = springs->m_colorCount - 1; c > color; --c)
+    {
+        int first = springs->m_colorStart[c];
+        if (first < index)
+            Springs_Move(springs, links, first, index);
+
+        index = first;
+        springs->m_colorStart[c + 1]++;
+    }
+    springs->m_colorStart[color + 1]++;
+    springs->m_count++;
+
+    springs->m_ball1[index] = ball1;
+    springs->m_ball2[index] = ball2;
+    springs->m_length[index] = length;
+    springs->m_stiffness[index] = stiffness;
+    springs->m_color[index] = color;
+    springs->m_maxLength = SDL_max(springs->m_maxLength, length);
+
+    links[ball1].springs[links[ball1].springCount++] = index;
+    links[ball2].springs[links[ball2].springCount++] = index;
+
+    return index;
+
+ERROR_LABEL:
+    printf("ERROR - Springs_Add()\n");
+    return -1;
+}
+
+void Springs_Remove(Springs *springs, BallLinks *links, int index)
+{
+    if (index < 0 || index >= springs->m_count)
+        return;
+
+    int color = springs->m_color[index];
+
+    BallLinks_Remove(&links[springs->m_ball1[index]], index);
+    BallLinks_Remove(&links[springs->m_ball2[index]], index);
+
+    // Le dernier ressort de la couleur prend la place du ressort supprimé puis,
+    // pour chacune des couleurs suivantes, le dernier ressort prend la place libérée au début
+    int hole = springs->m_colorStart[color + 1] - 1;
+    Springs_Move(springs, links, hole, index);
+
+    for (int c = color + 1; c < springs->m_colorCount; ++c)
+    {
+        int last = springs->m_colorStart[c + 1] - 1;
+        if (last >= springs->m_colorStart[c])
+        {
+            Springs_Move(springs, links, last, hole);
+            hole = last;
+        }
+        springs->m_colorStart[c]--;
+    }
+    springs->m_colorStart[springs->m_colorCount]--;
+    springs->m_count--;
+
+    // Oublie les couleurs vides en fin de liste
+    while ((springs->m_colorCount > 0)
+        && (springs->m_colorStart[springs->m_colorCount - 1] == springs->m_count))
+    {
+        springs->m_colorCount--;
+    }
+}
+
+int Springs_GetOther(Springs *springs, int index, int ball)
+{
+    return springs->m_ball1[index] == ball ? springs->m_ball2[index] : springs->m_ball1[index];
+}
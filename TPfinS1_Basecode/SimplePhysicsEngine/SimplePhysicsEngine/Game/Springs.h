@@ -0,0 +1,116 @@
+﻿#ifndef _SPRINGS_H_
+#define _SPRINGS_H_
+
+/// @file springs.h
+/// @defgroup Physics
+/// @{
+
+#include "../Settings.h"
+
+/// @brief Nombre maximal de ressorts attachés à une balle.
+#define MAX_EDGES 10
+
+/// @brief Nombre maximal de couleurs utilisées par la coloration des ressorts.
+/// Un ressort touche au plus 2 * (MAX_EDGES - 1) autres ressorts : une coloration gloutonne
+/// trouve donc toujours une couleur libre parmi 2 * MAX_EDGES - 1.
+#define SPRINGS_MAX_COLORS (2 * MAX_EDGES - 1)
+
+/// @brief Structure représentant la topologie d'une balle, c'est-à-dire les ressorts
+/// qui la lient à d'autres balles.
+/// Les grandeurs physiques (position, vitesse, masse, friction) sont stockées dans la structure
+/// Particles de la scène, au même indice.
+typedef struct BallLinks_s
+{
+    /// @brief Nombre de ressorts liant la balle à d'autres balles.
+    int springCount;
+
+    /// @brief Indices, dans la liste des ressorts de la scène, des ressorts attachés à la balle.
+    int springs[MAX_EDGES];
+} BallLinks;
+
+/// @brief Liste globale des ressorts de la scène, sous forme de structure de tableaux.
+/// Chaque ressort n'est stocké qu'une seule fois : la force qu'il exerce est donc calculée
+/// une seule fois par pas de temps puis appliquée (avec des signes opposés) à ses deux balles.
+///
+/// Les ressorts sont colorés de sorte que deux ressorts ayant une balle en commun n'aient jamais
+/// la même couleur, et rangés par couleur : les ressorts de la couleur c occupent les indices
+/// [m_colorStart[c], m_colorStart[c + 1][. Les ressorts d'une même couleur peuvent donc appliquer
+/// leurs forces en parallèle sans conflit d'écriture.
+/// La coloration est maintenue à chaque ajout ou suppression de ressort.
+typedef struct Springs_s
+{
+    /// @brief Indices de la première balle de chaque ressort.
+    int *m_ball1;
+
+    /// @brief Indices de la seconde balle de chaque ressort.
+    int *m_ball2;
+
+    /// @brief Longueurs au repos des ressorts.
+    float *m_length;
+
+    /// @brief Raideurs des ressorts (exprimées en N/m).
+    float *m_stiffness;
+
+    /// @brief Couleurs des ressorts.
+    int *m_color;
+
+    /// @brief Indice du premier ressort de chaque couleur.
+    /// m_colorStart[m_colorCount] vaut m_count.
+    int m_colorStart[SPRINGS_MAX_COLORS + 1];
+
+    /// @brief Nombre de couleurs utilisées.
+    int m_colorCount;
+
+    /// @brief Plus grande longueur au repos d'un ressort ajouté à la liste.
+    /// Elle ne diminue pas lors des suppressions.
+    float m_maxLength;
+
+    /// @brief Nombre de ressorts stockés.
+    int m_count;
+
+    /// @brief Nombre maximal de ressorts avant d'effectuer une réallocation mémoire.
+    int m_capacity;
+} Springs;
+
+/// @brief Crée une liste de ressorts vide.
+/// @param[in] capacity la capacité initiale.
+/// @return La liste créée ou NULL en cas d'erreur.
+Springs *Springs_New(int capacity);
+
+/// @brief Détruit une liste préalablement allouée avec Springs_New().
+/// @param[in,out] springs la liste à détruire.
+void Springs_Free(Springs *springs);
+
+/// @brief Ajoute un ressort à la liste et l'attache à ses deux balles.
+/// Le ressort reçoit la plus petite couleur qui n'est utilisée par aucun ressort de ses balles.
+/// Pour le ranger avec les ressorts de sa couleur, au plus un ressort par couleur est déplacé ;
+/// la topologie des balles est mise à jour en conséquence.
+/// @param[in,out] springs la liste.
+/// @param[in,out] links la topologie des balles.
+/// @param[in] ball1 l'indice de la première balle.
+/// @param[in] ball2 l'indice de la seconde balle.
+/// @param[in] length la longueur au repos du ressort.
+/// @param[in] stiffness la raideur du ressort.
+/// @return L'indice du nouveau ressort ou -1 en cas d'erreur.
+int Springs_Add(
+    Springs *springs, BallLinks *links,
+    int ball1, int ball2, float length, float stiffness);
+
+/// @brief Supprime un ressort de la liste et le détache de ses deux balles.
+/// Au plus un ressort par couleur est déplacé ; la topologie des balles est mise à jour
+/// en conséquence. Les couleurs des autres ressorts ne changent pas.
+/// @param[in,out] springs la liste.
+/// @param[in,out] links la topologie des balles.
+/// @param[in] index l'indice du ressort à supprimer.
+void Springs_Remove(Springs *springs, BallLinks *links, int index);
+
+/// @brief Renvoie l'extrémité d'un ressort opposée à une balle donnée.
+/// @param[in] springs la liste.
+/// @param[in] index l'indice du ressort.
+/// @param[in] ball l'indice d'une des deux balles du ressort.
+/// @return L'indice de l'autre balle du ressort.
+int Springs_GetOther(Springs *springs, int index, int ball);
+
+/// @}
+
+#endif
@@ -1,21 +1,25 @@
-#ifndef _TEXTURES_H_
-#define _TEXTURES_H_
-
-#include "../Settings.h"
-#include "../Utils/Renderer.h"
-
-#define LAYER_COUNT 5
-
-typedef struct Textures_s
-{
-    SDL_Texture *m_body;
-    SDL_Texture *m_spring;
-    SDL_Texture *m_springInactive;
-    SDL_Texture *m_ground;
-    SDL_Texture *m_layers[LAYER_COUNT];
-} Textures;
-
-Textures *Textures_New(Renderer *renderer);
-void Textures_Free(Textures *tex);
-
-#endif
+#ifndef _TEXTURES_H_
+#define _TEXTURES_H_
+
+#include "../Settings.h"
+#include "../Utils/Renderer.h"
+#include "../Utils/Atlas.h"
+
+#define LAYER_COUNT 5
+
+typedef struct Textures_s
+{
+    /// @brief Atlas contenant toutes les images ci-dessous.
+    Atlas *m_atlas;
+
+    Sprite m_body;
+    Sprite m_spring;
+    Sprite m_springInactive;
+    Sprite m_ground;
+    Sprite m_layers[LAYER_COUNT];
+} Textures;
+
+Textures *Textures_New(Renderer *renderer);
+void Textures_Free(Textures *tex);
+
+#endif
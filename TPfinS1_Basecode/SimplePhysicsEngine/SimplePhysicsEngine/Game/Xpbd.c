@@ -0,0 +1,384 @@
+﻿#include "Xpbd.h"
+#include "Scene.h"
+#include "Islands.h"
+#include "../Utils/Tools.h"
+
+/// @brief Nombre de balles par bloc.
+#define XPBD_BLOCK 512
+
+/// @brief Nombre maximal de blocs d'une petite île (voir ISLAND_SPLIT_SIZE).
+#define XPBD_SMALL_BLOCKS ((ISLAND_SPLIT_SIZE + XPBD_BLOCK - 1) / XPBD_BLOCK)
+
+/// @brief Nombre minimal de ressorts traités par un thread.
+#define XPBD_SPRING_BATCH 1024
+
+/// @brief Une balle qui touche le sol avec une vitesse inférieure à celle acquise en chute libre
+/// pendant ce nombre de sous-pas s'arrête au lieu de rebondir.
+#define XPBD_REST_STEPS 2.f
+
+/// @brief Paramètres de la résolution d'une île partagés par les threads.
+typedef struct XpbdStep_s
+{
+    XpbdSolver *solver;
+    Scene *scene;
+
+    /// @brief Durée d'un sous-pas.
+    float subStep;
+
+    /// @brief Balles de l'île : [firstBall, lastBall[.
+    int firstBall, lastBall;
+
+    /// @brief Position, dans m_springOrder, du premier ressort à traiter.
+    int offset;
+
+    /// @brief Indice de l'itération en cours dans le sous-pas.
+    int iteration;
+
+    /// @brief Energie cinétique maximale de chaque bloc de balles.
+    float *energy;
+} XpbdStep;
+
+XpbdSolver *Xpbd_New()
+{
+    XpbdSolver *solver = NULL;
+
+    solver = (XpbdSolver *)calloc(1, sizeof(XpbdSolver));
+    if (!solver) goto ERROR_LABEL;
+
+    solver->m_method = XPBD_GAUSS_SEIDEL;
+    solver->m_substeps = XPBD_SUBSTEPS;
+    solver->m_iterations = XPBD_ITERATIONS;
+
+    return solver;
+
+ERROR_LABEL:
+    printf("ERROR - Xpbd_New()\n");
+    assert(false);
+    Xpbd_Free(solver);
+    return NULL;
+}
+
+void Xpbd_Free(XpbdSolver *solver)
+{
+    if (!solver) return;
+
+    free(solver->m_prevX);
+    free(solver->m_prevY);
+    free(solver->m_deltaX);
+    free(solver->m_deltaY);
+    free(solver->m_velY);
+    free(solver->m_contact);
+    free(solver->m_lambda);
+    free(solver->m_energy);
+
+    memset(solver, 0, sizeof(XpbdSolver));
+    free(solver);
+}
+
+int Xpbd_Reserve(XpbdSolver *solver, Scene *scene)
+{
+    int ballCapacity = scene->m_ballCapacity;
+    int springCapacity = scene->m_springs->m_capacity;
+
+    if (ballCapacity > solver->m_ballCapacity)
+    {
+        int exitStatus = EXIT_SUCCESS;
+        exitStatus |= Tools_Realloc((void **)&solver->m_prevX, ballCapacity, sizeof(float));
+        exitStatus |= Tools_Realloc((void **)&solver->m_prevY, ballCapacity, sizeof(float));
+        exitStatus |= Tools_Realloc((void **)&solver->m_deltaX, ballCapacity, sizeof(float));
+        exitStatus |= Tools_Realloc((void **)&solver->m_deltaY, ballCapacity, sizeof(float));
+        exitStatus |= Tools_Realloc((void **)&solver->m_velY, ballCapacity, sizeof(float));
+        if (exitStatus != EXIT_SUCCESS) goto ERROR_LABEL;
+
+        bool *newContact = (bool *)realloc(solver->m_contact, ballCapacity * sizeof(bool));
+        if (!newContact) goto ERROR_LABEL;
+        solver->m_contact = newContact;
+
+        int blockCount = (ballCapacity + XPBD_BLOCK - 1) / XPBD_BLOCK;
+        exitStatus = Tools_Realloc((void **)&solver->m_energy, blockCount, sizeof(float));
+        if (exitStatus != EXIT_SUCCESS) goto ERROR_LABEL;
+
+        solver->m_ballCapacity = ballCapacity;
+    }
+
+    if (springCapacity > solver->m_springCapacity)
+    {
+        int exitStatus = Tools_Realloc((void **)&solver->m_lambda, springCapacity, sizeof(float));
+        if (exitStatus != EXIT_SUCCESS) goto ERROR_LABEL;
+
+        solver->m_springCapacity = springCapacity;
+    }
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - Xpbd_Reserve()\n");
+    return EXIT_FAILURE;
+}
+
+//-------------------------------------------------------------------------------------------------
+// Passes sur les balles (par blocs) et sur les ressorts (par couleurs)
+
+/// @brief Intègre les forces extérieures (pesanteur et frottements) et prédit les positions.
+static void Xpbd_PredictTask(void *data, int first, int last)
+{
+    XpbdStep *step = (XpbdStep *)data;
+    XpbdSolver *solver = step->solver;
+    Particles *particles = step->scene->m_particles;
+    float h = step->subStep;
+    float gravity = step->scene->m_gameMode->gravity;
+
+    for (int block = first; block < last; ++block)
+    {
+        int firstBall = step->firstBall + block * XPBD_BLOCK;
+        int lastBall = SDL_min(firstBall + XPBD_BLOCK, step->lastBall);
+
+        for (int i = firstBall; i < lastBall; ++i)
+        {
+            float damping = particles->m_friction[i] * particles->m_invMass[i];
+            float vx = particles->m_velX[i] - h * damping * particles->m_velX[i];
+            float vy = particles->m_velY[i] + h * (gravity - damping * particles->m_velY[i]);
+
+            particles->m_velX[i] = vx;
+            particles->m_velY[i] = vy;
+            solver->m_velY[i] = vy;
+            solver->m_contact[i] = false;
+
+            solver->m_prevX[i] = particles->m_posX[i];
+            solver->m_prevY[i] = particles->m_posY[i];
+            particles->m_posX[i] += h * vx;
+            particles->m_posY[i] += h * vy;
+
+            solver->m_deltaX[i] = 0.f;
+            solver->m_deltaY[i] = 0.f;
+        }
+    }
+}
+
+/// @brief Calcule la correction d'une contrainte de distance.
+/// @return La variation du multiplicateur de Lagrange, et la direction du ressort dans (nx, ny).
+static inline float Xpbd_SolveSpring(
+    XpbdStep *step, int spring, int b1, int b2, float *nx, float *ny)
+{
+    XpbdSolver *solver = step->solver;
+    Particles *particles = step->scene->m_particles;
+    Springs *springs = step->scene->m_springs;
+
+    float dx = particles->m_posX[b2] - particles->m_posX[b1];
+    float dy = particles->m_posY[b2] - particles->m_posY[b1];
+    float distance = sqrtf(dx * dx + dy * dy);
+    float lambda = (step->iteration == 0) ? 0.f : solver->m_lambda[spring];
+
+    *nx = 0.f;
+    *ny = 0.f;
+    if (distance <= 0.f)
+    {
+        solver->m_lambda[spring] = lambda;
+        return 0.f;
+    }
+
+    // Contrainte C = d - L de souplesse alpha = 1 / k (ramenée au sous-pas)
+    float alpha = 1.f / (springs->m_stiffness[spring] * step->subStep * step->subStep);
+    float constraint = distance - springs->m_length[spring];
+    float weight = particles->m_invMass[b1] + particles->m_invMass[b2];
+    float deltaLambda = (-constraint - alpha * lambda) / (weight + alpha);
+
+    solver->m_lambda[spring] = lambda + deltaLambda;
+    *nx = dx / distance;
+    *ny = dy / distance;
+
+    return deltaLambda;
+}
+
+/// @brief Résout les contraintes de distance par la méthode de Gauss-Seidel.
+static void Xpbd_GaussSeidelTask(void *data, int first, int last)
+{
+    XpbdStep *step = (XpbdStep *)data;
+    Particles *particles = step->scene->m_particles;
+    Springs *springs = step->scene->m_springs;
+    const int *order = step->scene->m_islands->m_springOrder;
+
+    for (int k = step->offset + first; k < step->offset + last; ++k)
+    {
+        int spring = order[k];
+        int b1 = springs->m_ball1[spring];
+        int b2 = springs->m_ball2[spring];
+        float nx, ny;
+        float deltaLambda = Xpbd_SolveSpring(step, spring, b1, b2, &nx, &ny);
+
+        float w1 = particles->m_invMass[b1] * deltaLambda;
+        float w2 = particles->m_invMass[b2] * deltaLambda;
+        particles->m_posX[b1] -= w1 * nx;
+        particles->m_posY[b1] -= w1 * ny;
+        particles->m_posX[b2] += w2 * nx;
+        particles->m_posY[b2] += w2 * ny;
+    }
+}
+
+/// @brief Calcule les corrections des contraintes de distance par la méthode de Jacobi.
+static void Xpbd_JacobiTask(void *data, int first, int last)
+{
+    XpbdStep *step = (XpbdStep *)data;
+    XpbdSolver *solver = step->solver;
+    Particles *particles = step->scene->m_particles;
+    Springs *springs = step->scene->m_springs;
+    const int *order = step->scene->m_islands->m_springOrder;
+
+    for (int k = step->offset + first; k < step->offset + last; ++k)
+    {
+        int spring = order[k];
+        int b1 = springs->m_ball1[spring];
+        int b2 = springs->m_ball2[spring];
+        float nx, ny;
+        float deltaLambda = Xpbd_SolveSpring(step, spring, b1, b2, &nx, &ny);
+
+        float w1 = particles->m_invMass[b1] * deltaLambda;
+        float w2 = particles->m_invMass[b2] * deltaLambda;
+        solver->m_deltaX[b1] -= w1 * nx;
+        solver->m_deltaY[b1] -= w1 * ny;
+        solver->m_deltaX[b2] += w2 * nx;
+        solver->m_deltaY[b2] += w2 * ny;
+    }
+}
+
+/// @brief Applique les corrections moyennées (méthode de Jacobi) puis la contrainte du sol.
+static void Xpbd_GroundTask(void *data, int first, int last)
+{
+    XpbdStep *step = (XpbdStep *)data;
+    XpbdSolver *solver = step->solver;
+    Particles *particles = step->scene->m_particles;
+    BallLinks *links = step->scene->m_links;
+    bool jacobi = (solver->m_method == XPBD_JACOBI);
+
+    for (int block = first; block < last; ++block)
+    {
+        int firstBall = step->firstBall + block * XPBD_BLOCK;
+        int lastBall = SDL_min(firstBall + XPBD_BLOCK, step->lastBall);
+
+        for (int i = firstBall; i < lastBall; ++i)
+        {
+            if (jacobi && (links[i].springCount > 0))
+            {
+                float scale = 1.f / (float)links[i].springCount;
+                particles->m_posX[i] += scale * solver->m_deltaX[i];
+                particles->m_posY[i] += scale * solver->m_deltaY[i];
+                solver->m_deltaX[i] = 0.f;
+                solver->m_deltaY[i] = 0.f;
+            }
+
+            // Contrainte C = y >= 0 de souplesse nulle
+            if (particles->m_posY[i] < 0.f)
+            {
+                particles->m_posY[i] = 0.f;
+                solver->m_contact[i] = true;
+            }
+        }
+    }
+}
+
+/// @brief Déduit les vitesses des déplacements et applique le rebond sur le sol.
+static void Xpbd_VelocityTask(void *data, int first, int last)
+{
+    XpbdStep *step = (XpbdStep *)data;
+    XpbdSolver *solver = step->solver;
+    Particles *particles = step->scene->m_particles;
+    float h = step->subStep;
+    float rebond = step->scene->m_gameMode->rebond;
+    float restSpeed = XPBD_REST_STEPS * fabsf(step->scene->m_gameMode->gravity) * h;
+
+    for (int block = first; block < last; ++block)
+    {
+        int firstBall = step->firstBall + block * XPBD_BLOCK;
+        int lastBall = SDL_min(firstBall + XPBD_BLOCK, step->lastBall);
+        float energy = 0.f;
+
+        for (int i = firstBall; i < lastBall; ++i)
+        {
+            float vx = (particles->m_posX[i] - solver->m_prevX[i]) / h;
+            float vy = (particles->m_posY[i] - solver->m_prevY[i]) / h;
+
+            // Une balle arrivée assez vite sur le sol rebondit,
+            // sinon elle garde la vitesse due à la contrainte (elle s'arrête)
+            if (solver->m_contact[i] && (solver->m_velY[i] < -restSpeed))
+                vy = rebond * solver->m_velY[i];
+
+            particles->m_velX[i] = vx;
+            particles->m_velY[i] = vy;
+            energy = fmaxf(energy, 0.5f * (vx * vx + vy * vy) / particles->m_invMass[i]);
+        }
+
+        step->energy[block] = energy;
+    }
+}
+
+/// @brief Applique une passe à tous les ressorts de l'île.
+/// Les couleurs sont traitées l'une après l'autre, chacune en parallèle.
+static void Xpbd_ForSprings(XpbdStep *step, ThreadPool *pool, int island, ThreadPoolTask task)
+{
+    Islands *islands = step->scene->m_islands;
+
+    if (!pool)
+    {
+        // Les ressorts de l'île sont déjà rangés par couleur
+        step->offset = islands->m_springStart[island];
+        task(step, 0, islands->m_springStart[island + 1] - step->offset);
+        return;
+    }
+
+    for (int color = 0; color < step->scene->m_springs->m_colorCount; ++color)
+    {
+        int first, last;
+        Islands_GetColorRange(islands, step->scene->m_springs, island, color, &first, &last);
+
+        step->offset = first;
+        ThreadPool_ParallelFor(pool, last - first, XPBD_SPRING_BATCH, task, step);
+    }
+}
+
+float Xpbd_SolveIsland(
+    XpbdSolver *solver, Scene *scene, int island, float timeStep, ThreadPool *pool)
+{
+    Islands *islands = scene->m_islands;
+    float localEnergy[XPBD_SMALL_BLOCKS];
+    XpbdStep step = { 0 };
+    int substeps = SDL_max(solver->m_substeps, 1);
+    ThreadPoolTask springTask =
+        (solver->m_method == XPBD_JACOBI) ? Xpbd_JacobiTask : Xpbd_GaussSeidelTask;
+
+    step.solver = solver;
+    step.scene = scene;
+    step.subStep = timeStep / (float)substeps;
+    step.firstBall = islands->m_ballStart[island];
+    step.lastBall = islands->m_ballStart[island + 1];
+
+    // Les petites îles sont résolues en même temps par plusieurs threads :
+    // leurs énergies partielles ne sont pas stockées dans le solveur
+    int ballCount = step.lastBall - step.firstBall;
+    int blockCount = (ballCount + XPBD_BLOCK - 1) / XPBD_BLOCK;
+    step.energy = (blockCount <= XPBD_SMALL_BLOCKS) ? localEnergy : solver->m_energy;
+
+    for (int substep = 0; substep < substeps; ++substep)
+    {
+        ThreadPool_ParallelFor(pool, blockCount, 1, Xpbd_PredictTask, &step);
+
+        for (step.iteration = 0; step.iteration < solver->m_iterations; ++step.iteration)
+        {
+            Xpbd_ForSprings(&step, pool, island, springTask);
+            ThreadPool_ParallelFor(pool, blockCount, 1, Xpbd_GroundTask, &step);
+        }
+
+        // Sans itération, seule la contrainte du sol est appliquée
+        if (solver->m_iterations <= 0)
+            ThreadPool_ParallelFor(pool, blockCount, 1, Xpbd_GroundTask, &step);
+
+        ThreadPool_ParallelFor(pool, blockCount, 1, Xpbd_VelocityTask, &step);
+    }
+
+    float energy = 0.f;
+    for (int block = 0; block < blockCount; ++block)
+    {
+        energy = fmaxf(energy, step.energy[block]);
+    }
+
+    return energy;
+}
@@ -0,0 +1,110 @@
+﻿#ifndef _XPBD_H_
+#define _XPBD_H_
+
+/// @file xpbd.h
+/// @defgroup Physics
+/// @{
+
+#include "../Settings.h"
+#include "../Utils/ThreadPool.h"
+
+typedef struct Scene_s Scene;
+
+/// @brief Pas de temps utilisé par le solveur XPBD (exprimé en s).
+#define XPBD_TIME_STEP (1.0f / 30.f)
+
+/// @brief Raideur d'un ressort avec le solveur XPBD (exprimée en N/m).
+/// La souplesse (compliance) d'un ressort est l'inverse de sa raideur.
+#define XPBD_SPRING_STIFFNESS 100000.0f
+
+/// @brief Nombre de sous-pas par pas de temps par défaut.
+#define XPBD_SUBSTEPS 4
+
+/// @brief Nombre d'itérations par sous-pas par défaut.
+#define XPBD_ITERATIONS 2
+
+/// @brief Méthode de résolution des contraintes.
+typedef enum XpbdMethod_e
+{
+    /// @brief Gauss-Seidel : chaque contrainte utilise les positions déjà corrigées.
+    /// Les contraintes d'une même couleur sont résolues en parallèle.
+    XPBD_GAUSS_SEIDEL,
+
+    /// @brief Jacobi : toutes les contraintes utilisent les positions du début de l'itération
+    /// et les corrections de chaque balle sont moyennées. Converge moins vite.
+    XPBD_JACOBI,
+} XpbdMethod;
+
+/// @brief Solveur XPBD (extended position-based dynamics).
+/// Les ressorts sont des contraintes de distance dont la souplesse est l'inverse de la raideur
+/// et le sol est une contrainte de position (y >= 0). Chaque pas de temps est découpé en
+/// sous-pas : les positions sont prédites à partir des vitesses, corrigées pour satisfaire
+/// les contraintes, puis les vitesses sont déduites des déplacements.
+/// Le solveur reste stable quel que soit le pas de temps : un nombre d'itérations plus faible
+/// rend seulement les ressorts plus mous.
+typedef struct XpbdSolver_s
+{
+    /// @brief Méthode de résolution des contraintes.
+    XpbdMethod m_method;
+
+    /// @brief Nombre de sous-pas par pas de temps.
+    int m_substeps;
+
+    /// @brief Nombre d'itérations de résolution des contraintes par sous-pas.
+    int m_iterations;
+
+    /// @brief Positions des balles au début du sous-pas.
+    float *m_prevX, *m_prevY;
+
+    /// @brief Corrections de position accumulées par la méthode de Jacobi.
+    float *m_deltaX, *m_deltaY;
+
+    /// @brief Vitesse verticale prédite de chaque balle (avant résolution des contraintes).
+    float *m_velY;
+
+    /// @brief Indique pour chaque balle si elle a touché le sol pendant le sous-pas.
+    bool *m_contact;
+
+    /// @brief Multiplicateur de Lagrange de chaque ressort.
+    float *m_lambda;
+
+    /// @brief Energie cinétique maximale de chaque bloc de balles.
+    float *m_energy;
+
+    /// @brief Nombre maximal de balles avant d'effectuer une réallocation mémoire.
+    int m_ballCapacity;
+
+    /// @brief Nombre maximal de ressorts avant d'effectuer une réallocation mémoire.
+    int m_springCapacity;
+} XpbdSolver;
+
+/// @brief Crée un solveur XPBD.
+/// @return Le solveur créé ou NULL en cas d'erreur.
+XpbdSolver *Xpbd_New();
+
+/// @brief Détruit un solveur préalablement alloué avec Xpbd_New().
+/// @param[in,out] solver le solveur à détruire.
+void Xpbd_Free(XpbdSolver *solver);
+
+/// @brief Alloue les tableaux temporaires pour les balles et les ressorts de la scène.
+/// Doit être appelée avant chaque pas de temps.
+/// @param[in,out] solver le solveur.
+/// @param[in] scene la scène.
+/// @return EXIT_SUCCESS ou EXIT_FAILURE.
+int Xpbd_Reserve(XpbdSolver *solver, Scene *scene);
+
+/// @brief Effectue un pas de temps XPBD pour une île de la scène.
+/// Plusieurs îles peuvent être résolues simultanément par des threads différents
+/// à condition de passer pool = NULL. Le résultat ne dépend pas du nombre de threads.
+/// @param[in,out] solver le solveur.
+/// @param[in,out] scene la scène.
+/// @param[in] island l'indice de l'île.
+/// @param[in] timeStep le pas de temps.
+/// @param[in] pool les threads sur lesquels répartir l'île (ou NULL).
+/// @return L'énergie cinétique maximale d'une balle de l'île après le pas de temps.
+float Xpbd_SolveIsland(
+    XpbdSolver *solver, Scene *scene, int island, float timeStep, ThreadPool *pool);
+
+/// @}
+
+#endif
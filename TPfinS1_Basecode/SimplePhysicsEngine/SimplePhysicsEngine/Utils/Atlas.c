@@ -0,0 +1,258 @@
+﻿#include "Atlas.h"
+
+Atlas *Atlas_New(Renderer *renderer)
+{
+    Atlas *atlas = NULL;
+
+    atlas = (Atlas *)calloc(1, sizeof(Atlas));
+    if (!atlas) goto ERROR_LABEL;
+
+    atlas->m_renderer = renderer;
+
+    return atlas;
+
+ERROR_LABEL:
+    printf("ERROR - Atlas_New()\n");
+    assert(false);
+    Atlas_Free(atlas);
+    return NULL;
+}
+
+void Atlas_Free(Atlas *atlas)
+{
+    if (!atlas) return;
+
+    for (int i = 0; i < atlas->m_count; ++i)
+    {
+        if (atlas->m_surfaces[i])
+            SDL_FreeSurface(atlas->m_surfaces[i]);
+    }
+    for (int i = 0; i < atlas->m_pageCount; ++i)
+    {
+        SDL_DestroyTexture(atlas->m_pages[i]);
+    }
+    free(atlas->m_surfaces);
+    free(atlas->m_sprites);
+
+    memset(atlas, 0, sizeof(Atlas));
+    free(atlas);
+}
+
+int Atlas_Add(Atlas *atlas, const char *path)
+{
+    SDL_Surface *surface = NULL;
+
+    if (atlas->m_pageCount > 0)
+        goto ERROR_LABEL;
+
+    if (atlas->m_count >= atlas->m_capacity)
+    {
+        int capacity = atlas->m_capacity > 0 ? atlas->m_capacity << 1 : 16;
+
+        SDL_Surface **surfaces = (SDL_Surface **)realloc(
+            atlas->m_surfaces, capacity * sizeof(SDL_Surface *));
+        if (!surfaces) goto ERROR_LABEL;
+        atlas->m_surfaces = surfaces;
+
+        Sprite *sprites = (Sprite *)realloc(atlas->m_sprites, capacity * sizeof(Sprite));
+        if (!sprites) goto ERROR_LABEL;
+        atlas->m_sprites = sprites;
+
+        atlas->m_capacity = capacity;
+    }
+
+    SDL_Surface *image = IMG_Load(path);
+    if (!image)
+    {
+        printf("ERROR - IMG_Load\n");
+        printf("      - %s\n", SDL_GetError());
+        goto ERROR_LABEL;
+    }
+
+    // Toutes les images sont converties au format des pages
+    surface = SDL_ConvertSurfaceFormat(image, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(image);
+    if (!surface) goto ERROR_LABEL;
+
+    int index = atlas->m_count++;
+    atlas->m_surfaces[index] = surface;
+    memset(&atlas->m_sprites[index], 0, sizeof(Sprite));
+
+    return index;
+
+ERROR_LABEL:
+    printf("ERROR - Atlas_Add()\n");
+    return -1;
+}
+
+/// @brief Copie une image dans une page à la position (x, y) de sa marge ; les bords de
+/// l'image sont recopiés dans la marge.
+static void Atlas_CopySurface(SDL_Surface *page, SDL_Surface *surface, int x, int y)
+{
+    int w = surface->w;
+    int h = surface->h;
+
+    for (int j = -ATLAS_PADDING; j < h + ATLAS_PADDING; ++j)
+    {
+        int srcY = SDL_max(0, SDL_min(j, h - 1));
+        const Uint8 *srcRow = (const Uint8 *)surface->pixels + srcY * surface->pitch;
+        Uint8 *dstRow = (Uint8 *)page->pixels + (y + ATLAS_PADDING + j) * page->pitch;
+        const Uint32 *src = (const Uint32 *)srcRow;
+        Uint32 *dst = (Uint32 *)dstRow + x + ATLAS_PADDING;
+
+        for (int i = -ATLAS_PADDING; i < w + ATLAS_PADDING; ++i)
+        {
+            dst[i] = src[SDL_max(0, SDL_min(i, w - 1))];
+        }
+    }
+}
+
+int Atlas_Build(Atlas *atlas)
+{
+    SDL_Surface *page = NULL;
+    int *order = NULL;
+    int *pages = NULL;
+    int pageWidth[ATLAS_MAX_PAGES] = { 0 };
+    int pageHeight[ATLAS_MAX_PAGES] = { 0 };
+    int count = atlas->m_count;
+
+    if (atlas->m_pageCount > 0 || count == 0)
+        goto ERROR_LABEL;
+
+    // Taille maximale d'une texture pour ce moteur de rendu
+    int maxWidth = ATLAS_MAX_SIZE;
+    int maxHeight = ATLAS_MAX_SIZE;
+    SDL_RendererInfo info;
+    if (SDL_GetRendererInfo(atlas->m_renderer->m_rendererSDL, &info) == 0)
+    {
+        if (info.max_texture_width > 0)
+            maxWidth = SDL_min(maxWidth, info.max_texture_width);
+        if (info.max_texture_height > 0)
+            maxHeight = SDL_min(maxHeight, info.max_texture_height);
+    }
+
+    order = (int *)calloc(count, sizeof(int));
+    pages = (int *)calloc(count, sizeof(int));
+    if (!order || !pages) goto ERROR_LABEL;
+
+    // Trie les images par hauteur décroissante (tri par insertion, peu d'images)
+    for (int i = 0; i < count; ++i)
+    {
+        int j = i;
+        while (j > 0 && atlas->m_surfaces[order[j - 1]]->h < atlas->m_surfaces[i]->h)
+        {
+            order[j] = order[j - 1];
+            j--;
+        }
+        order[j] = i;
+    }
+
+    // Range les images par étagères : une étagère est une ligne d'images dont la hauteur
+    // est celle de sa première image
+    int pageCount = 1;
+    int x = 0, shelfY = 0, shelfHeight = 0;
+    for (int k = 0; k < count; ++k)
+    {
+        int index = order[k];
+        int w = atlas->m_surfaces[index]->w + 2 * ATLAS_PADDING;
+        int h = atlas->m_surfaces[index]->h + 2 * ATLAS_PADDING;
+        if (w > maxWidth || h > maxHeight)
+        {
+            printf("ERROR - image %d too large for the atlas\n", index);
+            goto ERROR_LABEL;
+        }
+
+        // Nouvelle étagère
+        if (x + w > maxWidth)
+        {
+            shelfY += shelfHeight;
+            x = 0;
+            shelfHeight = 0;
+        }
+
+        // Nouvelle page
+        if (shelfY + h > maxHeight)
+        {
+            if (pageCount >= ATLAS_MAX_PAGES) goto ERROR_LABEL;
+            pageCount++;
+            x = 0;
+            shelfY = 0;
+            shelfHeight = 0;
+        }
+
+        int p = pageCount - 1;
+        pages[index] = p;
+        atlas->m_sprites[index].m_rect.x = x + ATLAS_PADDING;
+        atlas->m_sprites[index].m_rect.y = shelfY + ATLAS_PADDING;
+        atlas->m_sprites[index].m_rect.w = w - 2 * ATLAS_PADDING;
+        atlas->m_sprites[index].m_rect.h = h - 2 * ATLAS_PADDING;
+
+        x += w;
+        shelfHeight = SDL_max(shelfHeight, h);
+        pageWidth[p] = SDL_max(pageWidth[p], x);
+        pageHeight[p] = SDL_max(pageHeight[p], shelfY + shelfHeight);
+    }
+
+    // Copie les images dans les pages et crée les textures
+    for (int p = 0; p < pageCount; ++p)
+    {
+        page = SDL_CreateRGBSurfaceWithFormat(
+            0, pageWidth[p], pageHeight[p], 32, SDL_PIXELFORMAT_RGBA32);
+        if (!page) goto ERROR_LABEL;
+
+        memset(page->pixels, 0, page->h * page->pitch);
+        for (int i = 0; i < count; ++i)
+        {
+            if (pages[i] != p)
+                continue;
+
+            SDL_Rect *rect = &atlas->m_sprites[i].m_rect;
+            Atlas_CopySurface(
+                page, atlas->m_surfaces[i], rect->x - ATLAS_PADDING, rect->y - ATLAS_PADDING);
+        }
+
+        atlas->m_pages[p] = SDL_CreateTextureFromSurface(atlas->m_renderer->m_rendererSDL, page);
+        if (!atlas->m_pages[p])
+        {
+            printf("ERROR - SDL_CreateTextureFromSurface\n");
+            printf("      - %s\n", SDL_GetError());
+            goto ERROR_LABEL;
+        }
+        atlas->m_pageCount++;
+
+        SDL_FreeSurface(page);
+        page = NULL;
+    }
+
+    // Coordonnées de texture de chaque image
+    for (int i = 0; i < count; ++i)
+    {
+        Sprite *sprite = &atlas->m_sprites[i];
+        int p = pages[i];
+        sprite->m_texture = atlas->m_pages[p];
+        sprite->m_uv.x = (float)sprite->m_rect.x / (float)pageWidth[p];
+        sprite->m_uv.y = (float)sprite->m_rect.y / (float)pageHeight[p];
+        sprite->m_uv.w = (float)sprite->m_rect.w / (float)pageWidth[p];
+        sprite->m_uv.h = (float)sprite->m_rect.h / (float)pageHeight[p];
+
+        SDL_FreeSurface(atlas->m_surfaces[i]);
+        atlas->m_surfaces[i] = NULL;
+    }
+
+    free(order);
+    free(pages);
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - Atlas_Build()\n");
+    if (page) SDL_FreeSurface(page);
+    free(order);
+    free(pages);
+    return EXIT_FAILURE;
+}
+
+Sprite Atlas_GetSprite(Atlas *atlas, int index)
+{
+    return atlas->m_sprites[index];
+}
@@ -0,0 +1,90 @@
+﻿#ifndef _ATLAS_H_
+#define _ATLAS_H_
+
+/// @file atlas.h
+/// @defgroup Renderer
+/// @{
+
+#include "../Settings.h"
+#include "Renderer.h"
+
+/// @brief Taille maximale (exprimée en pixels) d'une page de l'atlas.
+#define ATLAS_MAX_SIZE 4096
+
+/// @brief Nombre maximal de pages de l'atlas.
+#define ATLAS_MAX_PAGES 16
+
+/// @brief Marge (exprimée en pixels) autour de chaque image de l'atlas.
+/// Les bords de l'image y sont recopiés pour que le filtrage ne mélange pas deux images voisines.
+#define ATLAS_PADDING 2
+
+/// @brief Image rangée dans une page de l'atlas.
+typedef struct Sprite_s
+{
+    /// @brief Page de l'atlas contenant l'image.
+    SDL_Texture *m_texture;
+
+    /// @brief Rectangle de l'image dans la page (exprimé en pixels).
+    SDL_Rect m_rect;
+
+    /// @brief Rectangle de l'image dans la page (coordonnées de texture entre 0 et 1).
+    SDL_FRect m_uv;
+} Sprite;
+
+/// @brief Atlas de textures.
+/// Les images sont chargées avec Atlas_Add() puis rangées par Atlas_Build() dans une ou
+/// quelques grandes textures (pages), par étagères de hauteurs décroissantes.
+/// Les images d'une même page peuvent être dessinées par un seul lot de sprites.
+typedef struct Atlas_s
+{
+    /// @brief Moteur de rendu.
+    Renderer *m_renderer;
+
+    /// @brief Images chargées en attente de rangement (libérées par Atlas_Build()).
+    SDL_Surface **m_surfaces;
+
+    /// @brief Images de l'atlas.
+    Sprite *m_sprites;
+
+    /// @brief Nombre d'images.
+    int m_count;
+
+    /// @brief Nombre maximal d'images avant d'effectuer une réallocation mémoire.
+    int m_capacity;
+
+    /// @brief Pages de l'atlas.
+    SDL_Texture *m_pages[ATLAS_MAX_PAGES];
+
+    /// @brief Nombre de pages.
+    int m_pageCount;
+} Atlas;
+
+/// @brief Crée un atlas vide.
+/// @param[in] renderer le moteur de rendu.
+/// @return L'atlas créé ou NULL en cas d'erreur.
+Atlas *Atlas_New(Renderer *renderer);
+
+/// @brief Détruit un atlas préalablement alloué avec Atlas_New().
+/// @param[in,out] atlas l'atlas à détruire.
+void Atlas_Free(Atlas *atlas);
+
+/// @brief Charge une image qui sera rangée dans l'atlas par Atlas_Build().
+/// @param[in,out] atlas l'atlas.
+/// @param[in] path le chemin de l'image.
+/// @return L'indice de l'image dans l'atlas ou -1 en cas d'erreur.
+int Atlas_Add(Atlas *atlas, const char *path);
+
+/// @brief Range les images chargées dans les pages de l'atlas et crée les textures.
+/// @param[in,out] atlas l'atlas.
+/// @return EXIT_SUCCESS ou EXIT_FAILURE.
+int Atlas_Build(Atlas *atlas);
+
+/// @brief Renvoie une image de l'atlas (après Atlas_Build()).
+/// @param[in] atlas l'atlas.
+/// @param[in] index l'indice de l'image.
+/// @return L'image.
+Sprite Atlas_GetSprite(Atlas *atlas, int index);
+
+/// @}
+
+#endif
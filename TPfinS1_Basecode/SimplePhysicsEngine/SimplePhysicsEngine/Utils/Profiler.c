@@ -0,0 +1,197 @@
+﻿#include "Profiler.h"
+#include "Timer.h"
+
+#ifdef PROFILER_ENABLED
+
+#ifdef _MSC_VER
+#  define PROFILER_THREAD_LOCAL __declspec(thread)
+#else
+#  define PROFILER_THREAD_LOCAL _Thread_local
+#endif
+
+/// @brief Zone fermée.
+typedef struct ProfilerEvent_s
+{
+    /// @brief Nom de la zone.
+    const char *m_name;
+
+    /// @brief Instants d'ouverture et de fermeture de la zone (exprimés en ns).
+    uint64_t m_start, m_end;
+} ProfilerEvent;
+
+/// @brief Zones enregistrées par un thread.
+typedef struct ProfilerThread_s
+{
+    /// @brief Nom du thread.
+    const char *m_name;
+
+    /// @brief Tampon circulaire des zones fermées.
+    ProfilerEvent m_events[PROFILER_EVENT_CAPACITY];
+
+    /// @brief Nombre total de zones fermées depuis le lancement.
+    uint64_t m_eventCount;
+
+    /// @brief Pile des zones ouvertes.
+    const char *m_stackNames[PROFILER_MAX_DEPTH];
+    uint64_t m_stackStarts[PROFILER_MAX_DEPTH];
+
+    /// @brief Nombre de zones ouvertes (éventuellement supérieur à PROFILER_MAX_DEPTH).
+    int m_depth;
+} ProfilerThread;
+
+/// @brief Threads ayant enregistré au moins une zone.
+static ProfilerThread *g_profilerThreads[PROFILER_MAX_THREADS];
+static int g_profilerThreadCount = 0;
+static SDL_SpinLock g_profilerLock = 0;
+
+/// @brief Instants de début des dernières images (tampon circulaire).
+static uint64_t g_profilerFrames[PROFILER_MAX_FRAMES];
+static int g_profilerFrameCount = 0;
+
+/// @brief Zones du thread courant.
+static PROFILER_THREAD_LOCAL ProfilerThread *t_profilerThread = NULL;
+
+/// @brief Renvoie l'instant courant (exprimé en ns) d'après une horloge monotone.
+static uint64_t Profiler_Now()
+{
+    return Timer_TicksToNs(SDL_GetPerformanceCounter());
+}
+
+/// @brief Renvoie les zones du thread courant, en les créant au premier appel.
+static ProfilerThread *Profiler_GetThread()
+{
+    if (t_profilerThread)
+        return t_profilerThread;
+
+    ProfilerThread *thread = (ProfilerThread *)calloc(1, sizeof(ProfilerThread));
+    if (!thread) return NULL;
+
+    SDL_AtomicLock(&g_profilerLock);
+    if (g_profilerThreadCount < PROFILER_MAX_THREADS)
+    {
+        g_profilerThreads[g_profilerThreadCount++] = thread;
+        t_profilerThread = thread;
+    }
+    SDL_AtomicUnlock(&g_profilerLock);
+
+    // Trop de threads : les zones de ce thread ne sont pas enregistrées
+    if (!t_profilerThread)
+        free(thread);
+
+    return t_profilerThread;
+}
+
+void Profiler_BeginZone(const char *name)
+{
+    ProfilerThread *thread = Profiler_GetThread();
+    if (!thread) return;
+
+    if (thread->m_depth < PROFILER_MAX_DEPTH)
+    {
+        thread->m_stackNames[thread->m_depth] = name;
+        thread->m_stackStarts[thread->m_depth] = Profiler_Now();
+    }
+    thread->m_depth++;
+}
+
+void Profiler_EndZone()
+{
+    ProfilerThread *thread = t_profilerThread;
+    if (!thread || thread->m_depth <= 0) return;
+
+    thread->m_depth--;
+    if (thread->m_depth >= PROFILER_MAX_DEPTH)
+        return;
+
+    ProfilerEvent *event = &thread->m_events[thread->m_eventCount % PROFILER_EVENT_CAPACITY];
+    event->m_name = thread->m_stackNames[thread->m_depth];
+    event->m_start = thread->m_stackStarts[thread->m_depth];
+    event->m_end = Profiler_Now();
+    thread->m_eventCount++;
+}
+
+void Profiler_NextFrame()
+{
+    g_profilerFrames[g_profilerFrameCount % PROFILER_MAX_FRAMES] = Profiler_Now();
+    g_profilerFrameCount++;
+}
+
+void Profiler_SetThreadName(const char *name)
+{
+    ProfilerThread *thread = Profiler_GetThread();
+    if (thread) thread->m_name = name;
+}
+
+int Profiler_WriteTrace(const char *path, int frameCount)
+{
+    FILE *file = fopen(path, "w");
+    if (!file) goto ERROR_LABEL;
+
+    // Début de la plus ancienne image demandée encore connue
+    frameCount = SDL_min(frameCount, SDL_min(g_profilerFrameCount, PROFILER_MAX_FRAMES));
+    uint64_t windowStart = 0;
+    if (frameCount > 0)
+    {
+        int first = g_profilerFrameCount - frameCount;
+        windowStart = g_profilerFrames[first % PROFILER_MAX_FRAMES];
+    }
+
+    SDL_AtomicLock(&g_profilerLock);
+    int threadCount = g_profilerThreadCount;
+    SDL_AtomicUnlock(&g_profilerLock);
+
+    fprintf(file, "{\"displayTimeUnit\": \"ns\", \"traceEvents\": [\n");
+    fprintf(
+        file, "{\"name\": \"process_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": 0, "
+        "\"args\": {\"name\": \"SimplePhysicsEngine\"}}"
+    );
+
+    // Débuts des images (événements instantanés)
+    for (int i = g_profilerFrameCount - frameCount; i < g_profilerFrameCount; ++i)
+    {
+        uint64_t start = g_profilerFrames[i % PROFILER_MAX_FRAMES];
+        fprintf(
+            file, ",\n{\"name\": \"Frame %d\", \"ph\": \"i\", \"s\": \"g\", \"pid\": 1, "
+            "\"tid\": 0, \"ts\": %.3f}", i, (double)(start - windowStart) / 1000.0
+        );
+    }
+
+    for (int t = 0; t < threadCount; ++t)
+    {
+        ProfilerThread *thread = g_profilerThreads[t];
+        fprintf(
+            file, ",\n{\"name\": \"thread_name\", \"ph\": \"M\", \"pid\": 1, \"tid\": %d, "
+            "\"args\": {\"name\": \"%s\"}}", t, thread->m_name ? thread->m_name : "thread"
+        );
+
+        // Zones encore présentes dans le tampon circulaire, de la plus ancienne à la plus récente
+        uint64_t last = thread->m_eventCount;
+        uint64_t first = (last > PROFILER_EVENT_CAPACITY) ? last - PROFILER_EVENT_CAPACITY : 0;
+        for (uint64_t i = first; i < last; ++i)
+        {
+            ProfilerEvent *event = &thread->m_events[i % PROFILER_EVENT_CAPACITY];
+            if (event->m_start < windowStart)
+                continue;
+
+            fprintf(
+                file, ",\n{\"name\": \"%s\", \"cat\": \"spe\", \"ph\": \"X\", \"pid\": 1, "
+                "\"tid\": %d, \"ts\": %.3f, \"dur\": %.3f}",
+                event->m_name, t, (double)(event->m_start - windowStart) / 1000.0,
+                (double)(event->m_end - event->m_start) / 1000.0
+            );
+        }
+    }
+
+    fprintf(file, "\n]}\n");
+    fclose(file);
+
+    printf("Profiler - %d frames written to %s\n", frameCount, path);
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - Profiler_WriteTrace()\n");
+    return EXIT_FAILURE;
+}
+
+#endif
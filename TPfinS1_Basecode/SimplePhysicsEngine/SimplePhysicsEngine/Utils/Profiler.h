@@ -0,0 +1,80 @@
+﻿#ifndef _PROFILER_H_
+#define _PROFILER_H_
+
+/// @file profiler.h
+/// @defgroup Profiler
+/// @{
+
+#include "../Settings.h"
+
+/// @brief Profileur par zones.
+/// Une zone est délimitée par PROFILE_ZONE_BEGIN() et PROFILE_ZONE_END() ; les zones peuvent
+/// être imbriquées. Chaque thread enregistre ses zones dans son propre tampon circulaire,
+/// sans synchronisation. PROFILE_FRAME() marque le début d'une image et
+/// PROFILE_WRITE_TRACE() écrit les zones des dernières images au format "trace_event"
+/// de Chrome (à ouvrir avec chrome://tracing ou https://ui.perfetto.dev).
+///
+/// Le profileur n'est compilé que si PROFILER_ENABLED est défini (make PROFILE=1) :
+/// sinon toutes les macros sont vides.
+
+/// @brief Nombre maximal de zones conservées par thread.
+#define PROFILER_EVENT_CAPACITY (1 << 15)
+
+/// @brief Profondeur maximale d'imbrication des zones.
+#define PROFILER_MAX_DEPTH 32
+
+/// @brief Nombre maximal de threads enregistrant des zones.
+#define PROFILER_MAX_THREADS 64
+
+/// @brief Nombre maximal d'images dont le début est conservé.
+#define PROFILER_MAX_FRAMES 256
+
+/// @brief Nombre d'images écrites par défaut dans une trace.
+#define PROFILER_TRACE_FRAMES 120
+
+/// @brief Fichier dans lequel la trace est écrite depuis le jeu.
+#define PROFILER_TRACE_PATH "trace.json"
+
+#ifdef PROFILER_ENABLED
+
+/// @brief Ouvre une zone sur le thread courant.
+/// @param[in] name le nom de la zone (chaîne constante).
+void Profiler_BeginZone(const char *name);
+
+/// @brief Ferme la dernière zone ouverte sur le thread courant.
+void Profiler_EndZone();
+
+/// @brief Marque le début d'une nouvelle image.
+void Profiler_NextFrame();
+
+/// @brief Nomme le thread courant dans les traces.
+/// @param[in] name le nom du thread (chaîne constante).
+void Profiler_SetThreadName(const char *name);
+
+/// @brief Ecrit les zones des dernières images au format "trace_event" de Chrome.
+/// Doit être appelée entre deux images, lorsque les autres threads n'enregistrent aucune zone.
+/// @param[in] path le chemin du fichier.
+/// @param[in] frameCount le nombre d'images à écrire.
+/// @return EXIT_SUCCESS ou EXIT_FAILURE.
+int Profiler_WriteTrace(const char *path, int frameCount);
+
+#  define PROFILE_ZONE_BEGIN(name) Profiler_BeginZone(name)
+#  define PROFILE_ZONE_END() Profiler_EndZone()
+#  define PROFILE_FRAME() Profiler_NextFrame()
+#  define PROFILE_THREAD_NAME(name) Profiler_SetThreadName(name)
+#  define PROFILE_WRITE_TRACE(path, frameCount) Profiler_WriteTrace(path, frameCount)
+
+#else
+
+#  define PROFILE_ZONE_BEGIN(name) ((void)0)
+#  define PROFILE_ZONE_END() ((void)0)
+#  define PROFILE_FRAME() ((void)0)
+#  define PROFILE_THREAD_NAME(name) ((void)0)
+#  define PROFILE_WRITE_TRACE(path, frameCount) \
+    (printf("WARNING - profiler disabled (build with make PROFILE=1)\n"), EXIT_FAILURE)
+
+#endif
+
+/// @}
+
+#endif
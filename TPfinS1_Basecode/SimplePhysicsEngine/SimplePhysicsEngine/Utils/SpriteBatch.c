@@ -0,0 +1,407 @@
+﻿#include "SpriteBatch.h"
+#include "Profiler.h"
+
+SpriteBatch *SpriteBatch_New(Renderer *renderer)
+{
+    SpriteBatch *batch = NULL;
+
+    batch = (SpriteBatch *)calloc(1, sizeof(SpriteBatch));
+    if (!batch) goto ERROR_LABEL;
+
+    batch->m_renderer = renderer;
+    batch->m_useGeometry = SPRITE_BATCH_GEOMETRY;
+
+    return batch;
+
+ERROR_LABEL:
+    printf("ERROR - SpriteBatch_New()\n");
+    assert(false);
+    SpriteBatch_Free(batch);
+    return NULL;
+}
+
+void SpriteBatch_Free(SpriteBatch *batch)
+{
+    if (!batch) return;
+
+    free(batch->m_vertices);
+    free(batch->m_indices);
+    free(batch->m_srcRects);
+    free(batch->m_points);
+
+    memset(batch, 0, sizeof(SpriteBatch));
+    free(batch);
+}
+
+/// @brief Agrandit les tableaux du lot pour qu'ils puissent contenir count quadrilatères.
+/// @return EXIT_SUCCESS ou EXIT_FAILURE.
+static int SpriteBatch_Reserve(SpriteBatch *batch, int count)
+{
+    if (count > batch->m_capacity)
+    {
+        int capacity = batch->m_capacity > 0 ? batch->m_capacity : 1 << 10;
+        while (capacity < count)
+            capacity <<= 1;
+
+        SpriteVertex *vertices = (SpriteVertex *)realloc(
+            batch->m_vertices, 4 * capacity * sizeof(SpriteVertex));
+        if (!vertices) goto ERROR_LABEL;
+        batch->m_vertices = vertices;
+
+        int *indices = (int *)realloc(batch->m_indices, 6 * capacity * sizeof(int));
+        if (!indices) goto ERROR_LABEL;
+        batch->m_indices = indices;
+
+        SDL_Rect *srcRects = (SDL_Rect *)realloc(batch->m_srcRects, capacity * sizeof(SDL_Rect));
+        if (!srcRects) goto ERROR_LABEL;
+        batch->m_srcRects = srcRects;
+
+        // Les indices ne dépendent que du numéro du sprite
+        for (int i = batch->m_capacity; i < capacity; ++i)
+        {
+            indices[6 * i + 0] = 4 * i + 0;
+            indices[6 * i + 1] = 4 * i + 1;
+            indices[6 * i + 2] = 4 * i + 2;
+            indices[6 * i + 3] = 4 * i + 0;
+            indices[6 * i + 4] = 4 * i + 2;
+            indices[6 * i + 5] = 4 * i + 3;
+        }
+
+        batch->m_capacity = capacity;
+    }
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - SpriteBatch_Reserve()\n");
+    return EXIT_FAILURE;
+}
+
+/// @brief Prépare l'ajout d'un sprite : change de lot si la texture change et agrandit
+/// les tableaux si nécessaire.
+/// @return Les quatre sommets du nouveau sprite ou NULL en cas d'erreur.
+static SpriteVertex *SpriteBatch_Push(SpriteBatch *batch, const Sprite *sprite)
+{
+    SDL_Texture *texture = sprite->m_texture;
+
+    if (texture != batch->m_texture)
+    {
+        SpriteBatch_Flush(batch);
+        batch->m_texture = texture;
+    }
+
+    if (SpriteBatch_Reserve(batch, batch->m_count + 1) == EXIT_FAILURE)
+        goto ERROR_LABEL;
+
+    SpriteVertex *vertices = &batch->m_vertices[4 * batch->m_count];
+    batch->m_srcRects[batch->m_count] = sprite->m_rect;
+    batch->m_count++;
+
+    // Sommets dans l'ordre : haut gauche, haut droit, bas droit, bas gauche
+    const SDL_Color white = { 255, 255, 255, 255 };
+    const float u[4] = { 0.f, 1.f, 1.f, 0.f };
+    const float v[4] = { 0.f, 0.f, 1.f, 1.f };
+    const SDL_FRect *uv = &sprite->m_uv;
+    for (int i = 0; i < 4; ++i)
+    {
+        vertices[i].color = white;
+        vertices[i].tex_coord.x = uv->x + u[i] * uv->w;
+        vertices[i].tex_coord.y = uv->y + v[i] * uv->h;
+    }
+
+    return vertices;
+
+ERROR_LABEL:
+    printf("ERROR - SpriteBatch_Push()\n");
+    return NULL;
+}
+
+int SpriteBatch_AddRect(SpriteBatch *batch, const Sprite *sprite, const SDL_FRect *rect)
+{
+    SpriteVertex *vertices = SpriteBatch_Push(batch, sprite);
+    if (!vertices) return EXIT_FAILURE;
+
+    float x0 = rect->x, x1 = rect->x + rect->w;
+    float y0 = rect->y, y1 = rect->y + rect->h;
+
+    vertices[0].position.x = x0; vertices[0].position.y = y0;
+    vertices[1].position.x = x1; vertices[1].position.y = y0;
+    vertices[2].position.x = x1; vertices[2].position.y = y1;
+    vertices[3].position.x = x0; vertices[3].position.y = y1;
+
+    return EXIT_SUCCESS;
+}
+
+int SpriteBatch_AddSegment(
+    SpriteBatch *batch, const Sprite *sprite, SDL_FPoint start, SDL_FPoint end, float halfWidth)
+{
+    float dx = end.x - start.x;
+    float dy = end.y - start.y;
+    float length = sqrtf(dx * dx + dy * dy);
+    if (length <= 0.f)
+        return EXIT_SUCCESS;
+
+    SpriteVertex *vertices = SpriteBatch_Push(batch, sprite);
+    if (!vertices) return EXIT_FAILURE;
+
+    // Axe horizontal de la texture : vecteur directeur tourné d'un quart de tour
+    float scale = halfWidth / length;
+    float nx = dy * scale;
+    float ny = -dx * scale;
+
+    vertices[0].position.x = start.x - nx; vertices[0].position.y = start.y - ny;
+    vertices[1].position.x = start.x + nx; vertices[1].position.y = start.y + ny;
+    vertices[2].position.x = end.x + nx;   vertices[2].position.y = end.y + ny;
+    vertices[3].position.x = end.x - nx;   vertices[3].position.y = end.y - ny;
+
+    return EXIT_SUCCESS;
+}
+
+/// @brief Dessine les sprites du lot un par un (sans SDL_RenderGeometry()).
+/// Chaque quadrilatère est un rectangle éventuellement tourné.
+static void SpriteBatch_DrawSprites(SpriteBatch *batch)
+{
+    SDL_Renderer *rendererSDL = batch->m_renderer->m_rendererSDL;
+
+    for (int i = 0; i < batch->m_count; ++i)
+    {
+        const SpriteVertex *vertices = &batch->m_vertices[4 * i];
+        const SDL_Rect *srcRect = &batch->m_srcRects[i];
+        SDL_FPoint p0 = vertices[0].position;
+        SDL_FPoint p1 = vertices[1].position;
+        SDL_FPoint p3 = vertices[3].position;
+
+        float ux = p1.x - p0.x, uy = p1.y - p0.y;
+        float vx = p3.x - p0.x, vy = p3.y - p0.y;
+
+        SDL_FRect dstRect = { 0 };
+        dstRect.w = sqrtf(ux * ux + uy * uy);
+        dstRect.h = sqrtf(vx * vx + vy * vy);
+        dstRect.x = p0.x + 0.5f * (ux + vx) - 0.5f * dstRect.w;
+        dstRect.y = p0.y + 0.5f * (uy + vy) - 0.5f * dstRect.h;
+
+        if (uy == 0.f && ux > 0.f)
+        {
+            SDL_RenderCopyF(rendererSDL, batch->m_texture, srcRect, &dstRect);
+        }
+        else
+        {
+            double angle = atan2((double)uy, (double)ux) * 180.0 / M_PI;
+            SDL_RenderCopyExF(
+                rendererSDL, batch->m_texture, srcRect, &dstRect, angle, NULL, 0);
+        }
+    }
+    batch->m_drawCallCount += batch->m_count;
+}
+
+void SpriteBatch_Flush(SpriteBatch *batch)
+{
+    if (batch->m_count == 0)
+        return;
+
+    PROFILE_ZONE_BEGIN("SpriteBatch_Flush");
+
+#if SPRITE_BATCH_GEOMETRY
+    if (batch->m_useGeometry)
+    {
+        int exitStatus = SDL_RenderGeometry(
+            batch->m_renderer->m_rendererSDL, batch->m_texture,
+            batch->m_vertices, 4 * batch->m_count, batch->m_indices, 6 * batch->m_count
+        );
+        batch->m_drawCallCount++;
+
+        // Le moteur de rendu ne sait pas dessiner de triangles
+        if (exitStatus < 0)
+        {
+            printf("WARNING - SDL_RenderGeometry() failed: %s\n", SDL_GetError());
+            batch->m_useGeometry = false;
+        }
+    }
+#endif
+
+    if (!batch->m_useGeometry)
+        SpriteBatch_DrawSprites(batch);
+
+    batch->m_count = 0;
+
+    PROFILE_ZONE_END();
+}
+
+#if SPRITE_BATCH_GEOMETRY
+/// @brief Dessine les segments par des quadrilatères non texturés d'un pixel de large,
+/// en un seul appel à SDL_RenderGeometry().
+/// @return false si le moteur de rendu a refusé SDL_RenderGeometry().
+static bool SpriteBatch_DrawLineQuads(
+    SpriteBatch *batch, const SDL_FPoint *points, int count, Color color)
+{
+    // Les tableaux du lot sont vides après SpriteBatch_Flush() et servent de tampon
+    if (SpriteBatch_Reserve(batch, count) == EXIT_FAILURE)
+        return true;
+
+    const SDL_Color vertexColor = { color.r, color.g, color.b, color.a };
+    for (int i = 0; i < count; ++i)
+    {
+        SpriteVertex *vertices = &batch->m_vertices[4 * i];
+        SDL_FPoint start = points[2 * i];
+        SDL_FPoint end = points[2 * i + 1];
+
+        // Vecteur directeur de norme 1/2 (un segment de longueur nulle devient un pixel)
+        float dx = end.x - start.x;
+        float dy = end.y - start.y;
+        float length = sqrtf(dx * dx + dy * dy);
+        float tx = 0.5f, ty = 0.f;
+        if (length > 0.f)
+        {
+            tx = 0.5f * dx / length;
+            ty = 0.5f * dy / length;
+        }
+
+        // Le quadrilatère déborde d'un demi-pixel de chaque côté du segment
+        vertices[0].position.x = start.x - tx - ty; vertices[0].position.y = start.y - ty + tx;
+        vertices[1].position.x = start.x - tx + ty; vertices[1].position.y = start.y - ty - tx;
+        vertices[2].position.x = end.x + tx + ty;   vertices[2].position.y = end.y + ty - tx;
+        vertices[3].position.x = end.x + tx - ty;   vertices[3].position.y = end.y + ty + tx;
+
+        for (int j = 0; j < 4; ++j)
+        {
+            vertices[j].color = vertexColor;
+            vertices[j].tex_coord.x = 0.f;
+            vertices[j].tex_coord.y = 0.f;
+        }
+    }
+
+    int exitStatus = SDL_RenderGeometry(
+        batch->m_renderer->m_rendererSDL, NULL,
+        batch->m_vertices, 4 * count, batch->m_indices, 6 * count
+    );
+    batch->m_drawCallCount++;
+
+    // Le moteur de rendu ne sait pas dessiner de triangles
+    if (exitStatus < 0)
+    {
+        printf("WARNING - SDL_RenderGeometry() failed: %s\n", SDL_GetError());
+        batch->m_useGeometry = false;
+        return false;
+    }
+
+    return true;
+}
+#endif
+
+/// @brief Agrandit le tableau des points rasterisés.
+/// @return EXIT_SUCCESS ou EXIT_FAILURE.
+static int SpriteBatch_ReservePoints(SpriteBatch *batch, int count)
+{
+    if (count <= batch->m_pointCapacity)
+        return EXIT_SUCCESS;
+
+    int capacity = SDL_max(count, 2 * batch->m_pointCapacity);
+    SDL_FPoint *points = (SDL_FPoint *)realloc(batch->m_points, capacity * sizeof(SDL_FPoint));
+    if (!points)
+    {
+        printf("ERROR - SpriteBatch_ReservePoints()\n");
+        return EXIT_FAILURE;
+    }
+
+    batch->m_points = points;
+    batch->m_pointCapacity = capacity;
+
+    return EXIT_SUCCESS;
+}
+
+/// @brief Rasterise les segments visibles en points (un par pixel selon l'axe principal),
+/// envoyés en un seul appel à SDL_RenderDrawPointsF().
+static void SpriteBatch_DrawLinePoints(
+    SpriteBatch *batch, const SDL_FPoint *points, int count)
+{
+    float width = (float)batch->m_renderer->m_width;
+    float height = (float)batch->m_renderer->m_height;
+
+    // Un segment visible n'a pas besoin de plus de points que le périmètre de l'écran
+    int maxSteps = batch->m_renderer->m_width + batch->m_renderer->m_height;
+    int pointCount = 0;
+
+    for (int i = 0; i < count; ++i)
+    {
+        SDL_FPoint start = points[2 * i];
+        SDL_FPoint end = points[2 * i + 1];
+
+        // Segment entièrement d'un côté de l'écran
+        if ((start.x < 0.f && end.x < 0.f) || (start.x >= width && end.x >= width)
+            || (start.y < 0.f && end.y < 0.f) || (start.y >= height && end.y >= height))
+            continue;
+
+        float dx = end.x - start.x;
+        float dy = end.y - start.y;
+        int steps = (int)ceilf(fmaxf(fabsf(dx), fabsf(dy)));
+        steps = SDL_min(steps, maxSteps);
+
+        if (SpriteBatch_ReservePoints(batch, pointCount + steps + 1) == EXIT_FAILURE)
+            break;
+
+        SDL_FPoint *linePoints = &batch->m_points[pointCount];
+        float scale = steps > 0 ? 1.f / (float)steps : 0.f;
+        for (int j = 0; j <= steps; ++j)
+        {
+            float t = (float)j * scale;
+            linePoints[j].x = start.x + t * dx;
+            linePoints[j].y = start.y + t * dy;
+        }
+        pointCount += steps + 1;
+    }
+
+    if (pointCount > 0)
+    {
+        SDL_RenderDrawPointsF(batch->m_renderer->m_rendererSDL, batch->m_points, pointCount);
+        batch->m_drawCallCount++;
+    }
+}
+
+void SpriteBatch_DrawLines(SpriteBatch *batch, const SDL_FPoint *points, int count, Color color)
+{
+    SDL_Renderer *rendererSDL = batch->m_renderer->m_rendererSDL;
+
+    if (count <= 0)
+        return;
+
+    SpriteBatch_Flush(batch);
+
+#if SPRITE_BATCH_GEOMETRY
+    if (batch->m_useGeometry && SpriteBatch_DrawLineQuads(batch, points, count, color))
+        return;
+#endif
+
+    SDL_SetRenderDrawColor(rendererSDL, color.r, color.g, color.b, color.a);
+    SpriteBatch_DrawLinePoints(batch, points, count);
+}
+
+void SpriteBatch_DrawPoints(SpriteBatch *batch, const SDL_FPoint *points, int count, Color color)
+{
+    SDL_Renderer *rendererSDL = batch->m_renderer->m_rendererSDL;
+
+    if (count <= 0)
+        return;
+
+    SpriteBatch_Flush(batch);
+    SDL_SetRenderDrawColor(rendererSDL, color.r, color.g, color.b, color.a);
+    SDL_RenderDrawPointsF(rendererSDL, points, count);
+    batch->m_drawCallCount++;
+}
+
+void SpriteBatch_FillRects(SpriteBatch *batch, const SDL_FRect *rects, int count, Color color)
+{
+    SDL_Renderer *rendererSDL = batch->m_renderer->m_rendererSDL;
+
+    if (count <= 0)
+        return;
+
+    SpriteBatch_Flush(batch);
+    SDL_SetRenderDrawColor(rendererSDL, color.r, color.g, color.b, color.a);
+    SDL_RenderFillRectsF(rendererSDL, rects, count);
+    batch->m_drawCallCount++;
+}
+
+void SpriteBatch_Reset(SpriteBatch *batch)
+{
+    batch->m_drawCallCount = 0;
+}
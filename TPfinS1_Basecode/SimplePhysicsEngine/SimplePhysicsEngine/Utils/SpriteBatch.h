@@ -0,0 +1,140 @@
+﻿#ifndef _SPRITE_BATCH_H_
+#define _SPRITE_BATCH_H_
+
+/// @file spritebatch.h
+/// @defgroup Renderer
+/// @{
+
+#include "../Settings.h"
+#include "Renderer.h"
+#include "Atlas.h"
+
+/// @brief SDL_RenderGeometry() n'existe que depuis SDL 2.0.18 : avec une version antérieure,
+/// les sprites sont dessinés un par un.
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+#  define SPRITE_BATCH_GEOMETRY 1
+typedef SDL_Vertex SpriteVertex;
+#else
+#  define SPRITE_BATCH_GEOMETRY 0
+
+/// @brief Sommet d'un sprite (même disposition que SDL_Vertex).
+typedef struct SpriteVertex_s
+{
+    /// @brief Position du sommet (exprimée en pixels).
+    SDL_FPoint position;
+
+    /// @brief Couleur du sommet.
+    SDL_Color color;
+
+    /// @brief Coordonnées de texture du sommet (entre 0 et 1).
+    SDL_FPoint tex_coord;
+} SpriteVertex;
+#endif
+
+/// @brief Regroupe les sprites dessinés avec une même texture (une même page de l'atlas).
+/// Chaque sprite est un quadrilatère (deux triangles) ajouté aux tableaux de sommets et
+/// d'indices ; le lot est envoyé en un seul appel à SDL_RenderGeometry() lorsque la texture
+/// change ou lorsque SpriteBatch_Flush() est appelée. L'ordre d'affichage est conservé.
+typedef struct SpriteBatch_s
+{
+    /// @brief Moteur de rendu.
+    Renderer *m_renderer;
+
+    /// @brief Texture des sprites du lot courant.
+    SDL_Texture *m_texture;
+
+    /// @brief Sommets des sprites du lot courant (quatre par sprite).
+    SpriteVertex *m_vertices;
+
+    /// @brief Indices des triangles du lot courant (six par sprite).
+    int *m_indices;
+
+    /// @brief Rectangle source de chaque sprite du lot courant (dans sa page de l'atlas).
+    SDL_Rect *m_srcRects;
+
+    /// @brief Nombre de sprites du lot courant.
+    int m_count;
+
+    /// @brief Nombre maximal de sprites avant d'effectuer une réallocation mémoire.
+    int m_capacity;
+
+    /// @brief Points des segments rasterisés lorsque SDL_RenderGeometry() n'est pas disponible.
+    SDL_FPoint *m_points;
+
+    /// @brief Nombre maximal de points avant d'effectuer une réallocation mémoire.
+    int m_pointCapacity;
+
+    /// @brief Nombre d'envois au moteur de rendu depuis le dernier appel à SpriteBatch_Reset().
+    int m_drawCallCount;
+
+    /// @brief Faux si le moteur de rendu a refusé SDL_RenderGeometry() : les sprites sont
+    /// alors dessinés un par un.
+    bool m_useGeometry;
+} SpriteBatch;
+
+/// @brief Crée un lot de sprites vide.
+/// @param[in] renderer le moteur de rendu.
+/// @return Le lot créé ou NULL en cas d'erreur.
+SpriteBatch *SpriteBatch_New(Renderer *renderer);
+
+/// @brief Détruit un lot préalablement alloué avec SpriteBatch_New().
+/// @param[in,out] batch le lot à détruire.
+void SpriteBatch_Free(SpriteBatch *batch);
+
+/// @brief Ajoute un sprite rectangulaire aligné sur les axes.
+/// @param[in,out] batch le lot.
+/// @param[in] sprite l'image du sprite.
+/// @param[in] rect le rectangle de destination (exprimé en pixels).
+/// @return EXIT_SUCCESS ou EXIT_FAILURE.
+int SpriteBatch_AddRect(SpriteBatch *batch, const Sprite *sprite, const SDL_FRect *rect);
+
+/// @brief Ajoute un sprite étiré entre deux points.
+/// L'axe vertical de la texture va de start à end et son axe horizontal est perpendiculaire ;
+/// les sommets sont calculés à partir du vecteur directeur, sans trigonométrie.
+/// @param[in,out] batch le lot.
+/// @param[in] sprite l'image du sprite.
+/// @param[in] start le milieu du bord supérieur de la texture (exprimé en pixels).
+/// @param[in] end le milieu du bord inférieur de la texture (exprimé en pixels).
+/// @param[in] halfWidth la demi-largeur du sprite (exprimée en pixels).
+/// @return EXIT_SUCCESS ou EXIT_FAILURE.
+int SpriteBatch_AddSegment(
+    SpriteBatch *batch, const Sprite *sprite, SDL_FPoint start, SDL_FPoint end, float halfWidth);
+
+/// @brief Dessine des segments d'une seule couleur (un pixel d'épaisseur), en un seul appel.
+/// Chaque segment est un quadrilatère non texturé d'un pixel de large et tous sont envoyés par
+/// SDL_RenderGeometry(). Sans SDL_RenderGeometry(), les segments visibles sont rasterisés en
+/// points (un par pixel) envoyés par SDL_RenderDrawPointsF().
+/// Les sprites en attente sont d'abord envoyés, ce qui conserve l'ordre d'affichage.
+/// @param[in,out] batch le lot.
+/// @param[in] points les extrémités des segments, deux par segment (exprimées en pixels).
+/// @param[in] count le nombre de segments.
+/// @param[in] color la couleur des segments.
+void SpriteBatch_DrawLines(SpriteBatch *batch, const SDL_FPoint *points, int count, Color color);
+
+/// @brief Dessine des points d'une seule couleur, en un seul appel.
+/// Les sprites en attente sont d'abord envoyés, ce qui conserve l'ordre d'affichage.
+/// @param[in,out] batch le lot.
+/// @param[in] points les points (exprimés en pixels).
+/// @param[in] count le nombre de points.
+/// @param[in] color la couleur des points.
+void SpriteBatch_DrawPoints(SpriteBatch *batch, const SDL_FPoint *points, int count, Color color);
+
+/// @brief Remplit des rectangles d'une seule couleur, en un seul appel.
+/// Les sprites en attente sont d'abord envoyés, ce qui conserve l'ordre d'affichage.
+/// @param[in,out] batch le lot.
+/// @param[in] rects les rectangles (exprimés en pixels).
+/// @param[in] count le nombre de rectangles.
+/// @param[in] color la couleur des rectangles.
+void SpriteBatch_FillRects(SpriteBatch *batch, const SDL_FRect *rects, int count, Color color);
+
+/// @brief Envoie le lot courant au moteur de rendu puis le vide.
+/// @param[in,out] batch le lot.
+void SpriteBatch_Flush(SpriteBatch *batch);
+
+/// @brief Remet à zéro le compteur d'envois (en début d'image).
+/// @param[in,out] batch le lot.
+void SpriteBatch_Reset(SpriteBatch *batch);
+
+/// @}
+
+#endif
@@ -0,0 +1,288 @@
+﻿#if defined(__linux__) && !defined(_GNU_SOURCE)
+#  define _GNU_SOURCE
+#endif
+
+#include "ThreadPool.h"
+#include "Profiler.h"
+
+#if defined(_WIN32)
+#  include <windows.h>
+#elif defined(__linux__)
+#  include <pthread.h>
+#  include <sched.h>
+#endif
+
+ThreadPool *g_threadPool = NULL;
+
+typedef struct ThreadPoolWorker_s
+{
+    /// @brief Groupe auquel appartient le thread.
+    ThreadPool *m_pool;
+
+    /// @brief Indice du thread dans le groupe (0 désigne le thread appelant).
+    int m_index;
+} ThreadPoolWorker;
+
+struct ThreadPool_s
+{
+    /// @brief Threads créés par le groupe.
+    SDL_Thread **m_threads;
+
+    /// @brief Paramètres des threads créés par le groupe.
+    ThreadPoolWorker *m_workers;
+
+    /// @brief Nombre de threads, thread appelant compris.
+    int m_threadCount;
+
+    /// @brief Indique si les threads sont attachés à un coeur.
+    bool m_pinThreads;
+
+    /// @brief Protège les champs ci-dessous.
+    SDL_mutex *m_mutex;
+
+    /// @brief Signale aux threads qu'une nouvelle tâche est disponible.
+    SDL_cond *m_startCond;
+
+    /// @brief Signale au thread appelant que tous les threads ont terminé.
+    SDL_cond *m_doneCond;
+
+    /// @brief Numéro de la tâche courante, incrémenté à chaque appel à ThreadPool_ParallelFor().
+    int m_generation;
+
+    /// @brief Nombre de threads n'ayant pas encore terminé la tâche courante.
+    int m_pending;
+
+    /// @brief Indique que les threads doivent se terminer.
+    bool m_quit;
+
+    /// @brief Tâche courante.
+    ThreadPoolTask m_task;
+
+    /// @brief Données de la tâche courante.
+    void *m_data;
+
+    /// @brief Nombre d'indices de la tâche courante.
+    int m_count;
+
+    /// @brief Taille des lots de la tâche courante.
+    int m_batchSize;
+
+    /// @brief Indice du prochain lot à traiter.
+    SDL_atomic_t m_nextBatch;
+};
+
+/// @brief Attache le thread courant à un coeur.
+static void ThreadPool_PinCurrentThread(int core)
+{
+    int cpuCount = SDL_GetCPUCount();
+    if (cpuCount <= 0)
+        return;
+    core %= cpuCount;
+
+#if defined(_WIN32)
+    if (core < (int)(8 * sizeof(DWORD_PTR)))
+        SetThreadAffinityMask(GetCurrentThread(), (DWORD_PTR)1 << core);
+#elif defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(core, &cpuSet);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet);
+#endif
+}
+
+/// @brief Traite des lots de la tâche courante jusqu'à ce qu'il n'en reste plus.
+static void ThreadPool_RunBatches(ThreadPool *pool)
+{
+    int count = pool->m_count;
+    int batchSize = pool->m_batchSize;
+
+    PROFILE_ZONE_BEGIN("ThreadPool_RunBatches");
+    while (true)
+    {
+        int first = SDL_AtomicAdd(&pool->m_nextBatch, 1) * batchSize;
+        if (first >= count)
+            break;
+
+        int last = first + batchSize;
+        if (last > count)
+            last = count;
+
+        pool->m_task(pool->m_data, first, last);
+    }
+    PROFILE_ZONE_END();
+}
+
+static int ThreadPool_WorkerMain(void *data)
+{
+    ThreadPoolWorker *worker = (ThreadPoolWorker *)data;
+    ThreadPool *pool = worker->m_pool;
+
+    PROFILE_THREAD_NAME("ThreadPool worker");
+
+    if (pool->m_pinThreads)
+        ThreadPool_PinCurrentThread(worker->m_index);
+
+    // Les threads sont créés avant la première tâche : une tâche lancée avant que ce thread
+    // n'ait démarré doit tout de même être exécutée
+    int generation = 0;
+
+    SDL_LockMutex(pool->m_mutex);
+    while (true)
+    {
+        // Attend une nouvelle tâche
+        while (!pool->m_quit && pool->m_generation == generation)
+            SDL_CondWait(pool->m_startCond, pool->m_mutex);
+
+        if (pool->m_quit)
+            break;
+
+        generation = pool->m_generation;
+        SDL_UnlockMutex(pool->m_mutex);
+
+        ThreadPool_RunBatches(pool);
+
+        SDL_LockMutex(pool->m_mutex);
+        pool->m_pending--;
+        if (pool->m_pending == 0)
+            SDL_CondSignal(pool->m_doneCond);
+    }
+    SDL_UnlockMutex(pool->m_mutex);
+
+    return 0;
+}
+
+ThreadPool *ThreadPool_New(int threadCount, bool pinThreads)
+{
+    ThreadPool *pool = NULL;
+
+    if (threadCount <= 0)
+        threadCount = SDL_GetCPUCount();
+    if (threadCount <= 0)
+        threadCount = 1;
+
+    pool = (ThreadPool *)calloc(1, sizeof(ThreadPool));
+    if (!pool) goto ERROR_LABEL;
+
+    pool->m_pinThreads = pinThreads;
+    pool->m_threadCount = 1;
+
+    pool->m_mutex = SDL_CreateMutex();
+    if (!pool->m_mutex) goto ERROR_LABEL;
+
+    pool->m_startCond = SDL_CreateCond();
+    if (!pool->m_startCond) goto ERROR_LABEL;
+
+    pool->m_doneCond = SDL_CreateCond();
+    if (!pool->m_doneCond) goto ERROR_LABEL;
+
+    pool->m_threads = (SDL_Thread **)calloc(threadCount, sizeof(SDL_Thread *));
+    if (!pool->m_threads) goto ERROR_LABEL;
+
+    pool->m_workers = (ThreadPoolWorker *)calloc(threadCount, sizeof(ThreadPoolWorker));
+    if (!pool->m_workers) goto ERROR_LABEL;
+
+    // Le thread qui lance les tâches est le thread d'indice 0
+    for (int i = 1; i < threadCount; ++i)
+    {
+        pool->m_workers[i].m_pool = pool;
+        pool->m_workers[i].m_index = i;
+
+        pool->m_threads[i] = SDL_CreateThread(
+            ThreadPool_WorkerMain, "ThreadPool", &pool->m_workers[i]);
+        if (!pool->m_threads[i]) goto ERROR_LABEL;
+
+        pool->m_threadCount++;
+    }
+
+    return pool;
+
+ERROR_LABEL:
+    printf("ERROR - ThreadPool_New()\n");
+    assert(false);
+    ThreadPool_Free(pool);
+    return NULL;
+}
+
+void ThreadPool_Free(ThreadPool *pool)
+{
+    if (!pool) return;
+
+    if (pool->m_mutex)
+    {
+        SDL_LockMutex(pool->m_mutex);
+        pool->m_quit = true;
+        if (pool->m_startCond)
+            SDL_CondBroadcast(pool->m_startCond);
+        SDL_UnlockMutex(pool->m_mutex);
+    }
+
+    if (pool->m_threads)
+    {
+        for (int i = 1; i < pool->m_threadCount; ++i)
+        {
+            SDL_WaitThread(pool->m_threads[i], NULL);
+        }
+        free(pool->m_threads);
+    }
+
+    free(pool->m_workers);
+
+    if (pool->m_doneCond) SDL_DestroyCond(pool->m_doneCond);
+    if (pool->m_startCond) SDL_DestroyCond(pool->m_startCond);
+    if (pool->m_mutex) SDL_DestroyMutex(pool->m_mutex);
+
+    memset(pool, 0, sizeof(ThreadPool));
+    free(pool);
+}
+
+void ThreadPool_PinCallingThread(ThreadPool *pool)
+{
+    if (pool && pool->m_pinThreads)
+        ThreadPool_PinCurrentThread(0);
+}
+
+int ThreadPool_GetThreadCount(ThreadPool *pool)
+{
+    return pool ? pool->m_threadCount : 1;
+}
+
+void ThreadPool_ParallelFor(
+    ThreadPool *pool, int count, int minBatch, ThreadPoolTask task, void *data)
+{
+    if (count <= 0)
+        return;
+
+    if (minBatch < 1)
+        minBatch = 1;
+
+    // Pas assez de travail pour réveiller les threads
+    if (!pool || pool->m_threadCount <= 1 || count <= minBatch)
+    {
+        task(data, 0, count);
+        return;
+    }
+
+    // Quelques lots par thread pour équilibrer la charge
+    int batchSize = count / (4 * pool->m_threadCount);
+    if (batchSize < minBatch)
+        batchSize = minBatch;
+
+    SDL_LockMutex(pool->m_mutex);
+    pool->m_task = task;
+    pool->m_data = data;
+    pool->m_count = count;
+    pool->m_batchSize = batchSize;
+    SDL_AtomicSet(&pool->m_nextBatch, 0);
+    pool->m_pending = pool->m_threadCount - 1;
+    pool->m_generation++;
+    SDL_CondBroadcast(pool->m_startCond);
+    SDL_UnlockMutex(pool->m_mutex);
+
+    ThreadPool_RunBatches(pool);
+
+    // Attend que tous les threads aient terminé
+    SDL_LockMutex(pool->m_mutex);
+    while (pool->m_pending > 0)
+        SDL_CondWait(pool->m_doneCond, pool->m_mutex);
+    SDL_UnlockMutex(pool->m_mutex);
+}
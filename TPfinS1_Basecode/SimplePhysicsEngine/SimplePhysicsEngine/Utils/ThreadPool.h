@@ -0,0 +1,67 @@
+﻿#ifndef _THREAD_POOL_H_
+#define _THREAD_POOL_H_
+
+/// @file threadpool.h
+/// @defgroup ThreadPool
+/// @{
+
+#include "../Settings.h"
+
+/// @brief Nombre de threads par défaut (0 pour utiliser tous les coeurs disponibles).
+#define THREAD_COUNT 0
+
+/// @brief Indique si les threads sont attachés par défaut à un coeur.
+#define THREAD_PINNING false
+
+/// @brief Tâche exécutée par les threads sur un intervalle d'indices [first, last[.
+/// @param[in,out] data les données de la tâche.
+/// @param[in] first le premier indice à traiter.
+/// @param[in] last l'indice suivant le dernier indice à traiter.
+typedef void (*ThreadPoolTask)(void *data, int first, int last);
+
+typedef struct ThreadPool_s ThreadPool;
+
+/// @brief Groupe de threads persistant pour le jeu.
+/// Vaut NULL si les calculs sont effectués sur le seul thread principal.
+extern ThreadPool *g_threadPool;
+
+/// @brief Crée un groupe de threads persistant.
+/// Le thread qui appelle ThreadPool_ParallelFor() participe aux calculs : threadCount - 1
+/// threads sont donc créés. Ce thread n'est pas forcément celui qui crée le groupe ; il est
+/// attaché à son coeur par ThreadPool_PinCallingThread().
+/// @param[in] threadCount le nombre de threads (0 pour utiliser tous les coeurs disponibles).
+/// @param[in] pinThreads indique si chaque thread doit être attaché à un coeur différent.
+/// @return Le groupe créé ou NULL en cas d'erreur.
+ThreadPool *ThreadPool_New(int threadCount, bool pinThreads);
+
+/// @brief Détruit un groupe de threads préalablement alloué avec ThreadPool_New().
+/// Attend la fin de tous les threads.
+/// @param[in,out] pool le groupe à détruire.
+void ThreadPool_Free(ThreadPool *pool);
+
+/// @brief Attache le thread courant au coeur du thread d'indice 0 du groupe (le premier coeur),
+/// si le groupe attache ses threads. Doit être appelée par le thread qui exécute
+/// ThreadPool_ParallelFor(), avant sa première tâche.
+/// @param[in] pool le groupe (peut valoir NULL).
+void ThreadPool_PinCallingThread(ThreadPool *pool);
+
+/// @brief Renvoie le nombre de threads du groupe, thread appelant compris.
+/// @param[in] pool le groupe (peut valoir NULL).
+/// @return Le nombre de threads.
+int ThreadPool_GetThreadCount(ThreadPool *pool);
+
+/// @brief Exécute une tâche sur les indices [0, count[ en les répartissant entre les threads.
+/// Les indices sont découpés en lots d'au moins minBatch éléments, distribués dynamiquement.
+/// La fonction ne rend la main que lorsque tous les lots ont été traités.
+/// Si pool vaut NULL ou si count est trop petit, la tâche est exécutée sur le thread appelant.
+/// @param[in,out] pool le groupe (peut valoir NULL).
+/// @param[in] count le nombre d'indices.
+/// @param[in] minBatch la taille minimale d'un lot.
+/// @param[in] task la tâche.
+/// @param[in,out] data les données de la tâche.
+void ThreadPool_ParallelFor(
+    ThreadPool *pool, int count, int minBatch, ThreadPoolTask task, void *data);
+
+/// @}
+
+#endif
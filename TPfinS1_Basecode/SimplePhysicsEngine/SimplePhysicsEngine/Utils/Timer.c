@@ -1,59 +1,110 @@
-﻿#include "Timer.h"
-
-Timer *g_time = NULL;
-
-Timer* Timer_New()
-{
-    Timer* timer = NULL;
-
-    timer = (Timer*)calloc(1, sizeof(Timer));
-    if (!timer)
-    {
-        printf("ERROR - Timer_New()\n");
-        assert(false);
-        return NULL;
-    }
-
-    timer->m_startTime = -1.f;
-    timer->m_currentTime = 0.f;
-    timer->m_previousTime = timer->m_currentTime;
-    timer->m_delta = 0.f;
-
-    return timer;
-}
-
-void Timer_Free(Timer* timer)
-{
-    if (!timer) return;
-
-    memset(timer, 0, sizeof(Timer));
-    free(timer);
-}
-
-void Timer_Start(Timer* timer)
-{
-    if (!timer)
-        return;
-
-    timer->m_startTime = SDL_GetTicks() / 1000.f;
-    timer->m_currentTime = 0.f;
-    timer->m_previousTime = 0.f;
-    timer->m_delta = 0.f;
-}
-
-void Timer_Update(Timer* timer)
-{
-    timer->m_previousTime = timer->m_currentTime;
-    timer->m_currentTime = SDL_GetTicks() / 1000.f - timer->m_startTime;
-    timer->m_delta = timer->m_currentTime - timer->m_previousTime;
-}
-
-float Timer_GetDelta(Timer *timer)
-{
-    return timer->m_delta;
-}
-
-float Timer_GetElapsed(Timer *timer)
-{
-    return timer->m_currentTime - timer->m_startTime;
-}
\ No newline at end of file
+﻿#include "Timer.h"
+
+Timer *g_time = NULL;
+
+Timer* Timer_New()
+{
+    Timer* timer = NULL;
+
+    timer = (Timer*)calloc(1, sizeof(Timer));
+    if (!timer)
+    {
+        printf("ERROR - Timer_New()\n");
+        assert(false);
+        return NULL;
+    }
+
+    timer->m_lastCounter = SDL_GetPerformanceCounter();
+    timer->m_currentTime = 0;
+    timer->m_previousTime = timer->m_currentTime;
+    timer->m_delta = 0;
+    timer->m_remainder = 0.0;
+    timer->m_scale = 1.0;
+    timer->m_paused = false;
+
+    return timer;
+}
+
+void Timer_Free(Timer* timer)
+{
+    if (!timer) return;
+
+    memset(timer, 0, sizeof(Timer));
+    free(timer);
+}
+
+Uint64 Timer_TicksToNs(Uint64 ticks)
+{
+    const Uint64 nsPerSecond = 1000000000;
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+
+    // Sépare les secondes entières du reste pour ne pas dépasser 64 bits
+    return (ticks / frequency) * nsPerSecond + (ticks % frequency) * nsPerSecond / frequency;
+}
+
+void Timer_Start(Timer* timer)
+{
+    if (!timer)
+        return;
+
+    timer->m_lastCounter = SDL_GetPerformanceCounter();
+    timer->m_currentTime = 0;
+    timer->m_previousTime = 0;
+    timer->m_delta = 0;
+    timer->m_remainder = 0.0;
+}
+
+void Timer_Update(Timer* timer)
+{
+    Uint64 counter = SDL_GetPerformanceCounter();
+    Uint64 delta = Timer_TicksToNs(counter - timer->m_lastCounter);
+    timer->m_lastCounter = counter;
+
+    if (timer->m_paused)
+    {
+        delta = 0;
+    }
+    else if (timer->m_scale != 1.0)
+    {
+        // Conserve la partie fractionnaire pour que le temps mis à l'échelle ne dérive pas
+        double scaled = (double)delta * timer->m_scale + timer->m_remainder;
+        delta = (Uint64)scaled;
+        timer->m_remainder = scaled - (double)delta;
+    }
+
+    timer->m_previousTime = timer->m_currentTime;
+    timer->m_currentTime += delta;
+    timer->m_delta = delta;
+}
+
+void Timer_SetPaused(Timer *timer, bool paused)
+{
+    timer->m_paused = paused;
+}
+
+bool Timer_IsPaused(Timer *timer)
+{
+    return timer->m_paused;
+}
+
+void Timer_SetScale(Timer *timer, double scale)
+{
+    timer->m_scale = (scale > 0.0) ? scale : 0.0;
+    timer->m_remainder = 0.0;
+}
+
+float Timer_GetDelta(Timer *timer)
+{
+    return (float)((double)timer->m_delta * 1e-9);
+}
+
+Uint64 Timer_GetDeltaNs(Timer *timer)
+{
+    return timer->m_delta;
+}
+
+double Timer_GetElapsed(Timer *timer)
+{
+    return (double)timer->m_currentTime * 1e-9;
+}
+
@@ -1,57 +1,98 @@
-﻿#ifndef _TIMER_H_
-#define _TIMER_H_
-
-/// @file timer.h
-/// @defgroup Timer
-/// @{
-
-#include "../Settings.h"
-
-/// @brief Structure représentant un chronomètre.
-typedef struct Timer_s
-{
-    /// @brief Temps de départ.
-    float m_startTime;
-
-    /// @brief Temps du dernier appel à Timer_Update().
-    float m_currentTime;
-
-    /// @brief Temps de l'avant dernier appel à Timer_Update().
-    float m_previousTime;
-
-    /// @brief Ecart entre les deux derniers appels à Timer_Update().
-    float m_delta;
-} Timer;
-
-/// @brief Temps global pour le jeu.
-extern Timer *g_time;
-
-/// @brief Crée un nouveau timer.
-/// @return Le timer créé.
-Timer* Timer_New();
-
-/// @brief Détruit un timer préalablement alloué avec Timer_New().
-/// @param[in,out] timer le timer à détruire.
-void Timer_Free(Timer* timer);
-
-/// @brief Lance le timer.
-/// @param[in,out] timer le timer.
-void Timer_Start(Timer* timer);
-
-/// @brief Met à jour le timer en fonction du temps actuel.
-/// @param[in,out] timer le timer.
-void Timer_Update(Timer* timer);
-
-/// @brief Renvoie l'écart de temps (en secondes) entre les deux derniers appels à la fonction
-/// Timer_Update().
-/// @param[in] timer le timer.
-/// @return L'écart de temps entre les deux dernières mises à jour.
-float Timer_GetDelta(Timer *timer);
-
-/// @brief Renvoie l'écart de temps (en secondes) entre le lancement du timer avec la fonction
-/// Timer_Start() et le dernier appel à la fonction Timer_Update().
-/// @param[in] timer le timer.
-/// @return Le nombre de secondes écoulées depuis le lancement du timer et la dernière mise à jour.
-float Timer_GetElapsed(Timer *timer);
-
-#endif
\ No newline at end of file
+﻿#ifndef _TIMER_H_
+#define _TIMER_H_
+
+/// @file timer.h
+/// @defgroup Timer
+/// @{
+
+#include "../Settings.h"
+
+/// @brief Structure représentant un chronomètre.
+/// Le temps est lu sur le compteur haute résolution de SDL (SDL_GetPerformanceCounter())
+/// et stocké en nanosecondes sur 64 bits : la précision ne se dégrade pas avec le temps écoulé.
+/// Chaque chronomètre peut être mis en pause ou accéléré (ralenti) indépendamment des autres.
+typedef struct Timer_s
+{
+    /// @brief Valeur du compteur haute résolution lors du dernier appel à Timer_Update().
+    Uint64 m_lastCounter;
+
+    /// @brief Temps écoulé depuis le lancement (exprimé en ns), pauses et facteur d'échelle
+    /// compris, lors du dernier appel à Timer_Update().
+    Uint64 m_currentTime;
+
+    /// @brief Temps écoulé depuis le lancement lors de l'avant dernier appel à Timer_Update().
+    Uint64 m_previousTime;
+
+    /// @brief Ecart entre les deux derniers appels à Timer_Update() (exprimé en ns).
+    Uint64 m_delta;
+
+    /// @brief Partie fractionnaire (exprimée en ns) perdue lors de la mise à l'échelle.
+    double m_remainder;
+
+    /// @brief Facteur d'échelle du temps (1 : temps réel).
+    double m_scale;
+
+    /// @brief Indique si le chronomètre est en pause.
+    bool m_paused;
+} Timer;
+
+/// @brief Temps global pour le jeu.
+extern Timer *g_time;
+
+/// @brief Crée un nouveau timer.
+/// @return Le timer créé.
+Timer* Timer_New();
+
+/// @brief Détruit un timer préalablement alloué avec Timer_New().
+/// @param[in,out] timer le timer à détruire.
+void Timer_Free(Timer* timer);
+
+/// @brief Lance le timer.
+/// @param[in,out] timer le timer.
+void Timer_Start(Timer* timer);
+
+/// @brief Met à jour le timer en fonction du temps actuel.
+/// @param[in,out] timer le timer.
+void Timer_Update(Timer* timer);
+
+/// @brief Met le timer en pause ou le relance.
+/// Le temps écoulé pendant une pause n'est pas compté.
+/// @param[in,out] timer le timer.
+/// @param[in] paused true pour mettre le timer en pause.
+void Timer_SetPaused(Timer *timer, bool paused);
+
+/// @brief Indique si le timer est en pause.
+/// @param[in] timer le timer.
+/// @return true si le timer est en pause.
+bool Timer_IsPaused(Timer *timer);
+
+/// @brief Définit le facteur d'échelle du temps (0.5 pour un ralenti, 2 pour un accéléré).
+/// @param[in,out] timer le timer.
+/// @param[in] scale le facteur d'échelle (positif).
+void Timer_SetScale(Timer *timer, double scale);
+
+/// @brief Renvoie l'écart de temps (en secondes) entre les deux derniers appels à la fonction
+/// Timer_Update().
+/// @param[in] timer le timer.
+/// @return L'écart de temps entre les deux dernières mises à jour.
+float Timer_GetDelta(Timer *timer);
+
+/// @brief Renvoie l'écart de temps (en nanosecondes) entre les deux derniers appels à la
+/// fonction Timer_Update().
+/// @param[in] timer le timer.
+/// @return L'écart de temps entre les deux dernières mises à jour.
+Uint64 Timer_GetDeltaNs(Timer *timer);
+
+/// @brief Renvoie l'écart de temps (en secondes) entre le lancement du timer avec la fonction
+/// Timer_Start() et le dernier appel à la fonction Timer_Update().
+/// @param[in] timer le timer.
+/// @return Le nombre de secondes écoulées depuis le lancement du timer et la dernière mise à jour.
+double Timer_GetElapsed(Timer *timer);
+
+/// @brief Convertit un écart entre deux valeurs du compteur haute résolution de SDL
+/// en nanosecondes, sans dépassement de capacité.
+/// @param[in] ticks l'écart entre deux valeurs de SDL_GetPerformanceCounter().
+/// @return L'écart exprimé en nanosecondes.
+Uint64 Timer_TicksToNs(Uint64 ticks);
+
+#endif
@@ -1,12 +1,20 @@
-#ifndef _TOOLS_H_
-#define _TOOLS_H_
-
-#include "../Settings.h"
-
-float Float_Clamp(float value, float a, float b);
-
-float Float_SmoothDamp(
-    float current, float target, float *currentVelocity,
-    float smoothTime, float maxSpeed, float deltaTime);
-
-#endif
+#ifndef _TOOLS_H_
+#define _TOOLS_H_
+
+#include "../Settings.h"
+
+/// @brief Ralloue un tableau de count lments de taille size.
+/// Le tableau d'origine n'est pas modifi en cas d'erreur.
+/// @param[in,out] ptr l'adresse du pointeur vers le tableau.
+/// @param[in] count le nouveau nombre d'lments.
+/// @param[in] size la taille d'un lment.
+/// @return EXIT_SUCCESS ou EXIT_FAILURE.
+int Tools_Realloc(void **ptr, int count, size_t size);
+
+float Float_Clamp(float value, float a, float b);
+
+float Float_SmoothDamp(
+    float current, float target, float *currentVelocity,
+    float smoothTime, float maxSpeed, float deltaTime);
+
+#endif
@@ -1,86 +1,508 @@
-﻿#include "Settings.h"
-
-#include "Utils/Timer.h"
-#include "Utils/Renderer.h"
-#include "Utils/Window.h"
-#include "Game/Ball.h"
-#include "Game/Camera.h"
-#include "Game/Scene.h"
-
-int main(int argc, char *argv[])
-{
-    Window *window = NULL;
-    Renderer *renderer = NULL;
-    Scene *scene = NULL;
-
-    int exitStatus = Settings_InitSDL();
-    if (exitStatus == EXIT_FAILURE) goto ERROR_LABEL;
-    
-    window = Window_New(WINDOW_WIDTH, WINDOW_HEIGHT);
-    if (!window) goto ERROR_LABEL;
-
-    renderer = Window_GetRenderer(window);
-
-    g_time = Timer_New();
-    if (!g_time) goto ERROR_LABEL;
-
-    // Lance le temps global du jeu
-    Timer_Start(g_time);
-
-    bool quitGame = false;
-    while (!quitGame)
-    {
-        // Crée la scène
-        scene = Scene_New(renderer, 10, 3.2f);
-        if (!scene) goto ERROR_LABEL;
-
-        // Boucle de rendu
-        while (true)
-        {
-            if (scene->m_input->quitPressed || scene->m_input->restartPressed)
-            {
-                quitGame = scene->m_input->quitPressed;
-                break;
-            }
-
-            // Met à jour le temps global
-            Timer_Update(g_time);
-
-            // Met à jour la scène
-            Scene_Update(scene);
-
-            // Efface le rendu précédent
-            Renderer_Clear(renderer);
-
-            // Calcule le rendu de la scène
-            Scene_Render(scene);
-
-            // Affiche le buffer
-            Renderer_Update(renderer);
-        }
-
-        // Détruit la scène
-        Scene_Free(scene);
-        scene = NULL;
-    }
-
-    Scene_Free(scene);
-    scene = NULL;
-    Timer_Free(g_time);
-    g_time = NULL;
-    Window_Free(window);
-    window = NULL;
-
-    Settings_QuitSDL();
-
-    return EXIT_SUCCESS;
-
-ERROR_LABEL:
-    printf("ERROR - main()\n");
-    assert(false);
-    Window_Free(window);
-    Scene_Free(scene);
-    Timer_Free(g_time);
-    Settings_QuitSDL();
-    return EXIT_FAILURE;
+﻿#include "Settings.h"
+
+#include "Utils/Timer.h"
+#include "Utils/ThreadPool.h"
+#include "Utils/Profiler.h"
+#include "Utils/Renderer.h"
+#include "Utils/Window.h"
+#include "Game/Ball.h"
+#include "Game/Camera.h"
+#include "Game/Scene.h"
+#include "Game/Pipeline.h"
+#include "Game/Simulation.h"
+
+/// @brief Nombre de pas de temps simulés sans fenêtre par défaut.
+#define HEADLESS_STEPS 1000
+
+/// @brief Options de la ligne de commande.
+typedef struct Options_s
+{
+    /// @brief Nombre de threads du moteur physique (0 pour le nombre de coeurs).
+    int threadCount;
+
+    /// @brief Indique si les threads sont attachés à un coeur.
+    bool pinThreads;
+
+    /// @brief Méthode d'intégration et ses paramètres.
+    SolverMode solverMode;
+    int maxIterations;
+    float tolerance;
+    XpbdMethod xpbdMethod;
+    int substeps;
+    int xpbdIterations;
+
+    /// @brief Pas de temps fixe (0 pour celui de la méthode d'intégration).
+    float timeStep;
+
+    /// @brief Facteur d'échelle du temps de la simulation (1 : temps réel).
+    double timeScale;
+
+    /// @brief Nombre maximal de pas de temps fixes par image.
+    int maxSubsteps;
+
+    /// @brief Durée réelle maximale (exprimée en s) consacrée à la physique par image.
+    double stepBudget;
+
+    /// @brief Comportement lorsque le moteur physique ne suit plus le temps réel.
+    StepPolicy stepPolicy;
+
+    /// @brief Seuils du niveau de détail (exprimés en pixels par m) et côté (exprimé en pixels)
+    /// d'une tuile de la carte de densité.
+    float lodLinesScale;
+    float lodHeatmapScale;
+    int heatmapTile;
+
+    /// @brief Exécute la physique et la logique du jeu sur le thread principal, dans le
+    /// pipeline, plutôt que sur un thread de simulation.
+    bool serial;
+
+    /// @brief Fichier décrivant la scène initiale (NULL pour la scène par défaut).
+    const char *scenePath;
+
+    /// @brief Simule la scène sans fenêtre.
+    bool headless;
+
+    /// @brief Nombre de pas de temps simulés sans fenêtre.
+    int steps;
+
+    /// @brief Affiche l'état final des balles après une simulation sans fenêtre.
+    bool dumpState;
+
+    /// @brief Fichier dans lequel enregistrer la scène finale (ou NULL).
+    const char *savePath;
+
+    /// @brief Fichier dans lequel écrire la trace du profileur.
+    const char *tracePath;
+
+    /// @brief Ecrit la trace du profileur à la fin d'une simulation sans fenêtre.
+    bool writeTrace;
+} Options;
+
+/// @brief Affiche les options de la ligne de commande.
+static void Options_PrintUsage(const char *program)
+{
+    printf(
+        "Usage : %s [options]\n"
+        "  --threads N           threads du moteur (0 : un par coeur, moins celui du rendu)\n"
+        "  --pin                 attache chaque thread à un coeur\n"
+        "  --implicit            intégrateur d'Euler implicite\n"
+        "  --cg-iterations N     itérations maximales du gradient conjugué\n"
+        "  --cg-tolerance X      tolérance du gradient conjugué\n"
+        "  --xpbd                solveur XPBD\n"
+        "  --jacobi              XPBD avec la méthode de Jacobi\n"
+        "  --substeps N          sous-pas XPBD\n"
+        "  --xpbd-iterations N   itérations XPBD par sous-pas\n"
+        "  --timestep X          pas de temps fixe (en s)\n"
+        "  --time-scale X        vitesse de la simulation (1 : temps réel, P : pause)\n"
+        "  --max-substeps N      pas de temps fixes maximum par image\n"
+        "  --step-budget MS      durée maximale de la physique par image (0 : illimitée)\n"
+        "  --slow-motion         ralentit la simulation au lieu d'abandonner le retard\n"
+        "  --lod-lines PX        échelle (pixels par m) des segments et des points\n"
+        "  --lod-heatmap PX      échelle (pixels par m) de la carte de densité\n"
+        "  --heatmap-tile PX     côté d'une tuile de la carte de densité\n"
+        "  --serial              physique sur le thread principal (pas de thread de simulation)\n"
+        "  --scene FICHIER       charge la scène initiale depuis un fichier\n"
+        "  --headless            simule sans fenêtre puis affiche des statistiques\n"
+        "  --steps N             nombre de pas de temps sans fenêtre\n"
+        "  --dump                affiche l'état final des balles (sans fenêtre)\n"
+        "  --save FICHIER        enregistre la scène finale (sans fenêtre)\n"
+        "  --trace FICHIER       trace du profileur (F12, ou à la fin sans fenêtre)\n",
+        program
+    );
+}
+
+/// @brief Lit les options de la ligne de commande.
+/// @return EXIT_SUCCESS, ou EXIT_FAILURE si une option est inconnue.
+static int Options_Parse(Options *options, int argc, char *argv[])
+{
+    options->threadCount = THREAD_COUNT;
+    options->pinThreads = THREAD_PINNING;
+    options->solverMode = SOLVER_EXPLICIT;
+    options->maxIterations = IMPLICIT_MAX_ITERATIONS;
+    options->tolerance = IMPLICIT_TOLERANCE;
+    options->xpbdMethod = XPBD_GAUSS_SEIDEL;
+    options->substeps = XPBD_SUBSTEPS;
+    options->xpbdIterations = XPBD_ITERATIONS;
+    options->timeStep = 0.f;
+    options->timeScale = 1.0;
+    options->maxSubsteps = SCENE_MAX_SUBSTEPS;
+    options->stepBudget = SCENE_STEP_BUDGET;
+    options->stepPolicy = STEP_POLICY_DROP;
+    options->lodLinesScale = LOD_LINES_SCALE;
+    options->lodHeatmapScale = LOD_HEATMAP_SCALE;
+    options->heatmapTile = LOD_HEATMAP_TILE;
+    options->serial = false;
+    options->scenePath = NULL;
+    options->headless = false;
+    options->steps = HEADLESS_STEPS;
+    options->dumpState = false;
+    options->savePath = NULL;
+    options->tracePath = PROFILER_TRACE_PATH;
+    options->writeTrace = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if ((strcmp(argv[i], "--threads") == 0) && (i + 1 < argc))
+        {
+            options->threadCount = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--pin") == 0)
+        {
+            options->pinThreads = true;
+        }
+        else if (strcmp(argv[i], "--implicit") == 0)
+        {
+            options->solverMode = SOLVER_IMPLICIT;
+        }
+        else if ((strcmp(argv[i], "--cg-iterations") == 0) && (i + 1 < argc))
+        {
+            options->maxIterations = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "--cg-tolerance") == 0) && (i + 1 < argc))
+        {
+            options->tolerance = (float)atof(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--xpbd") == 0)
+        {
+            options->solverMode = SOLVER_XPBD;
+        }
+        else if (strcmp(argv[i], "--jacobi") == 0)
+        {
+            options->xpbdMethod = XPBD_JACOBI;
+        }
+        else if ((strcmp(argv[i], "--substeps") == 0) && (i + 1 < argc))
+        {
+            options->substeps = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "--xpbd-iterations") == 0) && (i + 1 < argc))
+        {
+            options->xpbdIterations = atoi(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "--timestep") == 0) && (i + 1 < argc))
+        {
+            options->timeStep = (float)atof(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "--time-scale") == 0) && (i + 1 < argc))
+        {
+            options->timeScale = atof(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "--max-substeps") == 0) && (i + 1 < argc))
+        {
+            int maxSubsteps = atoi(argv[++i]);
+            options->maxSubsteps = SDL_max(maxSubsteps, 1);
+        }
+        else if ((strcmp(argv[i], "--step-budget") == 0) && (i + 1 < argc))
+        {
+            options->stepBudget = atof(argv[++i]) / 1000.0;
+        }
+        else if (strcmp(argv[i], "--slow-motion") == 0)
+        {
+            options->stepPolicy = STEP_POLICY_SLOW_MOTION;
+        }
+        else if ((strcmp(argv[i], "--lod-lines") == 0) && (i + 1 < argc))
+        {
+            options->lodLinesScale = (float)atof(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "--lod-heatmap") == 0) && (i + 1 < argc))
+        {
+            options->lodHeatmapScale = (float)atof(argv[++i]);
+        }
+        else if ((strcmp(argv[i], "--heatmap-tile") == 0) && (i + 1 < argc))
+        {
+            int heatmapTile = atoi(argv[++i]);
+            options->heatmapTile = SDL_max(heatmapTile, 1);
+        }
+        else if (strcmp(argv[i], "--serial") == 0)
+        {
+            options->serial = true;
+        }
+        else if ((strcmp(argv[i], "--scene") == 0) && (i + 1 < argc))
+        {
+            options->scenePath = argv[++i];
+        }
+        else if (strcmp(argv[i], "--headless") == 0)
+        {
+            options->headless = true;
+        }
+        else if ((strcmp(argv[i], "--steps") == 0) && (i + 1 < argc))
+        {
+            options->steps = atoi(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--dump") == 0)
+        {
+            options->dumpState = true;
+        }
+        else if ((strcmp(argv[i], "--save") == 0) && (i + 1 < argc))
+        {
+            options->savePath = argv[++i];
+        }
+        else if ((strcmp(argv[i], "--trace") == 0) && (i + 1 < argc))
+        {
+            options->tracePath = argv[++i];
+            options->writeTrace = true;
+        }
+        else
+        {
+            Options_PrintUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
+
+/// @brief Crée la scène décrite par les options.
+/// @param[in] renderer le moteur de rendu, ou NULL pour une simulation sans fenêtre.
+/// @return La scène créée. Renvoie NULL en cas d'erreur.
+static Scene *Options_CreateScene(Options *options, Renderer *renderer)
+{
+    Scene *scene = Scene_New(renderer, 10, 3.2f);
+    if (!scene) goto ERROR_LABEL;
+
+    if (options->scenePath)
+    {
+        int exitStatus = Scene_Load(scene, options->scenePath);
+        if (exitStatus == EXIT_FAILURE) goto ERROR_LABEL;
+    }
+
+    Scene_SetSolver(scene, options->solverMode);
+    scene->m_implicit->m_maxIterations = options->maxIterations;
+    scene->m_implicit->m_tolerance = options->tolerance;
+    scene->m_xpbd->m_method = options->xpbdMethod;
+    scene->m_xpbd->m_substeps = options->substeps;
+    scene->m_xpbd->m_iterations = options->xpbdIterations;
+    if (options->timeStep > 0.f)
+        scene->m_timeStep = options->timeStep;
+    Timer_SetScale(scene->m_time, options->timeScale);
+    scene->m_maxSubsteps = options->maxSubsteps;
+    scene->m_stepBudget = options->stepBudget;
+    scene->m_stepPolicy = options->stepPolicy;
+    if (scene->m_lod)
+    {
+        scene->m_lod->m_linesScale = options->lodLinesScale;
+        scene->m_lod->m_heatmapScale = options->lodHeatmapScale;
+        scene->m_lod->m_heatmapTile = options->heatmapTile;
+    }
+
+    return scene;
+
+ERROR_LABEL:
+    printf("ERROR - Options_CreateScene()\n");
+    Scene_Free(scene);
+    return NULL;
+}
+
+/// @brief Simule la scène sans fenêtre ni rendu, aussi vite que possible,
+/// puis affiche des statistiques (et éventuellement l'état final des balles).
+static int RunHeadless(Options *options)
+{
+    Scene *scene = Options_CreateScene(options, NULL);
+    if (!scene) goto ERROR_LABEL;
+
+    Uint64 start = SDL_GetPerformanceCounter();
+    for (int i = 0; i < options->steps; ++i)
+    {
+        PROFILE_FRAME();
+        PROFILE_ZONE_BEGIN("Scene_FixedUpdate");
+        Scene_FixedUpdate(scene, scene->m_timeStep);
+        PROFILE_ZONE_END();
+    }
+    Uint64 end = SDL_GetPerformanceCounter();
+
+    double seconds = (double)(end - start) / (double)SDL_GetPerformanceFrequency();
+    Islands *islands = scene->m_islands;
+
+    printf("steps       %d\n", options->steps);
+    printf("timestep    %g s\n", scene->m_timeStep);
+    printf("threads     %d\n", ThreadPool_GetThreadCount(g_threadPool));
+    printf("balls       %d\n", Scene_GetBallCount(scene));
+    printf("springs     %d\n", scene->m_springs->m_count);
+    printf("islands     %d (%d awake)\n", islands->m_islandCount, islands->m_awakeCount);
+    printf("wall time   %.3f s\n", seconds);
+    printf("step time   %.3f ms\n", options->steps > 0 ? 1000.0 * seconds / options->steps : 0.0);
+
+    if (options->dumpState)
+    {
+        // Une ligne par balle : identifiant, position et vitesse
+        Particles *balls = Scene_GetBalls(scene);
+        for (int i = 0; i < Scene_GetBallCount(scene); ++i)
+        {
+            printf(
+                "%u %.9g %.9g %.9g %.9g\n", (unsigned)Particles_GetId(balls, i),
+                balls->m_posX[i], balls->m_posY[i], balls->m_velX[i], balls->m_velY[i]
+            );
+        }
+    }
+
+    if (options->savePath)
+    {
+        int exitStatus = Scene_Save(scene, options->savePath);
+        if (exitStatus == EXIT_FAILURE) goto ERROR_LABEL;
+    }
+
+    if (options->writeTrace)
+    {
+        (void)PROFILE_WRITE_TRACE(options->tracePath, PROFILER_TRACE_FRAMES);
+    }
+
+    Scene_Free(scene);
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - RunHeadless()\n");
+    Scene_Free(scene);
+    return EXIT_FAILURE;
+}
+
+int main(int argc, char *argv[])
+{
+    Window *window = NULL;
+    Renderer *renderer = NULL;
+    Pipeline *pipeline = NULL;
+    Scene *scene = NULL;
+    Simulation *simulation = NULL;
+    Options options;
+
+    int exitStatus = Options_Parse(&options, argc, argv);
+    if (exitStatus == EXIT_FAILURE) return EXIT_FAILURE;
+
+    exitStatus = Settings_InitSDL(!options.headless);
+    if (exitStatus == EXIT_FAILURE) goto ERROR_LABEL;
+
+    PROFILE_THREAD_NAME("Main");
+
+    // Crée les threads utilisés par le moteur physique. Avec le thread de simulation, le thread
+    // principal ne fait plus que le rendu : il garde un coeur pour lui
+    bool simulationThread = !options.serial && !options.headless;
+    int threadCount = options.threadCount;
+    if ((threadCount <= 0) && simulationThread)
+        threadCount = SDL_max(SDL_GetCPUCount() - 1, 1);
+
+    g_threadPool = ThreadPool_New(threadCount, options.pinThreads);
+    if (!g_threadPool) goto ERROR_LABEL;
+
+    // Sans thread de simulation, le moteur physique tourne sur le thread principal
+    if (!simulationThread)
+        ThreadPool_PinCallingThread(g_threadPool);
+
+    if (options.headless)
+    {
+        exitStatus = RunHeadless(&options);
+
+        ThreadPool_Free(g_threadPool);
+        g_threadPool = NULL;
+        Settings_QuitSDL();
+
+        return exitStatus;
+    }
+
+    window = Window_New(WINDOW_WIDTH, WINDOW_HEIGHT);
+    if (!window) goto ERROR_LABEL;
+
+    renderer = Window_GetRenderer(window);
+
+    g_time = Timer_New();
+    if (!g_time) goto ERROR_LABEL;
+
+    // Etapes exécutées à chaque image
+    pipeline = Pipeline_New();
+    if (!pipeline) goto ERROR_LABEL;
+
+    // Lance le temps global du jeu
+    Timer_Start(g_time);
+
+    bool quitGame = false;
+    while (!quitGame)
+    {
+        // Crée la scène
+        scene = Options_CreateScene(&options, renderer);
+        if (!scene) goto ERROR_LABEL;
+
+        // Lance le thread de simulation (physique et logique du jeu)
+        if (!options.serial)
+        {
+            simulation = Simulation_New(scene);
+            if (!simulation) goto ERROR_LABEL;
+
+            exitStatus = Simulation_Start(simulation);
+            if (exitStatus == EXIT_FAILURE) goto ERROR_LABEL;
+
+            scene->m_simulation = simulation;
+        }
+
+        // Boucle de rendu
+        while (true)
+        {
+            // Met à jour le temps global
+            Timer_Update(g_time);
+
+            // Entrées, simulation, jeu, rendu et affichage (une seule fois chacun)
+            Pipeline_Run(pipeline, scene);
+
+            if (scene->m_input->quitPressed || scene->m_input->restartPressed)
+            {
+                quitGame = scene->m_input->quitPressed;
+                break;
+            }
+
+            // Ecrit la trace des dernières images (les threads du moteur doivent être inactifs)
+            if (scene->m_input->tracePressed)
+            {
+                if (simulation) Simulation_Stop(simulation);
+                (void)PROFILE_WRITE_TRACE(options.tracePath, PROFILER_TRACE_FRAMES);
+                if (simulation && (Simulation_Start(simulation) == EXIT_FAILURE))
+                    goto ERROR_LABEL;
+            }
+        }
+
+        // Arrête le thread de simulation : la scène n'est plus modifiée
+        Simulation_Free(simulation);
+        simulation = NULL;
+        scene->m_simulation = NULL;
+
+        if (scene->m_droppedTime > 0.0)
+            printf("WARNING - %.3f s of simulation dropped\n", scene->m_droppedTime);
+
+        // Statistiques du rendu de la dernière image
+        RenderStats *stats = &scene->m_renderStats;
+        printf(
+            "render      %d balls drawn (%d culled), %d springs drawn (%d culled), %d tiles\n",
+            stats->drawnBalls, stats->culledBalls,
+            stats->drawnSprings, stats->culledSprings, stats->drawnTiles
+        );
+
+        // Détruit la scène
+        Scene_Free(scene);
+        scene = NULL;
+    }
+
+    Pipeline_PrintTimings(pipeline);
+
+    Scene_Free(scene);
+    scene = NULL;
+    Pipeline_Free(pipeline);
+    pipeline = NULL;
+    Timer_Free(g_time);
+    g_time = NULL;
+    ThreadPool_Free(g_threadPool);
+    g_threadPool = NULL;
+    Window_Free(window);
+    window = NULL;
+
+    Settings_QuitSDL();
+
+    return EXIT_SUCCESS;
+
+ERROR_LABEL:
+    printf("ERROR - main()\n");
+    assert(false);
+    Simulation_Free(simulation);
+    Window_Free(window);
+    Scene_Free(scene);
+    Pipeline_Free(pipeline);
+    Timer_Free(g_time);
+    ThreadPool_Free(g_threadPool);
+    Settings_QuitSDL();
+    return EXIT_FAILURE;
 }
\ No newline at end of file